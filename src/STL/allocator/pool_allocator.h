@@ -0,0 +1,201 @@
+#pragma once
+
+#include "allocator.h"
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief Unit in which slabs are requested from the upstream allocator; fixes the alignment of every pooled block.
+        struct alignas(16) __pool_chunk { unsigned char m_bytes[16]; };
+
+        /**
+         * @brief Slab pool shared by every copy and rebind of a @c stl::pool_allocator. Single-object requests up to
+         *        @c __max_block bytes are served from per-size-class free lists, refilled by carving slabs obtained from
+         *        @c ChunkAlloc. Nothing is returned upstream until the last allocator referencing the pool goes away,
+         *        or @c release() is called while no block is in use. Not synchronized.
+         */
+        template <typename ChunkAlloc>
+        class __pool_resource
+        {
+        public:
+            constexpr static size_t __block_align = sizeof(__pool_chunk);
+            constexpr static size_t __max_block   = 256;
+            constexpr static size_t __class_count = __max_block / __block_align;
+            constexpr static size_t __min_slab    = 32;       // blocks in the first slab of a size class
+            constexpr static size_t __max_slab    = 4096;     // blocks per slab once a size class has grown
+
+            explicit __pool_resource(const ChunkAlloc& upstream);
+
+            ~__pool_resource() { this->m_release_slabs(); }
+
+            void* allocate(size_t bytes);
+
+            /// @brief @c count consecutive blocks of @c bytes carved from one slab, each given back alone by @c deallocate.
+            void* allocate_contiguous(size_t bytes, size_t count);
+
+            void deallocate(void* ptr, size_t bytes) noexcept;
+
+            /// @brief Returns every slab to the upstream allocator if no block is currently in use.
+            bool release() noexcept;
+
+            static constexpr bool pooled(size_t bytes, size_t align) noexcept
+            { return bytes <= __max_block && align <= __block_align; }
+
+            const ChunkAlloc& upstream() const noexcept { return this->m_upstream; }
+
+            size_t              m_refs;
+
+        private:
+            struct free_block { free_block* m_next; };
+
+            struct slab_header
+            {
+                slab_header* m_next;
+                size_t       m_chunks;
+            };
+
+            struct size_class
+            {
+                free_block*     m_free;
+                unsigned char*  m_bump;
+                unsigned char*  m_bump_end;
+                size_t          m_next_slab;
+            };
+
+            ChunkAlloc          m_upstream;
+            slab_header*        m_slabs;
+            size_t              m_live;
+            size_class          m_classes[__class_count];
+
+            void m_refill(size_class& cls, size_t block_size, size_t min_blocks = 0);
+
+            void m_release_slabs() noexcept;
+
+            void m_reset_classes() noexcept;
+
+            __pool_resource(const __pool_resource&) = delete;
+            __pool_resource& operator=(const __pool_resource&) = delete;
+        };
+    }
+
+    /**
+     * @brief Allocator carving single objects out of large slabs and recycling them through free lists, for node based
+     *        containers whose every element would otherwise be a separate @c ::operator new. Copies and rebinds share
+     *        one pool, so a container's node and bucket allocators draw from the same slabs, and array or over-aligned
+     *        requests go straight to @c Upstream, which also supplies the slabs.
+     *        The pool is not thread safe: share an allocator between threads only with external locking.
+     * @tparam T        Value type
+     * @tparam Upstream Allocator supplying the slabs; rebound to 16-byte chunks
+     */
+    template <typename T, typename Upstream = stl::allocator<T>>
+    class pool_allocator
+    {
+        typedef typename Upstream::template rebind<__detail::__pool_chunk>::other   chunk_allocator;
+        typedef __detail::__pool_resource<chunk_allocator>                           resource_type;
+        typedef typename chunk_allocator::template rebind<resource_type>::other      resource_allocator;
+
+        template <typename U, typename UpstreamU> friend class pool_allocator;
+
+    public:
+        typedef T               value_type;
+        typedef T*              pointer;
+        typedef const T*        const_pointer;
+        typedef T&              reference;
+        typedef const T&        const_reference;
+        typedef stl::size_t     size_type;
+        typedef stl::ptrdiff_t  difference_type;
+        typedef true_type       propagate_on_container_move_assignment;
+        typedef void*           void_pointer;
+        typedef const void*     const_void_pointer;
+        typedef false_type      is_always_equal;
+
+        template <typename U>
+        struct rebind { typedef pool_allocator<U, typename Upstream::template rebind<U>::other> other; };
+
+        pool_allocator(const Upstream& upstream = Upstream());
+
+        pool_allocator(const pool_allocator& other) noexcept
+            : m_resource(other.m_resource)
+        { ++this->m_resource->m_refs; }
+
+        template <typename U, typename UpstreamU>
+        pool_allocator(const pool_allocator<U, UpstreamU>& other) noexcept
+            : m_resource(other.m_resource)
+        { ++this->m_resource->m_refs; }
+
+        pool_allocator& operator=(const pool_allocator& other) noexcept;
+
+        ~pool_allocator() noexcept { this->m_drop(); }
+
+        pointer address(reference value) const { return &value; }
+
+        const_pointer address(const_reference value) const { return &value; }
+
+        size_type max_size() const noexcept { return Upstream(this->m_resource->upstream()).max_size(); }
+
+        pointer allocate(size_type size, const_void_pointer hint = nullptr);
+
+        /**
+         * @brief @c count objects laid out back to back in one slab, each released on its own with @c deallocate(ptr, 1),
+         *        so a container building many nodes at once gets them contiguous without owning the block.
+         * @return @c nullptr when @c T is not pooled; the caller then allocates one object at a time
+         */
+        pointer allocate_contiguous(size_type count);
+
+        void deallocate(pointer ptr, size_type size);
+
+        template <typename... Args>
+        void construct(pointer ptr, Args&&... args) { ::new(static_cast<void*>(ptr)) T(stl::forward<Args>(args)...); }
+
+        void destroy(pointer ptr) { ptr->~T(); }
+
+        /// @brief A copied container gets a pool of its own instead of sharing the source's slabs.
+        pool_allocator select_on_container_copy_construction() const
+        { return pool_allocator(Upstream(this->m_resource->upstream())); }
+
+        /// @brief Hands every slab back to @c Upstream when no block from this pool is in use; containers call it from @c clear().
+        bool release() noexcept { return this->m_resource->release(); }
+
+        template <typename U, typename UpstreamU>
+        bool operator==(const pool_allocator<U, UpstreamU>& other) const noexcept { return this->m_resource == other.m_resource; }
+
+        template <typename U, typename UpstreamU>
+        bool operator!=(const pool_allocator<U, UpstreamU>& other) const noexcept { return this->m_resource != other.m_resource; }
+
+    private:
+        resource_type* m_resource;
+
+        void m_drop() noexcept;
+    };
+
+    namespace __detail
+    {
+        template <typename Alloc>
+        auto __release_allocator_impl(Alloc& alloc, int) -> decltype(alloc.release(), void())
+        { alloc.release(); }
+
+        template <typename Alloc>
+        void __release_allocator_impl(Alloc&, ...) { }
+
+        /// @brief Lets a container hand its pooled memory back after @c clear(); a no-op for allocators without @c release().
+        template <typename Alloc>
+        void __release_allocator(Alloc& alloc) { __release_allocator_impl(alloc, 0); }
+
+        template <typename Alloc>
+        auto __allocate_contiguous_impl(Alloc& alloc, size_t count, int) -> decltype(alloc.allocate_contiguous(count))
+        { return alloc.allocate_contiguous(count); }
+
+        template <typename Alloc>
+        typename Alloc::pointer __allocate_contiguous_impl(Alloc&, size_t, ...) { return nullptr; }
+
+        /**
+         * @brief @c count single objects in one block, each to be deallocated alone, or @c nullptr for allocators that
+         *        cannot split a block that way (@c stl::allocator among them).
+         */
+        template <typename Alloc>
+        typename Alloc::pointer __allocate_contiguous(Alloc& alloc, size_t count) { return __allocate_contiguous_impl(alloc, count, 0); }
+    }
+}
+
+#include "pool_allocator.tcc"
@@ -0,0 +1,215 @@
+namespace stl
+{
+    namespace __detail
+    {
+        template <typename ChunkAlloc>
+        __pool_resource<ChunkAlloc>::__pool_resource(const ChunkAlloc& upstream)
+            : m_refs(1), m_upstream(upstream), m_slabs(nullptr), m_live(0)
+        { this->m_reset_classes(); }
+
+        template <typename ChunkAlloc>
+        void* __pool_resource<ChunkAlloc>::allocate(size_t bytes)
+        {
+            size_t index = bytes == 0 ? 0 : (bytes - 1) / __block_align;
+            size_class& cls = this->m_classes[index];
+
+            ++this->m_live;
+
+            if (cls.m_free != nullptr)
+            {
+                free_block* block = cls.m_free;
+                cls.m_free = block->m_next;
+                return block;
+            }
+
+            size_t block_size = (index + 1) * __block_align;
+
+            if (cls.m_bump == cls.m_bump_end)
+            {
+                try
+                {
+                    this->m_refill(cls, block_size);
+                }
+                catch (...)
+                {
+                    --this->m_live;
+                    throw;
+                }
+            }
+
+            void* block = cls.m_bump;
+            cls.m_bump += block_size;
+
+            return block;
+        }
+
+        template <typename ChunkAlloc>
+        void* __pool_resource<ChunkAlloc>::allocate_contiguous(size_t bytes, size_t count)
+        {
+            size_t index = bytes == 0 ? 0 : (bytes - 1) / __block_align;
+            size_t block_size = (index + 1) * __block_align;
+            size_class& cls = this->m_classes[index];
+
+            // a run never spans two slabs: one too short for it is refilled, its tail going to the free list
+            if (static_cast<size_t>(cls.m_bump_end - cls.m_bump) < count * block_size)
+                this->m_refill(cls, block_size, count);
+
+            void* run = cls.m_bump;
+            cls.m_bump += count * block_size;
+            this->m_live += count;
+
+            return run;
+        }
+
+        template <typename ChunkAlloc>
+        void __pool_resource<ChunkAlloc>::deallocate(void* ptr, size_t bytes) noexcept
+        {
+            size_class& cls = this->m_classes[bytes == 0 ? 0 : (bytes - 1) / __block_align];
+
+            free_block* block = static_cast<free_block*>(ptr);
+            block->m_next = cls.m_free;
+            cls.m_free = block;
+
+            --this->m_live;
+        }
+
+        template <typename ChunkAlloc>
+        bool __pool_resource<ChunkAlloc>::release() noexcept
+        {
+            if (this->m_live != 0)
+                return false;
+
+            this->m_release_slabs();
+            this->m_reset_classes();
+
+            return true;
+        }
+
+        /// @c private_members
+
+        template <typename ChunkAlloc>
+        void __pool_resource<ChunkAlloc>::m_refill(size_class& cls, size_t block_size, size_t min_blocks)
+        {
+            size_t block_chunks = block_size / __block_align;
+            size_t header_chunks = (sizeof(slab_header) + __block_align - 1) / __block_align;
+            size_t blocks = cls.m_next_slab < min_blocks ? min_blocks : cls.m_next_slab;
+            size_t chunks = header_chunks + blocks * block_chunks;
+
+            // the tail of the current slab would be lost behind the new one: its blocks join the free list
+            for (; cls.m_bump != cls.m_bump_end; cls.m_bump += block_size)
+            {
+                free_block* block = reinterpret_cast<free_block*>(cls.m_bump);
+                block->m_next = cls.m_free;
+                cls.m_free = block;
+            }
+
+            __pool_chunk* slab = this->m_upstream.allocate(chunks);
+
+            slab_header* header = reinterpret_cast<slab_header*>(slab);
+            header->m_next = this->m_slabs;
+            header->m_chunks = chunks;
+            this->m_slabs = header;
+
+            cls.m_bump = reinterpret_cast<unsigned char*>(slab + header_chunks);
+            cls.m_bump_end = reinterpret_cast<unsigned char*>(slab + chunks);
+
+            // slabs grow geometrically so small containers stay small and large ones make few upstream calls
+            if (cls.m_next_slab < __max_slab)
+                cls.m_next_slab *= 2;
+        }
+
+        template <typename ChunkAlloc>
+        void __pool_resource<ChunkAlloc>::m_release_slabs() noexcept
+        {
+            while (this->m_slabs != nullptr)
+            {
+                slab_header* next = this->m_slabs->m_next;
+                this->m_upstream.deallocate(reinterpret_cast<__pool_chunk*>(this->m_slabs), this->m_slabs->m_chunks);
+                this->m_slabs = next;
+            }
+        }
+
+        template <typename ChunkAlloc>
+        void __pool_resource<ChunkAlloc>::m_reset_classes() noexcept
+        {
+            for (size_t i = 0; i < __class_count; ++i)
+            {
+                this->m_classes[i].m_free = nullptr;
+                this->m_classes[i].m_bump = this->m_classes[i].m_bump_end = nullptr;
+                this->m_classes[i].m_next_slab = __min_slab;
+            }
+        }
+    }
+
+    template <typename T, typename Upstream>
+    pool_allocator<T, Upstream>::pool_allocator(const Upstream& upstream)
+    {
+        chunk_allocator chunks(upstream);
+        resource_allocator alloc(chunks);
+
+        this->m_resource = alloc.allocate(1);
+        ::new(static_cast<void*>(this->m_resource)) resource_type(chunks);
+    }
+
+    template <typename T, typename Upstream>
+    pool_allocator<T, Upstream>& pool_allocator<T, Upstream>::operator=(const pool_allocator& other) noexcept
+    {
+        if (this->m_resource != other.m_resource)
+        {
+            ++other.m_resource->m_refs;
+            this->m_drop();
+            this->m_resource = other.m_resource;
+        }
+
+        return *this;
+    }
+
+    template <typename T, typename Upstream>
+    typename pool_allocator<T, Upstream>::pointer pool_allocator<T, Upstream>::allocate(size_type size, const_void_pointer)
+    {
+        if (size == 0)
+            return nullptr;
+
+        if (size == 1 && resource_type::pooled(sizeof(T), alignof(T)))
+            return static_cast<pointer>(this->m_resource->allocate(sizeof(T)));
+
+        Upstream upstream(this->m_resource->upstream());
+        return upstream.allocate(size);
+    }
+
+    template <typename T, typename Upstream>
+    typename pool_allocator<T, Upstream>::pointer pool_allocator<T, Upstream>::allocate_contiguous(size_type count)
+    {
+        if (count == 0 || !resource_type::pooled(sizeof(T), alignof(T)))
+            return nullptr;
+
+        return static_cast<pointer>(this->m_resource->allocate_contiguous(sizeof(T), count));
+    }
+
+    template <typename T, typename Upstream>
+    void pool_allocator<T, Upstream>::deallocate(pointer ptr, size_type size)
+    {
+        if (ptr == nullptr)
+            return;
+
+        if (size == 1 && resource_type::pooled(sizeof(T), alignof(T)))
+            return this->m_resource->deallocate(ptr, sizeof(T));
+
+        Upstream upstream(this->m_resource->upstream());
+        upstream.deallocate(ptr, size);
+    }
+
+    /// @c private_members
+
+    template <typename T, typename Upstream>
+    void pool_allocator<T, Upstream>::m_drop() noexcept
+    {
+        if (--this->m_resource->m_refs != 0)
+            return;
+
+        resource_allocator alloc(this->m_resource->upstream());
+
+        this->m_resource->~resource_type();
+        alloc.deallocate(this->m_resource, 1);
+    }
+}
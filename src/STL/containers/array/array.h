@@ -37,9 +37,11 @@ namespace stl
         typedef stl::reverse_iterator<iterator>         reverse_iterator;
         typedef stl::reverse_iterator<iterator>   const_reverse_iterator;
 
-        array() noexcept { }
+        // value-initialized rather than left indeterminate, so an array can be built up in a constant expression
+        constexpr array() noexcept
+            : m_data() { }
 
-        array(const array& other);
+        constexpr array(const array& other);
 
         array(std::initializer_list<value_type> ilist);
         
@@ -59,7 +61,7 @@ namespace stl
 
         pointer data() noexcept { return this->m_data; } 
 
-        const_pointer data() const noexcept { return this->m_data; }  
+        constexpr const_pointer data() const noexcept { return this->m_data; }
 
         /**
          * @brief Returns a reference to an element within the container
@@ -91,9 +93,9 @@ namespace stl
         
         iterator end() noexcept   { return iterator(this->m_data + array_size); }
 
-        const_iterator cbegin() const noexcept { return const_iterator(this->m_data); }
+        constexpr const_iterator cbegin() const noexcept { return const_iterator(this->m_data); }
 
-        const_iterator cend() const noexcept   { return const_iterator(this->m_data + array_size); }
+        constexpr const_iterator cend() const noexcept   { return const_iterator(this->m_data + array_size); }
         
         reverse_iterator rbegin() noexcept { return reverse_iterator(this->m_data + array_size); }
 
@@ -103,7 +105,7 @@ namespace stl
 
         const_reverse_iterator crend() const noexcept   { return const_reverse_iterator(this->m_data); }
 
-        void fill(const value_type value);
+        constexpr void fill(const value_type value);
 
         void swap(array& arr) { stl::swap(arr.m_data, this->m_data); }
 
@@ -113,7 +115,7 @@ namespace stl
          * @return a reference to the requested element
          * @throws std::out_of_range if the index is out of bounds
          */
-        reference operator[](size_type pos);
+        constexpr reference operator[](size_type pos);
 
         /**
          * @brief Returns a constant reference to the element at specified location index;
@@ -3,7 +3,8 @@
 namespace stl
 {
     template <typename T, stl::size_t array_size>
-    array<T, array_size>::array(const array& other)
+    constexpr array<T, array_size>::array(const array& other)
+        : m_data()
     {
         if (other.size() > array_size) MEMORY_OVERFLOW_EXCEPTION
 
@@ -67,14 +68,14 @@ namespace stl
     }
 
     template <typename T, stl::size_t array_size>
-    void array<T, array_size>::fill(const value_type value)
+    constexpr void array<T, array_size>::fill(const value_type value)
     {
         for (size_type i = 0; i < array_size; ++i)
             this->m_data[i] = value;
     }
 
     template <typename T, stl::size_t array_size>
-    typename array<T, array_size>::reference array<T, array_size>::operator[](size_type pos)
+    constexpr typename array<T, array_size>::reference array<T, array_size>::operator[](size_type pos)
     {
         if (pos >= array_size) OUT_OF_BOUNDS_EXCEPTION
         return *(this->m_data + pos);
@@ -0,0 +1,129 @@
+#pragma once
+
+#include "../unordered_map/unordered_map.h"
+
+#include <new>
+#include <mutex>
+#include <shared_mutex>
+#include <optional>
+
+namespace stl
+{
+    /**
+     * @brief Thread safe hash map made of independent @c stl::unordered_map shards, each behind its own reader-writer lock.
+     *        A key's shard is chosen from the high bits of its mixed hash (the shard maps index their buckets with the low
+     *        ones), so threads working on different keys rarely contend and readers of one shard never block each other.
+     *        Elements are never handed out by reference: lookups return a copy or run a visitor under the shard lock.
+     * @param Key           Key type
+     * @param T             Value type
+     * @param Hash          Hash function type
+     * @param KeyEqual      Key comparison function type
+     * @param Allocator     Node allocator of every shard
+     * @param RehashPolicy  Bucket sizing policy of every shard
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash         = stl::hash<Key>,
+        typename KeyEqual     = stl::equal_to<Key>,
+        typename Allocator    = stl::allocator<stl::pair_node<Key, T>>,
+        typename RehashPolicy = stl::power2_rehash_policy
+    > class concurrent_unordered_map
+    {
+        constexpr static unsigned short   __DEFAULT_SHARD_COUNT = 16;
+        constexpr static unsigned short   __DEFAULT_BUCKET_SIZE = 16;     // per shard
+        constexpr static unsigned short   __CACHE_LINE          = 64;
+
+    public:
+        typedef stl::unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>  map_type;
+        typedef Key                                                                   key_type;
+        typedef T                                                                     mapped_type;
+        typedef stl::size_t                                                           size_type;
+        typedef Hash                                                                  hasher;
+        typedef KeyEqual                                                              key_equal;
+        typedef Allocator                                                             allocator_type;
+
+        /**
+         * @param shard_count   Number of independently locked shards, rounded up to a power of two
+         * @param bucket_count  Initial bucket count of every shard
+         * @param alloc         Copied into every shard through @c select_on_container_copy_construction, so an allocator
+         *                      with shared unsynchronised state, such as @c pool_allocator, gives each shard a pool of its
+         *                      own, only ever used under that shard's lock
+         */
+        explicit concurrent_unordered_map(size_type shard_count = __DEFAULT_SHARD_COUNT, size_type bucket_count = __DEFAULT_BUCKET_SIZE,
+                                          const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator());
+
+        ~concurrent_unordered_map();
+
+        /// @brief Inserts @c value under @c key unless the key is present. @return true if it was inserted
+        bool insert(const key_type& key, const mapped_type& value);
+
+        /// @brief Inserts @c value under @c key or overwrites the current value. @return true if it was inserted
+        template <typename M>
+        bool insert_or_assign(const key_type& key, M&& value);
+
+        /// @return a copy of the value stored under @c key, taken under the shard's shared lock
+        std::optional<mapped_type> find(const key_type& key) const;
+
+        bool contains(const key_type& key) const
+        {
+            const shard& s = this->m_shard_for(key);
+            std::shared_lock<std::shared_mutex> lock(s.m_mutex);
+
+            return s.m_map.contains(key);
+        }
+
+        /// @brief Calls @c f(mapped_type&) on the value under @c key while holding the shard exclusively. @return false if absent
+        template <typename F>
+        bool visit(const key_type& key, F&& f);
+
+        /// @brief Calls @c f(const mapped_type&) on the value under @c key while holding the shard shared. @return false if absent
+        template <typename F>
+        bool cvisit(const key_type& key, F&& f) const;
+
+        size_type erase(const key_type& key);
+
+        /// @brief Sum of the shard sizes; each shard is read under its own lock, so it is exact only without concurrent writers.
+        size_type size() const;
+
+        bool empty() const { return this->size() == 0; }
+
+        void clear();
+
+        /// @brief Rebuilds a single shard's bucket array; only that shard is locked meanwhile.
+        void rehash_shard(size_type index, size_type bucket_count);
+
+        /// @brief Rehashes the shards one after the other to @c bucket_count / shard_count() buckets each, never stopping the whole map.
+        void rehash(size_type bucket_count);
+
+        void reserve(size_type count);
+
+        size_type shard_count() const noexcept { return this->m_shard_mask + 1; }
+
+        size_type shard_of(const key_type& key) const
+        { return (__detail::__hash_mix(this->m_hash(key)) >> 32) & this->m_shard_mask; }
+
+    private:
+        // one cache line at least per shard, so that locking one shard never invalidates its neighbours' lock words
+        struct alignas(__CACHE_LINE) shard
+        {
+            mutable std::shared_mutex   m_mutex;
+            map_type                    m_map;
+
+            shard(size_type bucket_count, const hasher& hash, const key_equal& equal, const allocator_type& alloc)
+                : m_mutex(), m_map(bucket_count, hash, equal, alloc) { }
+        };
+
+        shard*      m_shards;
+        size_type   m_shard_mask;
+        hasher      m_hash;
+
+        shard& m_shard_for(const key_type& key) const
+        { return this->m_shards[this->shard_of(key)]; }
+
+        concurrent_unordered_map(const concurrent_unordered_map&) = delete;
+        concurrent_unordered_map& operator=(const concurrent_unordered_map&) = delete;
+    };
+}
+
+#include "concurrent_unordered_map.tcc"
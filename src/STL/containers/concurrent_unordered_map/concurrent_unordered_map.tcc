@@ -0,0 +1,176 @@
+namespace stl
+{
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::concurrent_unordered_map(size_type shard_count, size_type bucket_count, 
+        const hasher& hash, const key_equal& equal, const allocator_type& alloc)
+        : m_shards(nullptr), m_shard_mask(power2_rehash_policy::next_bucket_count(shard_count == 0 ? 1 : shard_count) - 1), m_hash(hash)
+    {
+        size_type count = this->m_shard_mask + 1;
+
+        this->m_shards = static_cast<shard*>(::operator new(count * sizeof(shard), std::align_val_t(alignof(shard))));
+
+        size_type i = 0;
+
+        try
+        {
+            for (; i < count; ++i)
+                ::new(static_cast<void*>(this->m_shards + i)) shard(bucket_count, hash, equal, allocator_traits<allocator_type>::select_on_container_copy_construction(alloc));
+        }
+        catch (...)
+        {
+            while (i--)
+                this->m_shards[i].~shard();
+
+            ::operator delete(this->m_shards, std::align_val_t(alignof(shard)));
+            throw;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::~concurrent_unordered_map()
+    {
+        for (size_type i = 0; i <= this->m_shard_mask; ++i)
+            this->m_shards[i].~shard();
+
+        ::operator delete(this->m_shards, std::align_val_t(alignof(shard)));
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    bool concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::insert(const key_type& key, const mapped_type& value)
+    {
+        shard& s = this->m_shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(s.m_mutex);
+
+        return s.m_map.try_emplace(key, value).second;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    template <typename M>
+    bool concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::insert_or_assign(const key_type& key, M&& value)
+    {
+        shard& s = this->m_shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(s.m_mutex);
+
+        typename map_type::iterator it = s.m_map.find(key);
+
+        if (it != s.m_map.end())
+        {
+            it->second = stl::forward<M>(value);
+            return false;
+        }
+
+        s.m_map.emplace(key, mapped_type(stl::forward<M>(value)));
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    std::optional<typename concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::mapped_type>
+    concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::find(const key_type& key) const
+    {
+        const shard& s = this->m_shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(s.m_mutex);
+
+        // const lookups never advance an incremental rehash, so they are safe under the shared lock
+        typename map_type::const_iterator it = s.m_map.find(key);
+
+        if (it == s.m_map.cend())
+            return std::nullopt;
+
+        return it->second;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    template <typename F>
+    bool concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::visit(const key_type& key, F&& f)
+    {
+        shard& s = this->m_shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(s.m_mutex);
+
+        typename map_type::iterator it = s.m_map.find(key);
+
+        if (it == s.m_map.end())
+            return false;
+
+        f(it->second);
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    template <typename F>
+    bool concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::cvisit(const key_type& key, F&& f) const
+    {
+        const shard& s = this->m_shard_for(key);
+        std::shared_lock<std::shared_mutex> lock(s.m_mutex);
+
+        typename map_type::const_iterator it = s.m_map.find(key);
+
+        if (it == s.m_map.cend())
+            return false;
+
+        f(static_cast<const mapped_type&>(it->second));
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    typename concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::size_type
+    concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::erase(const key_type& key)
+    {
+        shard& s = this->m_shard_for(key);
+        std::unique_lock<std::shared_mutex> lock(s.m_mutex);
+
+        return s.m_map.erase(key);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    typename concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::size_type
+    concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::size() const
+    {
+        size_type total = 0;
+
+        for (size_type i = 0; i <= this->m_shard_mask; ++i)
+        {
+            std::shared_lock<std::shared_mutex> lock(this->m_shards[i].m_mutex);
+            total += this->m_shards[i].m_map.size();
+        }
+
+        return total;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    void concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::clear()
+    {
+        for (size_type i = 0; i <= this->m_shard_mask; ++i)
+        {
+            std::unique_lock<std::shared_mutex> lock(this->m_shards[i].m_mutex);
+            this->m_shards[i].m_map.clear();
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    void concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::rehash_shard(size_type index, size_type bucket_count)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->m_shards[index].m_mutex);
+        this->m_shards[index].m_map.rehash(bucket_count);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    void concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::rehash(size_type bucket_count)
+    {
+        size_type per_shard = bucket_count / this->shard_count() + 1;
+
+        for (size_type i = 0; i <= this->m_shard_mask; ++i)
+            this->rehash_shard(i, per_shard);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy>
+    void concurrent_unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy>::reserve(size_type count)
+    {
+        size_type per_shard = count / this->shard_count() + 1;
+
+        for (size_type i = 0; i <= this->m_shard_mask; ++i)
+        {
+            std::unique_lock<std::shared_mutex> lock(this->m_shards[i].m_mutex);
+            this->m_shards[i].m_map.reserve(per_shard);
+        }
+    }
+}
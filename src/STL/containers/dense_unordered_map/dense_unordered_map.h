@@ -0,0 +1,245 @@
+#pragma once
+
+#include "../vector/vector.h"
+#include "../../iterator.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+
+#include <stdexcept>
+#include <initializer_list>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief Chain link of one entry of a @c dense_unordered_map, kept apart from the entry so a scan reads entries only.
+        struct __dense_link
+        {
+            size_t m_next;      // index of the next entry of the chain, or __NO_ENTRY
+            size_t m_hash;      // full hash of the entry's key: rehashing and relocating never call the hasher
+        };
+    }
+
+    /**
+     * @brief Hash map whose entries are stored contiguously in one @c stl::vector, for maps scanned in full as often as
+     *        they are searched. Buckets hold indices into that vector and chains are linked by index, so iterating is a
+     *        linear sweep over the entries, whatever the bucket count and however many entries were erased.
+     *        Erase moves the last entry into the hole (swap with last), which keeps the entries dense but changes their
+     *        order. Any insert or erase invalidates iterators and references.
+     * @param Key           Key type
+     * @param T             Value type
+     * @param Hash          Hash function type
+     * @param KeyEqual      Key comparison function type
+     * @param RehashPolicy  Bucket sizing policy, @c stl::power2_rehash_policy or @c stl::prime_rehash_policy
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash         = stl::hash<Key>,
+        typename KeyEqual     = stl::equal_to<Key>,
+        typename RehashPolicy = stl::power2_rehash_policy
+    > class dense_unordered_map
+    {
+        static_assert(RehashPolicy::migrate_buckets == 0, "stl::dense_unordered_map always rehashes in one step");
+
+        constexpr static stl::size_t    __DEFAULT_BUCKET_SIZE = 16;
+        constexpr static float          __DEFAULT_LOAD_FACTOR = .75;
+        constexpr static stl::size_t    __NO_ENTRY            = ~static_cast<stl::size_t>(0);
+
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef stl::pair<Key, T>   value_type;
+        typedef stl::size_t         size_type;
+        typedef stl::ptrdiff_t      difference_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef RehashPolicy        rehash_policy;
+        typedef value_type&         reference;
+        typedef const value_type&   const_reference;
+        typedef value_type*         iterator;
+        typedef const value_type*   const_iterator;
+
+        /// @brief Allocates nothing until the first insert.
+        dense_unordered_map()
+            : m_hash(), m_key_equal(), m_load_factor(__DEFAULT_LOAD_FACTOR) { }
+
+        explicit dense_unordered_map(size_type bucket_count, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : m_hash(hash), m_key_equal(equal), m_load_factor(__DEFAULT_LOAD_FACTOR)
+        { this->rehash(bucket_count); }
+
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        dense_unordered_map(InputIt first, InputIt last, size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : dense_unordered_map(bucket_count, hash, equal)
+        { this->insert(first, last); }
+
+        dense_unordered_map(std::initializer_list<value_type> ilist, size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : dense_unordered_map(ilist.begin(), ilist.end(), bucket_count, hash, equal) { }
+
+        dense_unordered_map(const dense_unordered_map& other) = default;
+
+        dense_unordered_map(dense_unordered_map&& other) noexcept
+            : m_hash(other.m_hash), m_key_equal(other.m_key_equal), m_load_factor(other.m_load_factor)
+        { this->swap(other); }
+
+        dense_unordered_map& operator=(const dense_unordered_map& other) = default;
+
+        dense_unordered_map& operator=(dense_unordered_map&& other) noexcept
+        {
+            if (this != &other)
+            {
+                dense_unordered_map temp(stl::move(other));
+                this->swap(temp);
+            }
+
+            return *this;
+        }
+
+        // Iteration is over the entry vector itself: no buckets, no chains.
+
+        iterator begin() noexcept { return this->m_entries.data(); }
+
+        iterator end() noexcept { return this->m_entries.data() + this->m_entries.size(); }
+
+        const_iterator begin() const noexcept { return this->m_entries.data(); }
+
+        const_iterator end() const noexcept { return this->m_entries.data() + this->m_entries.size(); }
+
+        const_iterator cbegin() const noexcept { return this->begin(); }
+
+        const_iterator cend() const noexcept { return this->end(); }
+
+        bool empty() const noexcept { return this->m_entries.empty(); }
+
+        size_type size() const noexcept { return this->m_entries.size(); }
+
+        /// @brief Removes every entry and keeps the bucket array.
+        void clear() noexcept;
+
+        pair<iterator, bool> insert(const value_type& value)
+        { return this->m_emplace(value.first, value.second); }
+
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                this->insert(*first);
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        { this->insert(ilist.begin(), ilist.end()); }
+
+        pair<iterator, bool> emplace(const key_type& key, const mapped_type& value)
+        { return this->m_emplace(key, value); }
+
+        /// @brief Builds @c mapped_type(args...) in place under @c key unless the key is present, in which case nothing is constructed.
+        template <typename... Args>
+        pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        { return this->m_emplace(key, stl::forward<Args>(args)...); }
+
+        mapped_type& operator[](const key_type& key)
+        { return this->try_emplace(key).first->second; }
+
+        /**
+         * @brief Erases the entry at @c pos by moving the last entry into its place.
+         * @return @c pos, which now holds the entry that was last (not yet visited by a scan from @c begin()), or @c end()
+         */
+        iterator erase(const_iterator pos);
+
+        size_type erase(const key_type& key);
+
+        iterator find(const key_type& key)
+        {
+            size_type index = this->m_find_index(key, this->m_hash(key));
+            return index != __NO_ENTRY ? this->begin() + index : this->end();
+        }
+
+        const_iterator find(const key_type& key) const
+        {
+            size_type index = this->m_find_index(key, this->m_hash(key));
+            return index != __NO_ENTRY ? this->begin() + index : this->end();
+        }
+
+        bool contains(const key_type& key) const
+        { return this->m_find_index(key, this->m_hash(key)) != __NO_ENTRY; }
+
+        size_type count(const key_type& key) const
+        { return this->contains(key) ? 1 : 0; }
+
+        mapped_type& at(const key_type& key)
+        {
+            iterator it = this->find(key);
+
+            if (it == this->end())
+                throw std::out_of_range("stl::dense_unordered_map::at: key not found");
+
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator it = this->find(key);
+
+            if (it == this->end())
+                throw std::out_of_range("stl::dense_unordered_map::at: key not found");
+
+            return it->second;
+        }
+
+        size_type bucket_count() const noexcept { return this->m_buckets.size(); }
+
+        float load_factor() const noexcept
+        { return this->m_buckets.empty() ? 0.f : static_cast<float>(this->size()) / this->bucket_count(); }
+
+        /// @brief Rebuilds the bucket array with at least @c new_size buckets; relinking reads the stored hashes only.
+        void rehash(size_type new_size);
+
+        /// @brief Makes room for @c count entries without reallocating the entries or the buckets.
+        void reserve(size_type count)
+        {
+            this->m_entries.reserve(count);
+            this->m_links.reserve(count);
+            this->rehash(static_cast<size_type>(count / this->m_load_factor) + 1);
+        }
+
+        hasher hash_function() const { return this->m_hash; }
+
+        key_equal key_eq() const { return this->m_key_equal; }
+
+        void swap(dense_unordered_map& other) noexcept
+        {
+            this->m_entries.swap(other.m_entries);
+            this->m_links.swap(other.m_links);
+            this->m_buckets.swap(other.m_buckets);
+            stl::swap(this->m_hash, other.m_hash);
+            stl::swap(this->m_key_equal, other.m_key_equal);
+            stl::swap(this->m_load_factor, other.m_load_factor);
+        }
+
+    private:
+        stl::vector<value_type>             m_entries;      // every entry, contiguous, in no particular order
+        stl::vector<__detail::__dense_link> m_links;        // chain link and hash of m_entries[i]
+        stl::vector<size_type>              m_buckets;      // index of the first entry of each chain, or __NO_ENTRY
+        hasher                              m_hash;
+        key_equal                           m_key_equal;
+        float                               m_load_factor;
+
+        size_type m_bucket(size_type code) const noexcept
+        { return RehashPolicy::bucket_index(code, this->m_buckets.size()); }
+
+        size_type m_find_index(const key_type& key, size_type code) const;
+
+        /// @brief Slot (bucket head or chain link) holding the index of the entry at @c index.
+        size_type* m_link_to(size_type index);
+
+        /// @brief Fills the hole at @c index, already unlinked from its chain, with the last entry and drops the last slot.
+        void m_erase_index(size_type index);
+
+        template <typename... Args>
+        pair<iterator, bool> m_emplace(const key_type& key, Args&&... args);
+    };
+}
+
+#include "dense_unordered_map.tcc"
@@ -0,0 +1,163 @@
+namespace stl
+{
+    // The vectors are read through their data in the hot paths: every index stored in a bucket or a link is in range
+    // by construction, and operator[] would check it again.
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    void dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::clear() noexcept
+    {
+        this->m_entries.clear();
+        this->m_links.clear();
+
+        size_type* buckets = this->m_buckets.data();
+
+        for (size_type b = 0; b < this->m_buckets.size(); ++b)
+            buckets[b] = __NO_ENTRY;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    typename dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::iterator
+    dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::erase(const_iterator pos)
+    {
+        size_type index = static_cast<size_type>(pos - this->cbegin());
+        size_type* link = this->m_link_to(index);
+
+        *link = this->m_links.data()[index].m_next;
+        this->m_erase_index(index);
+
+        return this->begin() + index;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    typename dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::size_type
+    dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::erase(const key_type& key)
+    {
+        if (this->m_entries.empty())
+            return 0;
+
+        size_type code = this->m_hash(key);
+        const value_type* entries = this->m_entries.data();
+        __detail::__dense_link* links = this->m_links.data();
+        size_type* link = this->m_buckets.data() + this->m_bucket(code);
+
+        while (*link != __NO_ENTRY && !(links[*link].m_hash == code && this->m_key_equal(entries[*link].first, key)))
+            link = &links[*link].m_next;
+
+        if (*link == __NO_ENTRY)
+            return 0;
+
+        size_type index = *link;
+        *link = links[index].m_next;
+        this->m_erase_index(index);
+
+        return 1;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    void dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::rehash(size_type new_size)
+    {
+        size_type min_size = static_cast<size_type>(this->m_entries.size() / this->m_load_factor) + 1;
+
+        if (new_size < min_size)
+            new_size = min_size;
+
+        this->m_buckets.assign(RehashPolicy::next_bucket_count(new_size), __NO_ENTRY);
+
+        size_type* buckets = this->m_buckets.data();
+        __detail::__dense_link* links = this->m_links.data();
+
+        // one linear pass over the links; the entries themselves are not touched
+        for (size_type i = 0; i < this->m_links.size(); ++i)
+        {
+            size_type b = this->m_bucket(links[i].m_hash);
+
+            links[i].m_next = buckets[b];
+            buckets[b] = i;
+        }
+    }
+
+    /// @c private_members
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    typename dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::size_type
+    dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::m_find_index(const key_type& key, size_type code) const
+    {
+        if (this->m_entries.empty())
+            return __NO_ENTRY;
+
+        const value_type* entries = this->m_entries.data();
+        const __detail::__dense_link* links = this->m_links.data();
+        size_type index = this->m_buckets.data()[this->m_bucket(code)];
+
+        while (index != __NO_ENTRY && !(links[index].m_hash == code && this->m_key_equal(entries[index].first, key)))
+            index = links[index].m_next;
+
+        return index;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    typename dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::size_type*
+    dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::m_link_to(size_type index)
+    {
+        __detail::__dense_link* links = this->m_links.data();
+        size_type* link = this->m_buckets.data() + this->m_bucket(links[index].m_hash);
+
+        while (*link != index)
+            link = &links[*link].m_next;
+
+        return link;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    void dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::m_erase_index(size_type index)
+    {
+        size_type last = this->m_entries.size() - 1;
+
+        if (index != last)
+        {
+            // whatever pointed at the last entry now points at the hole it moves into
+            *this->m_link_to(last) = index;
+
+            this->m_entries.data()[index] = stl::move(this->m_entries.data()[last]);
+            this->m_links.data()[index] = this->m_links.data()[last];
+        }
+
+        this->m_entries.pop_back();
+        this->m_links.pop_back();
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename RehashPolicy>
+    template <typename... Args>
+    pair<typename dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::iterator, bool>
+    dense_unordered_map<Key, T, Hash, KeyEqual, RehashPolicy>::m_emplace(const key_type& key, Args&&... args)
+    {
+        size_type code = this->m_hash(key);
+        size_type index = this->m_find_index(key, code);
+
+        if (index != __NO_ENTRY)
+            return {this->begin() + index, false};
+
+        size_type size = this->m_entries.size();
+
+        if (size + 1 > this->m_buckets.size() * this->m_load_factor)
+            this->rehash(this->m_buckets.empty() ? __DEFAULT_BUCKET_SIZE : this->m_buckets.size() * 2);
+
+        size_type b = this->m_bucket(code);
+
+        this->m_links.push_back(__detail::__dense_link{this->m_buckets.data()[b], code});
+
+        try
+        {
+            this->m_entries.emplace_back(__detail::__emplace_second_t(), key, stl::forward<Args>(args)...);
+        }
+        catch(...)
+        {
+            this->m_links.pop_back();
+            throw;
+        }
+
+        this->m_buckets.data()[b] = size;
+
+        return {this->begin() + size, true};
+    }
+}
@@ -0,0 +1,627 @@
+#pragma once
+
+#include "../../iterator.h"
+#include "../../allocator/allocator.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+#include "../../../cUtility/hashable.h"
+
+#include <stdexcept>
+#include <initializer_list>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define __FLAT_MAP_SSE2__ 1
+#else
+    #define __FLAT_MAP_SSE2__ 0
+#endif
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief Control byte describing the state of one slot of a @c stl::flat_hash_map.
+         *        A full slot stores the low 7 bits of its hash (0..127), so the sign bit is set only for empty/deleted slots.
+         */
+        typedef signed char ctrl_t;
+
+        constexpr ctrl_t      __ctrl_empty   = -128; // 0b10000000
+        constexpr ctrl_t      __ctrl_deleted = -2;   // 0b11111110
+        constexpr stl::size_t __group_width  = 16;
+
+        /// @brief Statically allocated group used by tables that have not allocated yet, so a lookup never has to branch on it.
+        alignas(16) inline const ctrl_t __empty_group[__group_width] = {
+            __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty,
+            __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty, __ctrl_empty
+        };
+
+        /// @brief Bitmask of the slots of a group that satisfy a query. Bit @c i is set if slot @c i matched.
+        struct __group_mask
+        {
+            unsigned int m_mask;
+
+            explicit operator bool() const noexcept { return this->m_mask != 0; }
+
+            unsigned int lowest() const noexcept { return static_cast<unsigned int>(__builtin_ctz(this->m_mask)); }
+
+            void clear_lowest() noexcept { this->m_mask &= this->m_mask - 1; }
+        };
+
+        /// @brief A window of @c __group_width control bytes that is matched in parallel (SSE2) or byte by byte (fallback).
+        struct __group
+        {
+        #if __FLAT_MAP_SSE2__
+            __m128i m_ctrl;
+
+            explicit __group(const ctrl_t* pos) noexcept
+                : m_ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) { }
+
+            __group_mask match(ctrl_t h2) const noexcept
+            { return { static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), this->m_ctrl))) }; }
+
+            __group_mask match_empty() const noexcept
+            { return this->match(__ctrl_empty); }
+
+            // empty and deleted are the only states with the sign bit set
+            __group_mask match_empty_or_deleted() const noexcept
+            { return { static_cast<unsigned int>(_mm_movemask_epi8(this->m_ctrl)) }; }
+        #else
+            const ctrl_t* m_ctrl;
+
+            explicit __group(const ctrl_t* pos) noexcept
+                : m_ctrl(pos) { }
+
+            __group_mask match(ctrl_t h2) const noexcept
+            {
+                unsigned int mask = 0;
+
+                for (stl::size_t i = 0; i < __group_width; ++i)
+                    mask |= static_cast<unsigned int>(this->m_ctrl[i] == h2) << i;
+
+                return { mask };
+            }
+
+            __group_mask match_empty() const noexcept
+            { return this->match(__ctrl_empty); }
+
+            __group_mask match_empty_or_deleted() const noexcept
+            {
+                unsigned int mask = 0;
+
+                for (stl::size_t i = 0; i < __group_width; ++i)
+                    mask |= static_cast<unsigned int>(this->m_ctrl[i] < 0) << i;
+
+                return { mask };
+            }
+        #endif
+        };
+
+        template <typename Key, typename T>
+        struct __flat_map_iterator
+        {
+            typedef stl::pair<Key, T>           value_type;
+            typedef value_type*                 pointer;
+            typedef value_type&                 reference;
+            typedef stl::ptrdiff_t              difference_type;
+            typedef stl::forward_iterator_tag   iterator_category;
+
+            ctrl_t*  m_ctrl;
+            ctrl_t*  m_ctrl_end;
+            pointer  m_slot;
+
+            __flat_map_iterator() noexcept
+                : m_ctrl(nullptr), m_ctrl_end(nullptr), m_slot(nullptr) { }
+
+            __flat_map_iterator(ctrl_t* __ctrl, ctrl_t* __ctrl_end, pointer __slot) noexcept
+                : m_ctrl(__ctrl), m_ctrl_end(__ctrl_end), m_slot(__slot) { }
+
+            reference operator*() const { return *this->m_slot; }
+
+            pointer operator->() const { return this->m_slot; }
+
+            __flat_map_iterator& operator++() noexcept
+            {
+                do
+                {
+                    ++this->m_ctrl;
+                    ++this->m_slot;
+                } while (this->m_ctrl != this->m_ctrl_end && *this->m_ctrl < 0);
+
+                return *this;
+            }
+
+            __flat_map_iterator operator++(int) noexcept
+            {
+                __flat_map_iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            bool operator==(const __flat_map_iterator& other) const noexcept { return this->m_ctrl == other.m_ctrl; }
+            bool operator!=(const __flat_map_iterator& other) const noexcept { return this->m_ctrl != other.m_ctrl; }
+        };
+
+        template <typename Key, typename T>
+        struct __const_flat_map_iterator
+        {
+            typedef const stl::pair<Key, T>     value_type;
+            typedef value_type*                 pointer;
+            typedef value_type&                 reference;
+            typedef stl::ptrdiff_t              difference_type;
+            typedef stl::forward_iterator_tag   iterator_category;
+
+            const ctrl_t*  m_ctrl;
+            const ctrl_t*  m_ctrl_end;
+            pointer        m_slot;
+
+            __const_flat_map_iterator() noexcept
+                : m_ctrl(nullptr), m_ctrl_end(nullptr), m_slot(nullptr) { }
+
+            __const_flat_map_iterator(const ctrl_t* __ctrl, const ctrl_t* __ctrl_end, pointer __slot) noexcept
+                : m_ctrl(__ctrl), m_ctrl_end(__ctrl_end), m_slot(__slot) { }
+
+            __const_flat_map_iterator(const __flat_map_iterator<Key, T>& __it) noexcept
+                : m_ctrl(__it.m_ctrl), m_ctrl_end(__it.m_ctrl_end), m_slot(__it.m_slot) { }
+
+            reference operator*() const { return *this->m_slot; }
+
+            pointer operator->() const { return this->m_slot; }
+
+            __const_flat_map_iterator& operator++() noexcept
+            {
+                do
+                {
+                    ++this->m_ctrl;
+                    ++this->m_slot;
+                } while (this->m_ctrl != this->m_ctrl_end && *this->m_ctrl < 0);
+
+                return *this;
+            }
+
+            __const_flat_map_iterator operator++(int) noexcept
+            {
+                __const_flat_map_iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            bool operator==(const __const_flat_map_iterator& other) const noexcept { return this->m_ctrl == other.m_ctrl; }
+            bool operator!=(const __const_flat_map_iterator& other) const noexcept { return this->m_ctrl != other.m_ctrl; }
+        };
+    }
+
+    /**
+     * @brief Open-addressing hash map that stores its elements inline in a single slot array (no per-element nodes).
+     *        Every slot has a one byte control tag; lookups compare 16 tags at once (SSE2 when available) and only
+     *        touch the slots whose 7-bit hash fragment matches, so a find usually costs a single cache miss.
+     *        The table is grown when it becomes 7/8 full. Erasing leaves a tombstone unless the group still has an empty slot.
+     * @param Key        Key type
+     * @param T          Value type
+     * @param Hash       Hash function type
+     * @param KeyEqual   Key comparison function type
+     * @param Allocator  Allocator type
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash      = stl::hash<Key>,
+        typename KeyEqual  = stl::equal_to<Key>,
+        typename Allocator = stl::allocator<stl::pair<Key, T>>
+    > class flat_hash_map
+    {
+        using ctrl_t         = __detail::ctrl_t;
+        using ctrl_allocator = typename Allocator::template rebind<ctrl_t>::other;
+
+        // enables the heterogeneous overloads for K when Hash and KeyEqual are both transparent
+        template <typename K>
+        using transparent_t = typename enable_if<__detail::__transparent_lookup<Hash, KeyEqual, K>::value>::type;
+
+    public:
+        typedef Key                                                         key_type;
+        typedef T                                                           mapped_type;
+        typedef stl::pair<Key, T>                                           value_type;
+        typedef stl::size_t                                                 size_type;
+        typedef stl::ptrdiff_t                                              difference_type;
+        typedef Hash                                                        hasher;
+        typedef KeyEqual                                                    key_equal;
+        typedef Allocator                                                   allocator_type;
+        typedef value_type&                                                 reference;
+        typedef const value_type&                                           const_reference;
+        typedef value_type*                                                 pointer;
+        typedef const value_type*                                           const_pointer;
+        typedef __detail::__flat_map_iterator<key_type, mapped_type>        iterator;
+        typedef __detail::__const_flat_map_iterator<key_type, mapped_type>  const_iterator;
+
+        flat_hash_map()
+            : flat_hash_map(0) { }
+
+        explicit flat_hash_map(size_type bucket_count, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
+            : m_ctrl(const_cast<ctrl_t*>(__detail::__empty_group)), m_slots(nullptr), m_size(0), m_capacity(0), m_group_mask(0), m_growth_left(0),
+              m_hash(hash), m_key_equal(equal), m_alloc(alloc)
+        {
+            if (bucket_count > 0)
+                this->reserve(bucket_count);
+        }
+
+        explicit flat_hash_map(const allocator_type& alloc)
+            : flat_hash_map(0, Hash(), KeyEqual(), alloc) { }
+
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        flat_hash_map(InputIt first, InputIt last, size_type bucket_count = 0, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
+            : flat_hash_map(bucket_count, hash, equal, alloc)
+        { this->insert(first, last); }
+
+        flat_hash_map(std::initializer_list<value_type> ilist, size_type bucket_count = 0, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
+            : flat_hash_map(ilist.begin(), ilist.end(), bucket_count, hash, equal, alloc) { }
+
+        flat_hash_map(const flat_hash_map& other)
+            : flat_hash_map(other.m_size, other.m_hash, other.m_key_equal, allocator_traits<Allocator>::select_on_container_copy_construction(other.m_alloc))
+        { this->insert(other.cbegin(), other.cend()); }
+
+        flat_hash_map(flat_hash_map&& other) noexcept
+            : m_ctrl(other.m_ctrl), m_slots(other.m_slots), m_size(other.m_size), m_capacity(other.m_capacity), m_group_mask(other.m_group_mask),
+              m_growth_left(other.m_growth_left), m_hash(stl::move(other.m_hash)), m_key_equal(stl::move(other.m_key_equal)), m_alloc(stl::move(other.m_alloc))
+        { other.m_reset(); }
+
+        ~flat_hash_map()
+        { this->m_destroy_table(); }
+
+        flat_hash_map& operator=(const flat_hash_map& other)
+        {
+            if (this != &other)
+            {
+                this->clear();
+                this->m_hash = other.m_hash;
+                this->m_key_equal = other.m_key_equal;
+                this->reserve(other.m_size);
+                this->insert(other.cbegin(), other.cend());
+            }
+
+            return *this;
+        }
+
+        flat_hash_map& operator=(flat_hash_map&& other) noexcept
+        {
+            if (this != &other)
+            {
+                this->m_destroy_table();
+
+                this->m_ctrl = other.m_ctrl;
+                this->m_slots = other.m_slots;
+                this->m_size = other.m_size;
+                this->m_capacity = other.m_capacity;
+                this->m_group_mask = other.m_group_mask;
+                this->m_growth_left = other.m_growth_left;
+                this->m_hash = stl::move(other.m_hash);
+                this->m_key_equal = stl::move(other.m_key_equal);
+                this->m_alloc = stl::move(other.m_alloc);
+
+                other.m_reset();
+            }
+
+            return *this;
+        }
+
+        flat_hash_map& operator=(std::initializer_list<value_type> ilist)
+        {
+            this->clear();
+            this->insert(ilist.begin(), ilist.end());
+            return *this;
+        }
+
+        allocator_type get_allocator() const noexcept
+        { return this->m_alloc; }
+
+        iterator begin() noexcept
+        {
+            iterator it(this->m_ctrl, this->m_ctrl + this->m_capacity, this->m_slots);
+
+            if (this->m_capacity != 0 && *it.m_ctrl < 0)
+                ++it;
+
+            return it;
+        }
+
+        iterator end() noexcept
+        { return iterator(this->m_ctrl + this->m_capacity, this->m_ctrl + this->m_capacity, this->m_slots + this->m_capacity); }
+
+        const_iterator begin() const noexcept { return this->cbegin(); }
+
+        const_iterator end() const noexcept { return this->cend(); }
+
+        const_iterator cbegin() const noexcept
+        { return const_cast<flat_hash_map*>(this)->begin(); }
+
+        const_iterator cend() const noexcept
+        { return const_cast<flat_hash_map*>(this)->end(); }
+
+        bool empty() const noexcept
+        { return this->m_size == 0; }
+
+        size_type size() const noexcept
+        { return this->m_size; }
+
+        size_type max_size() const noexcept
+        { return std::numeric_limits<difference_type>::max() / sizeof(value_type); }
+
+        void clear() noexcept;
+
+        pair<iterator, bool> insert(const_reference value)
+        { return this->m_emplace_unique(value.first, value.second); }
+
+        pair<iterator, bool> insert(value_type&& value)
+        { return this->m_emplace_unique(stl::move(value.first), stl::move(value.second)); }
+
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        void insert(InputIt first, InputIt last)
+        {
+            for (; first != last; ++first)
+                this->insert(*first);
+        }
+
+        void insert(std::initializer_list<value_type> ilist)
+        { this->insert(ilist.begin(), ilist.end()); }
+
+        template <typename... Args>
+        pair<iterator, bool> emplace(Args&&... args)
+        { return this->m_insert(stl::forward<Args>(args)...); }
+
+        /// @brief The hint is ignored: an element's slot follows from its hash alone.
+        template <typename... Args>
+        iterator emplace_hint(const_iterator, Args&&... args)
+        { return this->m_insert(stl::forward<Args>(args)...).first; }
+
+        template <typename... Args>
+        pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
+        { return this->m_emplace_unique(key, stl::forward<Args>(args)...); }
+
+        template <typename... Args>
+        pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
+        { return this->m_emplace_unique(stl::move(key), stl::forward<Args>(args)...); }
+
+        template <typename... Args>
+        iterator try_emplace(const_iterator, const key_type& key, Args&&... args)
+        { return this->try_emplace(key, stl::forward<Args>(args)...).first; }
+
+        template <typename... Args>
+        iterator try_emplace(const_iterator, key_type&& key, Args&&... args)
+        { return this->try_emplace(stl::move(key), stl::forward<Args>(args)...).first; }
+
+        iterator erase(const_iterator pos);
+
+        iterator erase(iterator pos)
+        { return this->erase(const_iterator(pos)); }
+
+        /// @brief Erases [@c first, @c last); erasing never moves the other elements, so @c last stays valid throughout.
+        iterator erase(const_iterator first, const_iterator last);
+
+        size_type erase(const key_type& key)
+        {
+            iterator it = this->find(key);
+
+            if (it == this->end())
+                return 0;
+
+            this->m_erase_slot(static_cast<size_type>(it.m_slot - this->m_slots));
+            return 1;
+        }
+
+        void swap(flat_hash_map& other) noexcept
+        {
+            stl::swap(this->m_ctrl, other.m_ctrl);
+            stl::swap(this->m_slots, other.m_slots);
+            stl::swap(this->m_size, other.m_size);
+            stl::swap(this->m_capacity, other.m_capacity);
+            stl::swap(this->m_group_mask, other.m_group_mask);
+            stl::swap(this->m_growth_left, other.m_growth_left);
+            stl::swap(this->m_hash, other.m_hash);
+            stl::swap(this->m_key_equal, other.m_key_equal);
+            stl::swap(this->m_alloc, other.m_alloc);
+        }
+
+        /// @brief Rebuilds the table with room for at least @c count slots (rounded up to a power-of-two number of groups).
+        void rehash(size_type count);
+
+        /// @brief Makes sure @c count elements can be stored without growing the table.
+        void reserve(size_type count)
+        {
+            if (count > this->m_size + this->m_growth_left)
+                this->rehash(count + count / 7); // inverse of the 7/8 max load factor
+        }
+
+        iterator find(const key_type& key)
+        {
+            size_type index = this->m_find(key);
+            return index == this->m_capacity ? this->end() : iterator(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index);
+        }
+
+        const_iterator find(const key_type& key) const
+        { return const_cast<flat_hash_map*>(this)->find(key); }
+
+        bool contains(const key_type& key) const
+        { return const_cast<flat_hash_map*>(this)->m_find(key) != this->m_capacity; }
+
+        // Heterogeneous lookup: hashes and compares @c x as is, so e.g. a @c std::string keyed map is searched by
+        // @c std::string_view or @c const char* without materialising a key.
+
+        template <typename K, typename = transparent_t<K>>
+        iterator find(const K& x)
+        {
+            size_type index = this->m_find(x);
+            return index == this->m_capacity ? this->end() : iterator(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index);
+        }
+
+        template <typename K, typename = transparent_t<K>>
+        const_iterator find(const K& x) const
+        { return const_cast<flat_hash_map*>(this)->find(x); }
+
+        template <typename K, typename = transparent_t<K>>
+        bool contains(const K& x) const
+        { return const_cast<flat_hash_map*>(this)->m_find(x) != this->m_capacity; }
+
+        size_type count(const key_type& key) const
+        { return this->contains(key) ? 1 : 0; }
+
+        mapped_type& at(const key_type& key)
+        {
+            iterator it = this->find(key);
+
+            if (it == this->end())
+                throw std::out_of_range("Key not found!\n");
+
+            return it->second;
+        }
+
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator cit = this->find(key);
+
+            if (cit == this->cend())
+                throw std::out_of_range("Key not found!\n");
+
+            return cit->second;
+        }
+
+        mapped_type& operator[](const key_type& key)
+        { return this->try_emplace(key).first->second; }
+
+        mapped_type& operator[](key_type&& key)
+        { return this->try_emplace(stl::move(key)).first->second; }
+
+        size_type bucket_count() const noexcept { return this->m_capacity; }
+
+        float load_factor() const noexcept
+        { return this->m_capacity == 0 ? 0.0f : static_cast<float>(this->m_size) / this->m_capacity; }
+
+        float max_load_factor() const noexcept { return 7.0f / 8.0f; }
+
+        hasher hash_function() const { return this->m_hash; }
+
+        key_equal key_eq() const { return this->m_key_equal; }
+
+    private:
+        ctrl_t*         m_ctrl;             // one control byte per slot, points at @c __empty_group until the first allocation
+        pointer         m_slots;            // uninitialized storage, a slot is alive iff its control byte is >= 0
+        size_type       m_size;
+        size_type       m_capacity;         // number of slots (a multiple of the group width), 0 while unallocated
+        size_type       m_group_mask;       // number of groups - 1
+        size_type       m_growth_left;      // inserts into empty slots left before the table must grow
+        hasher          m_hash;
+        key_equal       m_key_equal;
+        allocator_type  m_alloc;
+
+        /// @brief Post-mixes the user hash so that identity hashes (e.g. @c stl::hash<int>) spread over both H1 and H2.
+        static size_type m_mix(size_type h) noexcept
+        { return __detail::__hash_mix(h); }
+
+        static size_type m_h1(size_type h) noexcept { return h >> 7; }
+
+        static ctrl_t m_h2(size_type h) noexcept { return static_cast<ctrl_t>(h & 0x7F); }
+
+        static size_type m_capacity_to_growth(size_type capacity) noexcept
+        { return capacity - capacity / 8; }
+
+        /// @brief Slot of @c key, or @c m_capacity if it is absent; @c key is a @c key_type or a key of a transparent map.
+        template <typename K>
+        size_type m_find(const K& key)
+        { return this->m_find(key, m_mix(this->m_hash(key))); }
+
+        template <typename K>
+        size_type m_find(const K& key, size_type hash);
+
+        size_type m_find_first_non_full(size_type hash) const noexcept;
+
+        // a key argument is used for the lookup as is when it is a key_type or the map is transparent for it
+        template <typename K>
+        using direct_key_t = bool_constant<is_same<typename remove_cv<typename remove_reference<K>::type>::type, key_type>::value ||
+                                           __detail::__transparent_lookup<Hash, KeyEqual, K>::value>;
+
+        /**
+         * @brief Core of every insertion: looks @c key up and, only if it is absent, builds the element from @c key and
+         *        @c args straight into its slot.
+         */
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_unique(K&& key, Args&&... args)
+        {
+            size_type hash = m_mix(this->m_hash(key));
+            size_type index = this->m_find(key, hash);
+
+            if (index != this->m_capacity)
+                return {iterator(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index), false};
+
+            return this->m_emplace_new(hash, stl::forward<K>(key), stl::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Miss path of @c m_emplace_unique for a key hashing to @c hash. When the table has to grow first, the
+         *        arguments may refer to an element that growing moves, so the element is built before and moved in after.
+         */
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_new(size_type hash, K&& key, Args&&... args);
+
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(K&& key, Args&&... args)
+        { return this->m_emplace_key(direct_key_t<K>(), stl::forward<K>(key), stl::forward<Args>(args)...); }
+
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(stl::true_type, K&& key, Args&&... args)
+        { return this->m_emplace_unique(stl::forward<K>(key), stl::forward<Args>(args)...); }
+
+        /// @brief The key is converted once, then moved into the slot if it is new.
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(stl::false_type, K&& key, Args&&... args)
+        {
+            key_type converted(stl::forward<K>(key));
+            return this->m_emplace_unique(stl::move(converted), stl::forward<Args>(args)...);
+        }
+
+        // emplace: a (key, value) pair of arguments and a whole element are looked up before anything is built;
+        // any other argument list has to build its element first to learn the key
+
+        template <typename K, typename V>
+        pair<iterator, bool> m_insert(K&& key, V&& value)
+        { return this->m_emplace_key(stl::forward<K>(key), stl::forward<V>(value)); }
+
+        pair<iterator, bool> m_insert(const value_type& value)
+        { return this->m_emplace_unique(value.first, value.second); }
+
+        pair<iterator, bool> m_insert(value_type& value)
+        { return this->m_emplace_unique(value.first, value.second); }
+
+        pair<iterator, bool> m_insert(value_type&& value)
+        { return this->m_emplace_unique(stl::move(value.first), stl::move(value.second)); }
+
+        template <typename... Args>
+        pair<iterator, bool> m_insert(Args&&... args)
+        {
+            value_type value(stl::forward<Args>(args)...);
+            return this->m_emplace_unique(stl::move(value.first), stl::move(value.second));
+        }
+
+        void m_set_ctrl(size_type index, ctrl_t h) noexcept
+        { this->m_ctrl[index] = h; }
+
+        void m_erase_slot(size_type index);
+
+        void m_resize(size_type new_capacity);
+
+        void m_destroy_table();
+
+        void m_reset() noexcept
+        {
+            this->m_ctrl = const_cast<ctrl_t*>(__detail::__empty_group);
+            this->m_slots = nullptr;
+            this->m_size = this->m_capacity = this->m_group_mask = this->m_growth_left = 0;
+        }
+    };
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    inline void swap(flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs, flat_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) noexcept
+    { lhs.swap(rhs); }
+}
+
+#include "flat_hash_map.tcc"
@@ -0,0 +1,224 @@
+namespace stl
+{
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::clear() noexcept
+    {
+        if (this->m_capacity == 0)
+            return;
+
+        for (size_type i = 0; i < this->m_capacity; ++i)
+            if (this->m_ctrl[i] >= 0)
+                this->m_alloc.destroy(this->m_slots + i);
+
+        for (size_type i = 0; i < this->m_capacity; ++i)
+            this->m_ctrl[i] = __detail::__ctrl_empty;
+
+        this->m_size = 0;
+        this->m_growth_left = m_capacity_to_growth(this->m_capacity);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+    flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator pos)
+    {
+        size_type index = static_cast<size_type>(pos.m_slot - this->m_slots);
+        iterator next(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index);
+
+        this->m_erase_slot(index);
+
+        return ++next;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator
+    flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator first, const_iterator last)
+    {
+        while (first != last)
+            first = this->erase(first);
+
+        size_type index = static_cast<size_type>(last.m_slot - this->m_slots);
+        return iterator(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::rehash(size_type count)
+    {
+        if (count < this->m_size)
+            count = this->m_size;
+
+        size_type new_capacity = __detail::__group_width;
+
+        while (new_capacity < count)
+            new_capacity *= 2;
+
+        if (m_capacity_to_growth(new_capacity) < this->m_size)
+            new_capacity *= 2;
+
+        this->m_resize(new_capacity);
+    }
+
+    /// @c private_members
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename K>
+    typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+    flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_find(const K& key, size_type hash)
+    {
+        ctrl_t h2 = m_h2(hash);
+        size_type group = m_h1(hash) & this->m_group_mask;
+
+        for (size_type step = 1; ; ++step)
+        {
+            __detail::__group g(this->m_ctrl + group * __detail::__group_width);
+
+            for (__detail::__group_mask match = g.match(h2); match; match.clear_lowest())
+            {
+                size_type index = group * __detail::__group_width + match.lowest();
+
+                if (this->m_key_equal(this->m_slots[index].first, key))
+                    return index;
+            }
+
+            // the key would have been placed in this group if it existed
+            if (g.match_empty())
+                return this->m_capacity;
+
+            // triangular probing visits every group exactly once when the group count is a power of two
+            group = (group + step) & this->m_group_mask;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename K, typename... Args>
+    pair<typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
+    flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_emplace_new(size_type hash, K&& key, Args&&... args)
+    {
+        size_type index = this->m_find_first_non_full(hash);
+
+        // a tombstone can always be reused, an empty slot only while the table is under the max load factor
+        if (this->m_growth_left == 0 && this->m_ctrl[index] != __detail::__ctrl_deleted)
+        {
+            value_type value(__detail::__emplace_second_t(), stl::forward<K>(key), stl::forward<Args>(args)...);
+
+            // mostly tombstones: rebuild in place instead of doubling
+            if (this->m_size < m_capacity_to_growth(this->m_capacity) / 2)
+                this->m_resize(this->m_capacity);
+            else
+                this->m_resize(this->m_capacity == 0 ? __detail::__group_width : this->m_capacity * 2);
+
+            index = this->m_find_first_non_full(hash);
+            this->m_alloc.construct(this->m_slots + index, stl::move(value));
+        }
+        else
+            this->m_alloc.construct(this->m_slots + index, __detail::__emplace_second_t(), stl::forward<K>(key), stl::forward<Args>(args)...);
+
+        this->m_growth_left -= (this->m_ctrl[index] == __detail::__ctrl_empty);
+        this->m_set_ctrl(index, m_h2(hash));
+        ++this->m_size;
+
+        return {iterator(this->m_ctrl + index, this->m_ctrl + this->m_capacity, this->m_slots + index), true};
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+    flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_find_first_non_full(size_type hash) const noexcept
+    {
+        size_type group = m_h1(hash) & this->m_group_mask;
+
+        for (size_type step = 1; ; ++step)
+        {
+            __detail::__group_mask mask = __detail::__group(this->m_ctrl + group * __detail::__group_width).match_empty_or_deleted();
+
+            if (mask)
+                return group * __detail::__group_width + mask.lowest();
+
+            group = (group + step) & this->m_group_mask;
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_erase_slot(size_type index)
+    {
+        this->m_alloc.destroy(this->m_slots + index);
+        --this->m_size;
+
+        // Groups are probed as aligned windows and empty slots are never created by inserts, so a group that still
+        // has an empty slot was never full and no probe sequence went past it: the slot can become empty again.
+        size_type group_begin = index & ~(__detail::__group_width - 1);
+
+        if (__detail::__group(this->m_ctrl + group_begin).match_empty())
+        {
+            this->m_set_ctrl(index, __detail::__ctrl_empty);
+            ++this->m_growth_left;
+        }
+        else
+            this->m_set_ctrl(index, __detail::__ctrl_deleted);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_resize(size_type new_capacity)
+    {
+        ctrl_t* old_ctrl = this->m_ctrl;
+        pointer old_slots = this->m_slots;
+        size_type old_capacity = this->m_capacity;
+
+        ctrl_allocator __ctrl_alloc = this->m_alloc;
+
+        // both arrays are allocated before any member changes, so a throwing allocation leaves the map as it was
+        ctrl_t* new_ctrl = __ctrl_alloc.allocate(new_capacity);
+        pointer new_slots;
+
+        try
+        {
+            new_slots = this->m_alloc.allocate(new_capacity);
+        }
+        catch (...)
+        {
+            __ctrl_alloc.deallocate(new_ctrl, new_capacity);
+            throw;
+        }
+
+        this->m_ctrl = new_ctrl;
+        this->m_slots = new_slots;
+        this->m_capacity = new_capacity;
+        this->m_group_mask = new_capacity / __detail::__group_width - 1;
+        this->m_growth_left = m_capacity_to_growth(new_capacity) - this->m_size;
+
+        for (size_type i = 0; i < new_capacity; ++i)
+            this->m_ctrl[i] = __detail::__ctrl_empty;
+
+        for (size_type i = 0; i < old_capacity; ++i)
+        {
+            if (old_ctrl[i] < 0)
+                continue;
+
+            size_type hash = m_mix(this->m_hash(old_slots[i].first));
+            size_type index = this->m_find_first_non_full(hash);
+
+            this->m_alloc.construct(this->m_slots + index, stl::move(old_slots[i]));
+            this->m_alloc.destroy(old_slots + i);
+            this->m_set_ctrl(index, m_h2(hash));
+        }
+
+        if (old_capacity != 0)
+        {
+            __ctrl_alloc.deallocate(old_ctrl, old_capacity);
+            this->m_alloc.deallocate(old_slots, old_capacity);
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void flat_hash_map<Key, T, Hash, KeyEqual, Allocator>::m_destroy_table()
+    {
+        if (this->m_capacity == 0)
+            return;
+
+        this->clear();
+
+        ctrl_allocator __ctrl_alloc = this->m_alloc;
+        __ctrl_alloc.deallocate(this->m_ctrl, this->m_capacity);
+        this->m_alloc.deallocate(this->m_slots, this->m_capacity);
+
+        this->m_reset();
+    }
+}
@@ -299,7 +299,8 @@ namespace stl
     {
         if (this->m_head != nullptr)
         {
-            Node* head = this->m_head;
+            // the sentinel head stays alive: assign() and operator= append to it right after clearing
+            Node* head = this->m_head->m_next;
 
             while (head != nullptr)
             {
@@ -307,6 +308,8 @@ namespace stl
                 head = head->m_next;
                 this->m_destroy_node(temp);
             }
+
+            this->m_head->m_next = nullptr;
         }
     }
 
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../vector/vector.h"
+#include "../unordered_map/unordered_map.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_bytes.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief Maps a 64-bit hash onto [0, @c n) through the high half of one 64x64 multiply (Lemire's fast range), no division.
+        inline uint64_t __fast_range(uint64_t hash, uint64_t n) noexcept
+        {
+            __ce_mum(hash, n);
+            return n;
+        }
+
+        inline bool __test_bit(const uint64_t* bits, size_t index) noexcept
+        { return (bits[index >> 6] >> (index & 63)) & 1; }
+
+        inline void __set_bit(uint64_t* bits, size_t index) noexcept
+        { bits[index >> 6] |= static_cast<uint64_t>(1) << (index & 63); }
+    }
+
+    /**
+     * @brief Immutable map built once from an existing map or a range, for tables filled at startup and only read
+     *        afterwards. Keys are laid out by a minimal perfect hash (PTHash style hash and displace): each key's
+     *        first-level bucket stores a small pilot that sends the bucket's keys to distinct slots of a table 1/32nd
+     *        larger than the key count, and the few slots past the end are remapped into the holes below it. Entries
+     *        live contiguously in one @c stl::vector, in slot order, with no empty slots and no chains, and a lookup
+     *        reads one pilot and one entry: a single probe and a single key comparison, hit or miss. Per key the
+     *        index costs a 32-bit pilot per three keys plus a quarter of a byte for the remap table.
+     * @param Key       Key type
+     * @param T         Value type
+     * @param Hash      Hash function type
+     * @param KeyEqual  Key comparison function type
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash     = stl::hash<Key>,
+        typename KeyEqual = stl::equal_to<Key>
+    > class frozen_unordered_map
+    {
+        constexpr static stl::size_t    __BUCKET_KEYS      = 3;            // average keys per first-level bucket
+        constexpr static stl::size_t    __TABLE_SLACK      = 32;           // the table holds n + n / 32 + 1 slots before remapping
+        constexpr static uint64_t       __MAX_PILOT_TRIES  = 1 << 24;      // per bucket, before the build gives up
+
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef stl::pair<Key, T>   value_type;
+        typedef stl::size_t         size_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef const value_type&   const_reference;
+        typedef const value_type*   const_iterator;
+        typedef const_iterator      iterator;
+
+        explicit frozen_unordered_map(const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : m_size(0), m_table_size(0), m_hash(hash), m_key_equal(equal) { }
+
+        /**
+         * @brief Builds the map over [@c first, @c last). Like @c unordered_map::insert, the first of several equal keys is kept.
+         * @throws std::invalid_argument on distinct keys with equal full hashes, which no perfect hash can separate
+         */
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        frozen_unordered_map(InputIt first, InputIt last, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : m_size(0), m_table_size(0), m_hash(hash), m_key_equal(equal)
+        {
+            stl::vector<value_type> items;
+            for (; first != last; ++first)
+                items.push_back(value_type(first->first, first->second));
+
+            stl::vector<const value_type*> sources;
+            sources.reserve(items.size());
+            for (size_type i = 0; i < items.size(); ++i)
+                sources.push_back(items.data() + i);
+
+            this->m_build(sources);
+        }
+
+        /// @brief Freezes the entries of @c map, whatever its hash, allocator, rehash policy and inline capacity.
+        template <typename H, typename E, typename A, typename P, bool S, stl::size_t N>
+        explicit frozen_unordered_map(const unordered_map<Key, T, H, E, A, P, S, N>& map, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : m_size(0), m_table_size(0), m_hash(hash), m_key_equal(equal)
+        {
+            // the entries are read in place, each copied once, straight to its slot
+            stl::vector<const value_type*> sources;
+            sources.reserve(map.size());
+
+            for (auto it = map.cbegin(); it != map.cend(); ++it)
+                sources.push_back(&*it);
+
+            this->m_build(sources);
+        }
+
+        frozen_unordered_map(std::initializer_list<value_type> ilist, const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : frozen_unordered_map(ilist.begin(), ilist.end(), hash, equal) { }
+
+        const_iterator begin() const noexcept { return this->m_items.cbegin(); }
+
+        const_iterator end() const noexcept { return this->m_items.cbegin() + this->m_size; }
+
+        const_iterator cbegin() const noexcept { return this->begin(); }
+
+        const_iterator cend() const noexcept { return this->end(); }
+
+        bool empty() const noexcept { return this->m_size == 0; }
+
+        size_type size() const noexcept { return this->m_size; }
+
+        /// @brief Number of first-level buckets, each holding one pilot.
+        size_type bucket_count() const noexcept { return this->m_pilots.size(); }
+
+        /// @brief Entry of @c key, or @c end() when it is not one of the map's keys.
+        const_iterator find(const key_type& key) const;
+
+        bool contains(const key_type& key) const { return this->find(key) != this->end(); }
+
+        size_type count(const key_type& key) const { return this->contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Returns the value mapped to @c key
+         * @throws std::out_of_range if @c key is not one of the map's keys
+         */
+        const mapped_type& at(const key_type& key) const;
+
+        hasher hash_function() const { return this->m_hash; }
+
+        key_equal key_eq() const { return this->m_key_equal; }
+
+    private:
+        /// @brief Searches a perfect hash over the entries behind @c sources and copies them into their slots.
+        void m_build(const stl::vector<const value_type*>& sources);
+
+        /// @brief First-level code of a key: its hash through the fmix64 finalizer, so identity hashes spread over the buckets too.
+        uint64_t m_code(const key_type& key) const
+        { return __detail::__hash_mix(this->m_hash(key)); }
+
+        size_type m_bucket(uint64_t code) const noexcept
+        { return static_cast<size_type>(__detail::__fast_range(code, this->m_pilots.size())); }
+
+        /// @brief Table slot of a key under a pilot: the bucket bits are the code's top bits, so the multiply brings its low bits up first.
+        size_type m_position(uint64_t code, uint64_t pilot) const noexcept
+        { return static_cast<size_type>(__detail::__fast_range((code ^ pilot) * 0x9e3779b97f4a7c15ULL, this->m_table_size)); }
+
+        size_type                   m_size;
+        size_type                   m_table_size;   // slots the pilots address, m_size of them kept
+        stl::vector<value_type>     m_items;        // entries in slot order
+        stl::vector<uint32_t>       m_pilots;       // displacement of each first-level bucket
+        stl::vector<size_type>      m_remap;        // slot below m_size of each slot at or past it
+        hasher                      m_hash;
+        key_equal                   m_key_equal;
+    };
+}
+
+#include "frozen_unordered_map.tcc"
@@ -0,0 +1,198 @@
+namespace stl
+{
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    void frozen_unordered_map<Key, T, Hash, KeyEqual>::m_build(const stl::vector<const value_type*>& sources)
+    {
+        const size_type n = sources.size();
+
+        if (n == 0)
+            return;
+
+        // the scratch tables below are only read through their data, where every index is in range by construction
+        const value_type* const* entries = sources.data();
+        const size_type buckets = (n + __BUCKET_KEYS - 1) / __BUCKET_KEYS;
+
+        this->m_pilots.assign(buckets, 0);
+
+        stl::vector<uint64_t>  code_table(n, 0);
+        stl::vector<size_type> start_table(buckets + 1, 0);     // bucket b holds members [start[b], start[b] + sizes[b])
+        stl::vector<size_type> size_table(buckets, 0);
+        stl::vector<size_type> member_table(n, 0);
+        stl::vector<uint64_t>  member_code_table(n, 0);         // codes of the members, so a bucket's codes are contiguous
+
+        uint64_t*  codes        = code_table.data();
+        size_type* start        = start_table.data();
+        size_type* sizes        = size_table.data();
+        size_type* members      = member_table.data();
+        uint64_t*  member_codes = member_code_table.data();
+
+        for (size_type i = 0; i < n; ++i)
+        {
+            codes[i] = this->m_code(entries[i]->first);
+            ++start[this->m_bucket(codes[i]) + 1];
+        }
+
+        for (size_type b = 0; b < buckets; ++b)
+            start[b + 1] += start[b];
+
+        // members in input order, so the first of several equal keys comes first in its bucket
+        for (size_type i = 0; i < n; ++i)
+        {
+            size_type b  = this->m_bucket(codes[i]);
+            size_type at = start[b] + sizes[b]++;
+            members[at] = i;
+            member_codes[at] = codes[i];
+        }
+
+        size_type unique = 0, largest = 0;
+
+        for (size_type b = 0; b < buckets; ++b)
+        {
+            size_type* keys      = members + start[b];
+            uint64_t*  key_codes = member_codes + start[b];
+            size_type  kept = 0;
+
+            for (size_type j = 0; j < sizes[b]; ++j)
+            {
+                bool duplicate = false;
+
+                for (size_type k = 0; k < kept && !duplicate; ++k)
+                    if (key_codes[k] == key_codes[j])
+                    {
+                        if (!this->m_key_equal(entries[keys[k]]->first, entries[keys[j]]->first))
+                            throw std::invalid_argument("stl::frozen_unordered_map: keys with equal hashes");
+
+                        duplicate = true;
+                    }
+
+                if (!duplicate)
+                {
+                    keys[kept] = keys[j];
+                    key_codes[kept++] = key_codes[j];
+                }
+            }
+
+            sizes[b] = kept;
+            unique += kept;
+            if (kept > largest)
+                largest = kept;
+        }
+
+        // largest buckets first, while most slots are still free: counting sort by descending size
+        stl::vector<size_type> offset_table(largest + 1, 0);
+        stl::vector<size_type> order_table(buckets, 0);
+        size_type* offsets = offset_table.data();
+        size_type* order   = order_table.data();
+
+        for (size_type b = 0; b < buckets; ++b)
+            ++offsets[sizes[b]];
+
+        for (size_type size = largest + 1, offset = 0; size-- > 0; )
+        {
+            size_type count = offsets[size];
+            offsets[size] = offset;
+            offset += count;
+        }
+
+        for (size_type b = 0; b < buckets; ++b)
+            order[offsets[sizes[b]]++] = b;
+
+        this->m_table_size = unique + unique / __TABLE_SLACK + 1;
+
+        // one bit per slot, so the table searched for free slots stays in cache
+        stl::vector<uint64_t>  taken_table(this->m_table_size / 64 + 1, 0);
+        stl::vector<size_type> position_table(largest, 0);
+        stl::vector<size_type> source_table(this->m_table_size, 0);        // entry landing in each slot
+        uint64_t*  taken     = taken_table.data();
+        size_type* positions = position_table.data();
+        size_type* source    = source_table.data();
+        uint32_t*  pilots    = this->m_pilots.data();
+
+        for (size_type r = 0; r < buckets && sizes[order[r]] > 0; ++r)
+        {
+            const size_type  b         = order[r];
+            const size_type* keys      = members + start[b];
+            const uint64_t*  key_codes = member_codes + start[b];
+            uint64_t pilot = 0;
+
+            for (;; ++pilot)
+            {
+                if (pilot == __MAX_PILOT_TRIES)
+                    throw std::invalid_argument("stl::frozen_unordered_map: no perfect hash found");
+
+                bool placed = true;
+
+                for (size_type j = 0; j < sizes[b] && placed; ++j)
+                {
+                    positions[j] = this->m_position(key_codes[j], pilot);
+                    placed = !__detail::__test_bit(taken, positions[j]);
+
+                    for (size_type k = 0; k < j && placed; ++k)
+                        placed = positions[k] != positions[j];
+                }
+
+                if (placed)
+                    break;
+            }
+
+            pilots[b] = static_cast<uint32_t>(pilot);
+
+            for (size_type j = 0; j < sizes[b]; ++j)
+            {
+                __detail::__set_bit(taken, positions[j]);
+                source[positions[j]] = keys[j];
+            }
+        }
+
+        // minimal: each taken slot past the kept range moves to a hole below it, in order
+        this->m_remap.assign(this->m_table_size - unique, 0);
+        size_type* remap = this->m_remap.data();
+
+        for (size_type slot = unique, hole = 0; slot < this->m_table_size; ++slot)
+            if (__detail::__test_bit(taken, slot))
+            {
+                while (__detail::__test_bit(taken, hole))
+                    ++hole;
+
+                source[hole] = source[slot];
+                remap[slot - unique] = hole++;
+            }
+
+        // one copy per entry, in slot order; duplicates, never placed, are left behind
+        this->m_items.reserve(unique);
+        for (size_type slot = 0; slot < unique; ++slot)
+            this->m_items.push_back(*entries[source[slot]]);
+
+        this->m_size = unique;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    typename frozen_unordered_map<Key, T, Hash, KeyEqual>::const_iterator
+    frozen_unordered_map<Key, T, Hash, KeyEqual>::find(const key_type& key) const
+    {
+        if (this->m_size == 0)
+            return this->end();
+
+        // every index is in range by construction, so the tables are read through their data, without operator[]'s check
+        uint64_t code = this->m_code(key);
+        size_type slot = this->m_position(code, this->m_pilots.data()[this->m_bucket(code)]);
+
+        if (slot >= this->m_size)
+            slot = this->m_remap.data()[slot - this->m_size];
+
+        const value_type* entry = this->m_items.data() + slot;
+        return this->m_key_equal(entry->first, key) ? entry : this->end();
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    const typename frozen_unordered_map<Key, T, Hash, KeyEqual>::mapped_type&
+    frozen_unordered_map<Key, T, Hash, KeyEqual>::at(const key_type& key) const
+    {
+        const_iterator it = this->find(key);
+
+        if (it == this->end())
+            throw std::out_of_range("stl::frozen_unordered_map::at: key not found");
+
+        return it->second;
+    }
+}
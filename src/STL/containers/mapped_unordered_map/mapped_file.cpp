@@ -0,0 +1,111 @@
+#include "mapped_file.h"
+
+#include <cstdio>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+    #define __MAPPED_FILE_MMAP__ 1
+#else
+    #define __MAPPED_FILE_MMAP__ 0
+#endif
+
+namespace stl
+{
+    namespace __detail
+    {
+    #if __MAPPED_FILE_MMAP__
+        __mapped_file::__mapped_file(const char* path)
+            : m_data(nullptr), m_size(0)
+        {
+            int fd = ::open(path, O_RDONLY);
+
+            if (fd < 0)
+                throw std::runtime_error(std::string("stl::__mapped_file: cannot open ") + path);
+
+            struct stat info;
+
+            if (::fstat(fd, &info) != 0)
+            {
+                ::close(fd);
+                throw std::runtime_error(std::string("stl::__mapped_file: cannot stat ") + path);
+            }
+
+            // an empty file has nothing to map: the view is left empty and rejected by its reader
+            if (info.st_size > 0)
+            {
+                void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+
+                if (data == MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw std::runtime_error(std::string("stl::__mapped_file: cannot map ") + path);
+                }
+
+                this->m_data = static_cast<const unsigned char*>(data);
+                this->m_size = static_cast<size_t>(info.st_size);
+            }
+
+            // the mapping keeps the file referenced on its own
+            ::close(fd);
+        }
+
+        void __mapped_file::m_release() noexcept
+        {
+            if (this->m_data != nullptr)
+                ::munmap(const_cast<unsigned char*>(this->m_data), this->m_size);
+
+            this->m_data = nullptr;
+            this->m_size = 0;
+        }
+    #else
+        __mapped_file::__mapped_file(const char* path)
+            : m_data(nullptr), m_size(0)
+        {
+            std::FILE* file = std::fopen(path, "rb");
+
+            if (file == nullptr)
+                throw std::runtime_error(std::string("stl::__mapped_file: cannot open ") + path);
+
+            long size = std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : -1;
+
+            if (size < 0 || std::fseek(file, 0, SEEK_SET) != 0)
+            {
+                std::fclose(file);
+                throw std::runtime_error(std::string("stl::__mapped_file: cannot size ") + path);
+            }
+
+            if (size > 0)
+            {
+                unsigned char* data = static_cast<unsigned char*>(::operator new(static_cast<size_t>(size), std::align_val_t(64)));
+
+                if (std::fread(data, 1, static_cast<size_t>(size), file) != static_cast<size_t>(size))
+                {
+                    ::operator delete(data, std::align_val_t(64));
+                    std::fclose(file);
+                    throw std::runtime_error(std::string("stl::__mapped_file: cannot read ") + path);
+                }
+
+                this->m_data = data;
+                this->m_size = static_cast<size_t>(size);
+            }
+
+            std::fclose(file);
+        }
+
+        void __mapped_file::m_release() noexcept
+        {
+            if (this->m_data != nullptr)
+                ::operator delete(const_cast<unsigned char*>(this->m_data), std::align_val_t(64));
+
+            this->m_data = nullptr;
+            this->m_size = 0;
+        }
+    #endif
+    }
+}
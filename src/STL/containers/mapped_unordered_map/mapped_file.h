@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../../traits/type_traits.h"
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief Read-only view of a whole file: mapped with @c mmap on POSIX systems, so its pages are read on first
+         *        touch and shared with every process mapping the same file; elsewhere a heap copy of the file.
+         *        Either way the bytes start on a 64-byte boundary.
+         */
+        class __mapped_file
+        {
+        public:
+            __mapped_file() noexcept
+                : m_data(nullptr), m_size(0) { }
+
+            /// @throws std::runtime_error if @c path cannot be opened, sized or mapped
+            explicit __mapped_file(const char* path);
+
+            __mapped_file(__mapped_file&& other) noexcept
+                : m_data(other.m_data), m_size(other.m_size)
+            {
+                other.m_data = nullptr;
+                other.m_size = 0;
+            }
+
+            __mapped_file& operator=(__mapped_file&& other) noexcept
+            {
+                __mapped_file temp(static_cast<__mapped_file&&>(other));
+                this->swap(temp);
+                return *this;
+            }
+
+            ~__mapped_file() { this->m_release(); }
+
+            const unsigned char* data() const noexcept { return this->m_data; }
+
+            size_t size() const noexcept { return this->m_size; }
+
+            void swap(__mapped_file& other) noexcept
+            {
+                const unsigned char* data = this->m_data;
+                size_t size = this->m_size;
+
+                this->m_data = other.m_data;
+                this->m_size = other.m_size;
+                other.m_data = data;
+                other.m_size = size;
+            }
+
+        private:
+            const unsigned char* m_data;
+            size_t               m_size;
+
+            __mapped_file(const __mapped_file&) = delete;
+            __mapped_file& operator=(const __mapped_file&) = delete;
+
+            void m_release() noexcept;
+        };
+    }
+}
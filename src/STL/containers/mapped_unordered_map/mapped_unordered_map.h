@@ -0,0 +1,212 @@
+#pragma once
+
+#include "mapped_file.h"
+#include "../vector/vector.h"
+#include "../unordered_map/unordered_map.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief First 64 bytes of a map image. Every position is an offset from the start of the image, so the image
+         *        means the same wherever it is mapped.
+         */
+        struct __map_image_header
+        {
+            uint64_t m_magic;           // __IMAGE_MAGIC, which also tells a foreign byte order apart
+            uint32_t m_version;
+            uint32_t m_key_size;
+            uint32_t m_entry_size;      // with m_key_size, pins the layout of an entry
+            uint32_t m_entry_align;
+            uint64_t m_size;            // entries
+            uint64_t m_bucket_count;    // a power of two
+            uint64_t m_buckets_offset;  // m_bucket_count + 1 uint64_t: bucket b holds entries [buckets[b], buckets[b + 1])
+            uint64_t m_entries_offset;  // m_size entries, grouped by bucket, 64-byte aligned
+            uint64_t m_first_code;      // code of the first entry's key: a reader hashing differently is turned away
+        };
+    }
+
+    /**
+     * @brief Read-only map served straight from a file image written by @c write: opening it maps the file and reads
+     *        its header, nothing else. There is no deserialization and no allocation; pages are read on first touch
+     *        and shared between the processes mapping the same image, so a process starts with a multi-GB map at once.
+     *        The image is a bucket index, one offset per bucket, followed by the entries grouped by bucket: a lookup
+     *        reads two adjacent offsets and scans a short contiguous run of entries, and iterating is a linear sweep.
+     *        The key and value types must be trivially copyable, as they are stored byte for byte. An image is bound
+     *        to the key and value layout and to the hasher that wrote it; a mismatch is rejected when it is opened.
+     * @param Key       Key type
+     * @param T         Value type
+     * @param Hash      Hash function type
+     * @param KeyEqual  Key comparison function type
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash     = stl::hash<Key>,
+        typename KeyEqual = stl::equal_to<Key>
+    > class mapped_unordered_map
+    {
+        static_assert(is_trivially_copyable<Key>::value && is_trivially_copyable<T>::value,
+                      "stl::mapped_unordered_map stores its keys and values byte for byte");
+
+        constexpr static uint64_t       __IMAGE_MAGIC    = 0x3150414d4d4c5453ULL;     // "STLMMAP1" read little endian
+        constexpr static uint32_t       __IMAGE_VERSION  = 1;
+        constexpr static stl::size_t    __ENTRIES_ALIGN  = 64;
+
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef stl::pair<Key, T>   value_type;
+        typedef stl::size_t         size_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef const value_type&   const_reference;
+        typedef const value_type*   const_iterator;
+        typedef const_iterator      iterator;
+
+        /// @brief Empty view, holding no image.
+        explicit mapped_unordered_map(const hasher& hash = Hash(), const key_equal& equal = KeyEqual())
+            : m_buckets(__EMPTY_BUCKETS), m_entries(nullptr), m_size(0), m_bucket_mask(0), m_hash(hash), m_key_equal(equal) { }
+
+        /**
+         * @brief Maps the image at @c path.
+         * @throws std::runtime_error if the file cannot be mapped
+         * @throws std::invalid_argument if it is not an image of this key and value layout, or was hashed differently
+         */
+        explicit mapped_unordered_map(const char* path, const hasher& hash = Hash(), const key_equal& equal = KeyEqual());
+
+        mapped_unordered_map(mapped_unordered_map&& other) noexcept
+            : mapped_unordered_map(other.m_hash, other.m_key_equal)
+        { this->swap(other); }
+
+        mapped_unordered_map& operator=(mapped_unordered_map&& other) noexcept
+        {
+            if (this != &other)
+            {
+                mapped_unordered_map temp(stl::move(other));
+                this->swap(temp);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @brief Writes the entries of @c map to @c path as an image this view type can map, whatever the map's
+         *        hash, allocator, rehash policy and inline capacity. The keys are hashed with @c hash, which the
+         *        readers must reproduce. Padding inside the entries is written as zeros, so equal maps give equal images.
+         * @throws std::runtime_error if the file cannot be written
+         */
+        template <typename H, typename E, typename A, typename P, bool S, stl::size_t N>
+        static void write(const char* path, const unordered_map<Key, T, H, E, A, P, S, N>& map, const hasher& hash = Hash());
+
+        const_iterator begin() const noexcept { return this->m_entries; }
+
+        const_iterator end() const noexcept { return this->m_entries + this->m_size; }
+
+        const_iterator cbegin() const noexcept { return this->begin(); }
+
+        const_iterator cend() const noexcept { return this->end(); }
+
+        bool empty() const noexcept { return this->m_size == 0; }
+
+        size_type size() const noexcept { return this->m_size; }
+
+        size_type bucket_count() const noexcept { return this->m_bucket_mask + 1; }
+
+        /**
+         * @brief Entry of @c key, or @c end() when it is not one of the map's keys. The bucket bounds read from the
+         *        image are clamped to the entries, so a corrupt bucket index yields misses, never a read past the mapping.
+         */
+        const_iterator find(const key_type& key) const
+        {
+            size_type bucket = static_cast<size_type>(this->m_code(key)) & this->m_bucket_mask;
+            uint64_t first = this->m_buckets[bucket];
+            uint64_t last = this->m_buckets[bucket + 1];
+
+            if (last > this->m_size)
+                last = this->m_size;
+
+            if (first > last)
+                return this->end();
+
+            const value_type* entry = this->m_entries + first;
+
+            for (; entry < this->m_entries + last; ++entry)
+                if (this->m_key_equal(entry->first, key))
+                    return entry;
+
+            return this->end();
+        }
+
+        bool contains(const key_type& key) const { return this->find(key) != this->end(); }
+
+        size_type count(const key_type& key) const { return this->contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Returns the value mapped to @c key
+         * @throws std::out_of_range if @c key is not one of the map's keys
+         */
+        const mapped_type& at(const key_type& key) const
+        {
+            const_iterator it = this->find(key);
+
+            if (it == this->end())
+                throw std::out_of_range("stl::mapped_unordered_map::at: key not found");
+
+            return it->second;
+        }
+
+        hasher hash_function() const { return this->m_hash; }
+
+        key_equal key_eq() const { return this->m_key_equal; }
+
+        void swap(mapped_unordered_map& other) noexcept
+        {
+            this->m_file.swap(other.m_file);
+            stl::swap(this->m_buckets, other.m_buckets);
+            stl::swap(this->m_entries, other.m_entries);
+            stl::swap(this->m_size, other.m_size);
+            stl::swap(this->m_bucket_mask, other.m_bucket_mask);
+            stl::swap(this->m_hash, other.m_hash);
+            stl::swap(this->m_key_equal, other.m_key_equal);
+        }
+
+    private:
+        // the single empty bucket of a view without an image
+        constexpr static uint64_t __EMPTY_BUCKETS[2] = {0, 0};
+
+        __detail::__mapped_file     m_file;
+        const uint64_t*             m_buckets;      // inside m_file: bucket b holds entries [m_buckets[b], m_buckets[b + 1])
+        const value_type*           m_entries;      // inside m_file, grouped by bucket
+        size_type                   m_size;
+        size_type                   m_bucket_mask;  // bucket count - 1
+        hasher                      m_hash;
+        key_equal                   m_key_equal;
+
+        mapped_unordered_map(const mapped_unordered_map&) = delete;
+        mapped_unordered_map& operator=(const mapped_unordered_map&) = delete;
+
+        /// @brief Code of a key: its hash through the fmix64 finalizer, so identity hashes spread over the buckets too.
+        static uint64_t m_code(const hasher& hash, const key_type& key)
+        { return __detail::__hash_mix(hash(key)); }
+
+        uint64_t m_code(const key_type& key) const
+        { return m_code(this->m_hash, key); }
+
+        static size_type m_round_up(size_type offset, size_type align) noexcept
+        { return (offset + align - 1) / align * align; }
+    };
+}
+
+#include "mapped_unordered_map.tcc"
@@ -0,0 +1,135 @@
+namespace stl
+{
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    mapped_unordered_map<Key, T, Hash, KeyEqual>::mapped_unordered_map(const char* path, const hasher& hash, const key_equal& equal)
+        : mapped_unordered_map(hash, equal)
+    {
+        __detail::__mapped_file file(path);
+
+        const unsigned char* image = file.data();
+        __detail::__map_image_header header;
+
+        if (file.size() < sizeof(header))
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: not a map image: ") + path);
+
+        std::memcpy(&header, image, sizeof(header));
+
+        if (header.m_magic != __IMAGE_MAGIC || header.m_version != __IMAGE_VERSION)
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: not a map image: ") + path);
+
+        if (header.m_key_size != sizeof(key_type) || header.m_entry_size != sizeof(value_type) || header.m_entry_align != alignof(value_type))
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: image of another key or value type: ") + path);
+
+        // every section must lie inside the file, so that no lookup reads past the mapping
+        const uint64_t buckets = header.m_bucket_count;
+
+        if (buckets == 0 || (buckets & (buckets - 1)) != 0 ||
+            header.m_buckets_offset % alignof(uint64_t) != 0 || header.m_buckets_offset > file.size() ||
+            (file.size() - header.m_buckets_offset) / sizeof(uint64_t) < buckets + 1 ||
+            header.m_entries_offset % alignof(value_type) != 0 || header.m_entries_offset > file.size() ||
+            (file.size() - header.m_entries_offset) / sizeof(value_type) < header.m_size)
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: truncated or corrupt map image: ") + path);
+
+        const uint64_t* bucket_index = reinterpret_cast<const uint64_t*>(image + header.m_buckets_offset);
+        const value_type* entries = reinterpret_cast<const value_type*>(image + header.m_entries_offset);
+
+        // the bucket bounds are only checked at the ends, so that opening reads no more than the header and the ends;
+        // find clamps the offsets in between
+        if (bucket_index[0] != 0 || bucket_index[buckets] != header.m_size)
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: truncated or corrupt map image: ") + path);
+
+        if (header.m_size != 0 && m_code(hash, entries[0].first) != header.m_first_code)
+            throw std::invalid_argument(std::string("stl::mapped_unordered_map: image written with another hasher: ") + path);
+
+        this->m_file.swap(file);
+        this->m_buckets = bucket_index;
+        this->m_entries = entries;
+        this->m_size = static_cast<size_type>(header.m_size);
+        this->m_bucket_mask = static_cast<size_type>(buckets - 1);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    template <typename H, typename E, typename A, typename P, bool S, stl::size_t N>
+    void mapped_unordered_map<Key, T, Hash, KeyEqual>::write(const char* path, const unordered_map<Key, T, H, E, A, P, S, N>& map, const hasher& hash)
+    {
+        const size_type n = map.size();
+
+        // about one entry per bucket: a lookup reads one short run
+        size_type buckets = 1;
+        while (buckets < n)
+            buckets *= 2;
+
+        // the scratch tables are only read through their data, where every index is in range by construction; the entries
+        // are laid out as zeroed bytes, so their padding is written as zeros and equal maps give equal images
+        stl::vector<uint64_t> code_table(n, 0);
+        stl::vector<uint64_t> bucket_table(buckets + 1, 0);
+        stl::vector<unsigned char> entry_table(n * sizeof(value_type), 0);
+
+        uint64_t* codes = code_table.data();
+        uint64_t* bucket_index = bucket_table.data();
+        unsigned char* entries = entry_table.data();
+        uint64_t first_code = 0;
+
+        size_type i = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it, ++i)
+        {
+            codes[i] = m_code(hash, it->first);
+            ++bucket_index[(codes[i] & (buckets - 1)) + 1];
+        }
+
+        for (size_type b = 0; b < buckets; ++b)
+            bucket_index[b + 1] += bucket_index[b];
+
+        // each bucket's start serves as its cursor, which leaves it on the next bucket's start: shifted back after
+        // each entry is built on a zeroed slot of its own, then copied into place byte for byte (the types are trivially
+        // copyable), so neither Key nor T has to be default constructible
+        i = 0;
+        for (auto it = map.cbegin(); it != map.cend(); ++it, ++i)
+        {
+            size_type slot = static_cast<size_type>(bucket_index[codes[i] & (buckets - 1)]++);
+
+            alignas(value_type) unsigned char entry[sizeof(value_type)] = {};
+            ::new (static_cast<void*>(entry)) value_type(it->first, it->second);
+
+            std::memcpy(entries + slot * sizeof(value_type), entry, sizeof(value_type));
+
+            if (slot == 0)
+                first_code = codes[i];
+        }
+
+        for (size_type b = buckets; b > 0; --b)
+            bucket_index[b] = bucket_index[b - 1];
+
+        bucket_index[0] = 0;
+
+        __detail::__map_image_header header;
+        std::memset(&header, 0, sizeof(header));
+
+        header.m_magic = __IMAGE_MAGIC;
+        header.m_version = __IMAGE_VERSION;
+        header.m_key_size = sizeof(key_type);
+        header.m_entry_size = sizeof(value_type);
+        header.m_entry_align = alignof(value_type);
+        header.m_size = n;
+        header.m_bucket_count = buckets;
+        header.m_buckets_offset = sizeof(header);
+        header.m_entries_offset = m_round_up(sizeof(header) + (buckets + 1) * sizeof(uint64_t), __ENTRIES_ALIGN);
+        header.m_first_code = first_code;
+
+        std::FILE* file = std::fopen(path, "wb");
+
+        if (file == nullptr)
+            throw std::runtime_error(std::string("stl::mapped_unordered_map::write: cannot open ") + path);
+
+        const unsigned char padding[__ENTRIES_ALIGN] = {};
+        const size_type gap = header.m_entries_offset - header.m_buckets_offset - (buckets + 1) * sizeof(uint64_t);
+
+        bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       std::fwrite(bucket_index, sizeof(uint64_t), buckets + 1, file) == buckets + 1 &&
+                       std::fwrite(padding, 1, gap, file) == gap &&
+                       (n == 0 || std::fwrite(entries, sizeof(value_type), n, file) == n);
+
+        if (std::fclose(file) != 0 || !written)
+            throw std::runtime_error(std::string("stl::mapped_unordered_map::write: cannot write ") + path);
+    }
+}
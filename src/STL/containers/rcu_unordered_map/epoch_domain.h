@@ -0,0 +1,124 @@
+#pragma once
+
+#include "../../traits/type_traits.h"
+
+#include <atomic>
+#include <cstdint>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief Small per-thread number, handed out once per thread, that spreads the readers over the epoch slots.
+        inline size_t __thread_slot() noexcept
+        {
+            static std::atomic<size_t> next(0);
+            thread_local size_t slot = next.fetch_add(1, std::memory_order_relaxed);
+
+            return slot;
+        }
+
+        /**
+         * @brief Epoch based reclamation (Fraser) for structures read without locks and written by one writer at a time.
+         *        A reader announces the global epoch in its slot for as long as it holds pointers into the structure;
+         *        the writer advances the epoch only once every announced epoch has caught up with it. Memory unlinked
+         *        while the epoch was @c e is unreachable to every reader once the epoch reaches @c e + 2.
+         *        Each slot word packs the announced epoch above a count of the readers inside, so the threads past
+         *        @c __SLOTS share slots: a slot keeps the epoch of its oldest reader, which only delays reclamation.
+         */
+        class __epoch_domain
+        {
+            constexpr static size_t     __SLOTS      = 64;
+            constexpr static size_t     __CACHE_LINE = 64;
+            constexpr static unsigned   __COUNT_BITS = 16;
+            constexpr static uint64_t   __COUNT_MASK = (static_cast<uint64_t>(1) << __COUNT_BITS) - 1;
+
+        public:
+            __epoch_domain() noexcept
+                : m_epoch(1) { }
+
+            /// @brief Enters a read-side critical section; returns the slot to leave it through.
+            size_t enter() const noexcept
+            {
+                size_t index = __thread_slot() & (__SLOTS - 1);
+                std::atomic<uint64_t>& word = this->m_slots[index].m_word;
+                uint64_t current = word.load(std::memory_order_relaxed);
+
+                // the first reader in a slot announces the epoch, the others join it; the full barrier of the exchange
+                // orders the announcement before every pointer the reader goes on to load
+                for (;;)
+                {
+                    uint64_t desired = (current & __COUNT_MASK) == 0
+                        ? (this->m_epoch.load(std::memory_order_seq_cst) << __COUNT_BITS) | 1
+                        : current + 1;
+
+                    if (word.compare_exchange_weak(current, desired, std::memory_order_seq_cst, std::memory_order_relaxed))
+                        return index;
+                }
+            }
+
+            void leave(size_t index) const noexcept
+            { this->m_slots[index].m_word.fetch_sub(1, std::memory_order_release); }
+
+            uint64_t epoch() const noexcept
+            { return this->m_epoch.load(std::memory_order_relaxed); }
+
+            /// @brief Writer side: advances the epoch unless a reader still announces an older one. @return true if advanced
+            bool try_advance() noexcept
+            {
+                // the writer's unlinking stores come before the scan of the readers' announcements
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+
+                uint64_t epoch = this->m_epoch.load(std::memory_order_relaxed);
+
+                for (size_t i = 0; i < __SLOTS; ++i)
+                {
+                    uint64_t word = this->m_slots[i].m_word.load(std::memory_order_acquire);
+
+                    if ((word & __COUNT_MASK) != 0 && (word >> __COUNT_BITS) != epoch)
+                        return false;
+                }
+
+                this->m_epoch.store(epoch + 1, std::memory_order_seq_cst);
+                return true;
+            }
+
+            /// @brief True once nothing unlinked while the epoch was @c retired can be held by a reader any more.
+            bool reclaimable(uint64_t retired) const noexcept
+            { return retired + 2 <= this->epoch(); }
+
+        private:
+            // one cache line per slot, so readers on different slots never invalidate each other's announcements
+            struct alignas(__CACHE_LINE) slot
+            {
+                std::atomic<uint64_t> m_word;
+
+                slot() noexcept
+                    : m_word(0) { }
+            };
+
+            alignas(__CACHE_LINE) std::atomic<uint64_t> m_epoch;
+            mutable slot                                m_slots[__SLOTS];
+
+            __epoch_domain(const __epoch_domain&) = delete;
+            __epoch_domain& operator=(const __epoch_domain&) = delete;
+        };
+
+        /// @brief Read-side critical section for the lifetime of the guard.
+        class __epoch_guard
+        {
+        public:
+            explicit __epoch_guard(const __epoch_domain& domain) noexcept
+                : m_domain(domain), m_slot(domain.enter()) { }
+
+            ~__epoch_guard() { this->m_domain.leave(this->m_slot); }
+
+        private:
+            const __epoch_domain&   m_domain;
+            size_t                  m_slot;
+
+            __epoch_guard(const __epoch_guard&) = delete;
+            __epoch_guard& operator=(const __epoch_guard&) = delete;
+        };
+    }
+}
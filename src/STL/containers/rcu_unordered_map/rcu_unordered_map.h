@@ -0,0 +1,218 @@
+#pragma once
+
+#include "epoch_domain.h"
+#include "../vector/vector.h"
+#include "../../allocator/allocator.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+#include "../../../cUtility/hashable.h"
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <optional>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief Node of a @c rcu_unordered_map: the entry and its chain link as in @c stl::pair_node, the link atomic so
+         *        readers can follow it while the writer relinks. A published node is never modified: an update replaces it.
+         */
+        template <typename Key, typename T>
+        struct __rcu_node
+        {
+            pair<Key, T>                    m_pair;
+            size_t                          m_hash_code;
+            std::atomic<__rcu_node*>        m_next;
+
+            template <typename K, typename... Args>
+            __rcu_node(size_t code, K&& key, Args&&... args)
+                : m_pair(__emplace_second_t(), stl::forward<K>(key), stl::forward<Args>(args)...), m_hash_code(code), m_next(nullptr) { }
+        };
+
+        /// @brief Bucket array of a @c rcu_unordered_map, published as a whole: the bucket heads follow it in the same block.
+        template <typename Key, typename T>
+        struct __rcu_table
+        {
+            size_t m_bucket_count;
+
+            std::atomic<__rcu_node<Key, T>*>* buckets() noexcept
+            { return reinterpret_cast<std::atomic<__rcu_node<Key, T>*>*>(this + 1); }
+        };
+    }
+
+    /**
+     * @brief Hash map for read-mostly data (configuration, routing tables) read on every request and updated rarely.
+     *        Readers take no lock and write no shared cache line: they announce themselves in an epoch slot of their own,
+     *        load the bucket array and follow the chains with acquire loads only. Writers are serialized by a mutex and
+     *        never block readers: a new node is fully built before a release store publishes it, an update or erase
+     *        swaps one link, and growing the table publishes a new bucket array of copied nodes. Whatever a writer
+     *        unlinks goes to an epoch based reclaimer and is freed once no reader can still reach it.
+     *        Values are never handed out by reference: lookups return a copy or run a visitor inside the read section.
+     * @param Key           Key type
+     * @param T             Value type
+     * @param Hash          Hash function type
+     * @param KeyEqual      Key comparison function type
+     * @param Allocator     Node allocator, rebound to the map's node type
+     */
+    template <
+        typename Key,
+        typename T,
+        typename Hash         = stl::hash<Key>,
+        typename KeyEqual     = stl::equal_to<Key>,
+        typename Allocator    = stl::allocator<stl::pair_node<Key, T>>
+    > class rcu_unordered_map
+    {
+        constexpr static unsigned short   __DEFAULT_BUCKET_SIZE = 16;
+        constexpr static float            __DEFAULT_LOAD_FACTOR = .75;
+
+        typedef __detail::__rcu_node<Key, T>                                node;
+        typedef __detail::__rcu_table<Key, T>                               table;
+        typedef typename Allocator::template rebind<node>::other            node_allocator;
+
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef stl::size_t         size_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef Allocator           allocator_type;
+
+        explicit rcu_unordered_map(size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(),
+                                   const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator());
+
+        /// @brief Frees every node and table; no reader may be inside the map any more.
+        ~rcu_unordered_map();
+
+        // Read side: lock-free, callable from any number of threads concurrently with a writer.
+
+        /// @return a copy of the value stored under @c key
+        std::optional<mapped_type> find(const key_type& key) const;
+
+        bool contains(const key_type& key) const
+        { return this->cvisit(key, [](const mapped_type&) { }); }
+
+        /// @brief Calls @c f(const mapped_type&) on the value under @c key inside a read section. @return false if absent
+        template <typename F>
+        bool cvisit(const key_type& key, F&& f) const;
+
+        /**
+         * @brief Calls @c f(const key_type&, const mapped_type&) on every entry of the bucket array current when it starts;
+         *        entries inserted or erased meanwhile may or may not be visited.
+         */
+        template <typename F>
+        void cvisit_all(F&& f) const;
+
+        /// @brief Exact only without a concurrent writer.
+        size_type size() const noexcept { return this->m_size.load(std::memory_order_relaxed); }
+
+        bool empty() const noexcept { return this->size() == 0; }
+
+        size_type bucket_count() const noexcept
+        { return this->m_table.load(std::memory_order_acquire)->m_bucket_count; }
+
+        // Write side: serialized among writers, never waiting for readers.
+
+        /// @brief Inserts @c value under @c key unless the key is present. @return true if it was inserted
+        template <typename M>
+        bool insert(const key_type& key, M&& value);
+
+        /// @brief Inserts @c value under @c key, or publishes a new node replacing the current one. @return true if it was inserted
+        template <typename M>
+        bool insert_or_assign(const key_type& key, M&& value);
+
+        size_type erase(const key_type& key);
+
+        /// @brief Publishes an empty bucket array of the same size; the old entries are reclaimed once the readers are done.
+        void clear();
+
+        /// @brief Publishes a bucket array for @c count entries, copying every node into it if it has to grow.
+        void reserve(size_type count);
+
+        /// @brief Frees what the readers have let go of; every write does this on its way out.
+        void reclaim();
+
+        /// @brief Nodes and tables unlinked but not yet freed, because a reader may still hold them.
+        size_type retired() const
+        {
+            std::lock_guard<std::mutex> lock(this->m_writer);
+            return this->m_retired.size();
+        }
+
+    private:
+        /// @brief An unlinked node, or a replaced bucket array together with the chains it still holds.
+        struct retired_item
+        {
+            void*       m_ptr;
+            uint64_t    m_epoch;    // epoch when it was unlinked
+            bool        m_table;
+        };
+
+        std::atomic<table*>             m_table;
+        std::atomic<size_type>          m_size;
+        __detail::__epoch_domain        m_domain;
+        mutable std::mutex              m_writer;
+        stl::vector<retired_item>       m_retired;     // in unlink order, so in epoch order
+        float                           m_load_factor;
+        hasher                          m_hash;
+        key_equal                       m_key_equal;
+        node_allocator                  m_alloc;
+
+        rcu_unordered_map(const rcu_unordered_map&) = delete;
+        rcu_unordered_map& operator=(const rcu_unordered_map&) = delete;
+
+        static size_type m_bucket(size_type code, const table* t) noexcept
+        { return power2_rehash_policy::bucket_index(code, t->m_bucket_count); }
+
+        /// @brief Reader lookup, inside a read section.
+        const node* m_find_node(const key_type& key) const;
+
+        /// @brief Writer lookup: the link (bucket head or @c m_next) holding @c key's node, or the null link ending its chain.
+        std::atomic<node*>* m_locate(table* t, const key_type& key, size_type code) const;
+
+        /// @brief Links a new node for @c key, known to be absent, growing the table first if needed; writer lock held.
+        template <typename M>
+        void m_insert_new(size_type code, const key_type& key, M&& value);
+
+        template <typename K, typename... Args>
+        node* m_get_node(size_type code, K&& key, Args&&... args);
+
+        void m_free_node(node* n)
+        {
+            n->~node();
+            this->m_alloc.deallocate(n, 1);
+        }
+
+        /// @brief Empty bucket array of @c bucket_count buckets, a power of two.
+        static table* m_get_table(size_type bucket_count);
+
+        static void m_free_table(table* t) noexcept;
+
+        /// @brief Frees @c t together with every node still chained from it.
+        void m_free_table_nodes(table* t) noexcept;
+
+        /// @brief Publishes a copy of the current entries in @c bucket_count buckets and retires the old table with its nodes.
+        void m_rebuild(size_type bucket_count);
+
+        /// @brief Grows the table ahead of one more insert.
+        void m_check_rehash()
+        {
+            table* t = this->m_table.load(std::memory_order_relaxed);
+
+            if (static_cast<float>(this->m_size.load(std::memory_order_relaxed) + 1) / t->m_bucket_count > this->m_load_factor)
+                this->m_rebuild(t->m_bucket_count * 2);
+        }
+
+        void m_retire(void* ptr, bool is_table)
+        { this->m_retired.push_back(retired_item{ptr, this->m_domain.epoch(), is_table}); }
+
+        /// @brief @c reclaim with the writer lock already held.
+        void m_reclaim();
+    };
+}
+
+#include "rcu_unordered_map.tcc"
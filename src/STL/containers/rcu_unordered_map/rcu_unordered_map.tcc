@@ -0,0 +1,349 @@
+namespace stl
+{
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::rcu_unordered_map(size_type bucket_count, const hasher& hash,
+        const key_equal& equal, const allocator_type& alloc)
+        : m_table(nullptr), m_size(0), m_domain(), m_writer(), m_retired(), m_load_factor(__DEFAULT_LOAD_FACTOR),
+          m_hash(hash), m_key_equal(equal), m_alloc(alloc)
+    {
+        this->m_table.store(m_get_table(power2_rehash_policy::next_bucket_count(bucket_count == 0 ? 1 : bucket_count)), std::memory_order_release);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::~rcu_unordered_map()
+    {
+        this->m_free_table_nodes(this->m_table.load(std::memory_order_relaxed));
+
+        for (size_type i = 0; i < this->m_retired.size(); ++i)
+        {
+            const retired_item& item = this->m_retired.data()[i];
+
+            if (item.m_table)
+                this->m_free_table_nodes(static_cast<table*>(item.m_ptr));
+            else
+                this->m_free_node(static_cast<node*>(item.m_ptr));
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    std::optional<typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::mapped_type>
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::find(const key_type& key) const
+    {
+        __detail::__epoch_guard guard(this->m_domain);
+
+        const node* n = this->m_find_node(key);
+
+        if (n == nullptr)
+            return std::nullopt;
+
+        return n->m_pair.second;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename F>
+    bool rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::cvisit(const key_type& key, F&& f) const
+    {
+        __detail::__epoch_guard guard(this->m_domain);
+
+        const node* n = this->m_find_node(key);
+
+        if (n == nullptr)
+            return false;
+
+        f(n->m_pair.second);
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename F>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::cvisit_all(F&& f) const
+    {
+        __detail::__epoch_guard guard(this->m_domain);
+
+        table* t = this->m_table.load(std::memory_order_acquire);
+        std::atomic<node*>* buckets = t->buckets();
+
+        for (size_type b = 0; b < t->m_bucket_count; ++b)
+            for (const node* n = buckets[b].load(std::memory_order_acquire); n != nullptr; n = n->m_next.load(std::memory_order_acquire))
+                f(n->m_pair.first, n->m_pair.second);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename M>
+    bool rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(const key_type& key, M&& value)
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        size_type code = this->m_hash(key);
+        table* t = this->m_table.load(std::memory_order_relaxed);
+
+        if (this->m_locate(t, key, code)->load(std::memory_order_relaxed) != nullptr)
+            return false;
+
+        this->m_insert_new(code, key, stl::forward<M>(value));
+
+        this->m_reclaim();
+        return true;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename M>
+    bool rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert_or_assign(const key_type& key, M&& value)
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        size_type code = this->m_hash(key);
+        std::atomic<node*>* link = this->m_locate(this->m_table.load(std::memory_order_relaxed), key, code);
+        node* old = link->load(std::memory_order_relaxed);
+
+        if (old == nullptr)
+        {
+            this->m_insert_new(code, key, stl::forward<M>(value));
+
+            this->m_reclaim();
+            return true;
+        }
+
+        // readers see either the old node or its replacement, which takes over the rest of the chain
+        node* n = this->m_get_node(code, old->m_pair.first, stl::forward<M>(value));
+
+        n->m_next.store(old->m_next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        link->store(n, std::memory_order_release);
+        this->m_retire(old, false);
+
+        this->m_reclaim();
+        return false;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(const key_type& key)
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        std::atomic<node*>* link = this->m_locate(this->m_table.load(std::memory_order_relaxed), key, this->m_hash(key));
+        node* old = link->load(std::memory_order_relaxed);
+
+        if (old == nullptr)
+            return 0;
+
+        // a reader standing on the erased node still finds the rest of the chain through its unchanged link
+        link->store(old->m_next.load(std::memory_order_relaxed), std::memory_order_release);
+        this->m_size.fetch_sub(1, std::memory_order_relaxed);
+        this->m_retire(old, false);
+
+        this->m_reclaim();
+        return 1;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::clear()
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        table* old = this->m_table.load(std::memory_order_relaxed);
+
+        this->m_table.store(m_get_table(old->m_bucket_count), std::memory_order_release);
+        this->m_size.store(0, std::memory_order_relaxed);
+        this->m_retire(old, true);
+
+        this->m_reclaim();
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::reserve(size_type count)
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        size_type bucket_count = power2_rehash_policy::next_bucket_count(static_cast<size_type>(count / this->m_load_factor) + 1);
+
+        if (bucket_count > this->m_table.load(std::memory_order_relaxed)->m_bucket_count)
+            this->m_rebuild(bucket_count);
+
+        this->m_reclaim();
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::reclaim()
+    {
+        std::lock_guard<std::mutex> lock(this->m_writer);
+
+        // two advances make everything retired so far reclaimable, when no reader is in the way
+        this->m_domain.try_advance();
+        this->m_reclaim();
+    }
+
+    /// @c private_members
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    const typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::node*
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_find_node(const key_type& key) const
+    {
+        size_type code = this->m_hash(key);
+        table* t = this->m_table.load(std::memory_order_acquire);
+        const node* n = t->buckets()[m_bucket(code, t)].load(std::memory_order_acquire);
+
+        while (n != nullptr && !(n->m_hash_code == code && this->m_key_equal(n->m_pair.first, key)))
+            n = n->m_next.load(std::memory_order_acquire);
+
+        return n;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    std::atomic<typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::node*>*
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_locate(table* t, const key_type& key, size_type code) const
+    {
+        // only the writer relinks, so its own loads need no ordering
+        std::atomic<node*>* link = t->buckets() + m_bucket(code, t);
+        node* n = link->load(std::memory_order_relaxed);
+
+        while (n != nullptr && !(n->m_hash_code == code && this->m_key_equal(n->m_pair.first, key)))
+        {
+            link = &n->m_next;
+            n = link->load(std::memory_order_relaxed);
+        }
+
+        return link;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename M>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_insert_new(size_type code, const key_type& key, M&& value)
+    {
+        this->m_check_rehash();
+
+        // the node is complete, link included, before the release store makes it reachable
+        table* t = this->m_table.load(std::memory_order_relaxed);
+        std::atomic<node*>& head = t->buckets()[m_bucket(code, t)];
+        node* n = this->m_get_node(code, key, stl::forward<M>(value));
+
+        n->m_next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head.store(n, std::memory_order_release);
+        this->m_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename K, typename... Args>
+    typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::node*
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_get_node(size_type code, K&& key, Args&&... args)
+    {
+        node* __new_node = this->m_alloc.allocate(1);
+
+        try
+        {
+            new (__new_node) node(code, stl::forward<K>(key), stl::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->m_alloc.deallocate(__new_node, 1);
+            throw;
+        }
+
+        return __new_node;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    typename rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::table*
+    rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_get_table(size_type bucket_count)
+    {
+        void* block = ::operator new(sizeof(table) + bucket_count * sizeof(std::atomic<node*>));
+        table* t = ::new(block) table{bucket_count};
+
+        for (size_type b = 0; b < bucket_count; ++b)
+            ::new(static_cast<void*>(t->buckets() + b)) std::atomic<node*>(nullptr);
+
+        return t;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_free_table(table* t) noexcept
+    {
+        // the bucket heads and the table header are trivially destructible
+        ::operator delete(static_cast<void*>(t));
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_free_table_nodes(table* t) noexcept
+    {
+        std::atomic<node*>* buckets = t->buckets();
+
+        for (size_type b = 0; b < t->m_bucket_count; ++b)
+        {
+            node* n = buckets[b].load(std::memory_order_relaxed);
+
+            while (n != nullptr)
+            {
+                node* next = n->m_next.load(std::memory_order_relaxed);
+                this->m_free_node(n);
+                n = next;
+            }
+        }
+
+        m_free_table(t);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_rebuild(size_type bucket_count)
+    {
+        // readers may be walking the old chains, so they are left intact: the new table gets copies of the nodes
+        table* old = this->m_table.load(std::memory_order_relaxed);
+        table* t = m_get_table(bucket_count);
+        std::atomic<node*>* old_buckets = old->buckets();
+        std::atomic<node*>* buckets = t->buckets();
+
+        try
+        {
+            for (size_type b = 0; b < old->m_bucket_count; ++b)
+            {
+                for (node* n = old_buckets[b].load(std::memory_order_relaxed); n != nullptr; n = n->m_next.load(std::memory_order_relaxed))
+                {
+                    std::atomic<node*>& head = buckets[m_bucket(n->m_hash_code, t)];
+                    node* copy = this->m_get_node(n->m_hash_code, n->m_pair.first, n->m_pair.second);
+
+                    copy->m_next.store(head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    head.store(copy, std::memory_order_relaxed);
+                }
+            }
+        }
+        catch (...)
+        {
+            this->m_free_table_nodes(t);
+            throw;
+        }
+
+        // the release store publishes the table together with every node linked into it
+        this->m_table.store(t, std::memory_order_release);
+        this->m_retire(old, true);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    void rcu_unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_reclaim()
+    {
+        if (this->m_retired.empty())
+            return;
+
+        this->m_domain.try_advance();
+
+        // retired in epoch order: the reclaimable items are a prefix
+        retired_item* items = this->m_retired.data();
+        size_type count = this->m_retired.size();
+        size_type freed = 0;
+
+        for (; freed < count && this->m_domain.reclaimable(items[freed].m_epoch); ++freed)
+        {
+            if (items[freed].m_table)
+                this->m_free_table_nodes(static_cast<table*>(items[freed].m_ptr));
+            else
+                this->m_free_node(static_cast<node*>(items[freed].m_ptr));
+        }
+
+        if (freed == 0)
+            return;
+
+        for (size_type i = freed; i < count; ++i)
+            items[i - freed] = items[i];
+
+        for (size_type i = 0; i < freed; ++i)
+            this->m_retired.pop_back();
+    }
+}
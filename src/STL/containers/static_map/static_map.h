@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../array/array.h"
+#include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../../../cUtility/stl_pair.h"
+#include "../../../cUtility/stl_function.h"
+
+#include <stdexcept>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief Slots of a @c static_map holding @c n keys: the next power of two, so the load stays above one half.
+        inline constexpr size_t __static_map_slots(size_t n) noexcept
+        {
+            size_t slots = 1;
+            while (slots < n)
+                slots <<= 1;
+            return slots;
+        }
+
+        inline constexpr unsigned __static_map_log2(size_t slots) noexcept
+        {
+            unsigned bits = 0;
+            while ((static_cast<size_t>(1) << bits) < slots)
+                ++bits;
+            return bits;
+        }
+    }
+
+    /**
+     * @brief Immutable map over @c N keys known up front, laid out by a perfect hash (hash and displace): every key's
+     *        first-level bucket stores a seed that sends the bucket's keys to distinct slots, found while the map is
+     *        built. Built in a @c constexpr context, with @c constexpr hashes such as those of integers and strings,
+     *        the whole table is computed at compile time and a lookup is one mix, one multiply, three loads and one key
+     *        comparison. Integer literal lookups fold to a constant; string literals do in constant expressions
+     *        (@c constexpr @c int @c op @c = @c opcodes.at("store")), elsewhere they are hashed by @c hash_bytes at run time.
+     * @param Key       Key type, a literal type to be built at compile time
+     * @param T         Value type, a literal type to be built at compile time
+     * @param N         Number of keys
+     * @param Hash      Hash function type, @c constexpr to be built at compile time
+     * @param KeyEqual  Key comparison function type
+     */
+    template <
+        typename Key,
+        typename T,
+        stl::size_t N,
+        typename Hash     = stl::hash<Key>,
+        typename KeyEqual = stl::equal_to<Key>
+    > class static_map
+    {
+        static_assert(N > 0, "stl::static_map needs at least one key");
+
+        constexpr static stl::size_t __SLOTS           = __detail::__static_map_slots(N);
+        constexpr static unsigned    __SLOT_SHIFT      = 64 - __detail::__static_map_log2(__SLOTS);
+        constexpr static stl::size_t __MAX_SEED_TRIES  = 1 << 20;     // per bucket, before the build gives up
+
+    public:
+        typedef Key                 key_type;
+        typedef T                   mapped_type;
+        typedef stl::pair<Key, T>   value_type;
+        typedef stl::size_t         size_type;
+        typedef Hash                hasher;
+        typedef KeyEqual            key_equal;
+        typedef const value_type&   const_reference;
+        typedef const value_type*   const_iterator;
+        typedef const_iterator      iterator;
+
+        /**
+         * @brief Builds the table over @c items, in a constant expression when used to initialize a @c constexpr variable.
+         * @throws std::invalid_argument on duplicate keys or keys with equal full hashes (a compile error when @c constexpr)
+         */
+        constexpr explicit static_map(const value_type (&items)[N], const hasher& hash = Hash(), const key_equal& equal = KeyEqual());
+
+        constexpr const_iterator begin() const noexcept { return this->m_items.cbegin(); }
+
+        constexpr const_iterator end() const noexcept { return this->m_items.cend(); }
+
+        constexpr const_iterator cbegin() const noexcept { return this->m_items.cbegin(); }
+
+        constexpr const_iterator cend() const noexcept { return this->m_items.cend(); }
+
+        constexpr bool empty() const noexcept { return false; }
+
+        constexpr size_type size() const noexcept { return N; }
+
+        constexpr size_type bucket_count() const noexcept { return __SLOTS; }
+
+        /// @brief Entry of @c key, or @c end() when it is not one of the map's keys.
+        constexpr const_iterator find(const key_type& key) const;
+
+        constexpr bool contains(const key_type& key) const { return this->find(key) != this->end(); }
+
+        constexpr size_type count(const key_type& key) const { return this->contains(key) ? 1 : 0; }
+
+        /**
+         * @brief Returns the value mapped to @c key
+         * @throws std::out_of_range if @c key is not one of the map's keys
+         */
+        constexpr const mapped_type& at(const key_type& key) const;
+
+        hasher hash_function() const { return this->m_hash; }
+
+        key_equal key_eq() const { return this->m_key_equal; }
+
+    private:
+        /// @brief First-level code of a key: its hash through the fmix64 finalizer, so identity hashes spread over the buckets too.
+        constexpr uint64_t m_code(const key_type& key) const
+        { return __detail::__hash_mix(this->m_hash(key)); }
+
+        constexpr static size_type m_bucket(uint64_t code) noexcept
+        { return static_cast<size_type>(code & (__SLOTS - 1)); }
+
+        /// @brief Second level: the seeded code through one multiply, top bits kept (Fibonacci hashing).
+        constexpr static size_type m_slot(uint64_t code, uint64_t seed) noexcept
+        { return __SLOTS == 1 ? 0 : static_cast<size_type>(((code ^ seed) * 0x9e3779b97f4a7c15ULL) >> __SLOT_SHIFT); }
+
+        stl::array<value_type, N>           m_items;
+        stl::array<uint64_t, __SLOTS>       m_seeds;      // displacement seed of each first-level bucket
+        stl::array<size_type, __SLOTS>      m_index;      // item held by each slot, N when the slot is empty
+        hasher                              m_hash;
+        key_equal                           m_key_equal;
+    };
+
+    /**
+     * @brief Builds a @c static_map, deducing @c N from a braced list:
+     *        @code constexpr auto opcodes = stl::make_static_map<std::string_view, int>({ {"add", 1}, {"sub", 2} }); @endcode
+     */
+    template <typename Key, typename T, typename Hash = stl::hash<Key>, typename KeyEqual = stl::equal_to<Key>, stl::size_t N>
+    inline constexpr static_map<Key, T, N, Hash, KeyEqual> make_static_map(const stl::pair<Key, T> (&items)[N])
+    { return static_map<Key, T, N, Hash, KeyEqual>(items); }
+}
+
+#include "static_map.tcc"
@@ -0,0 +1,102 @@
+namespace stl
+{
+    template <typename Key, typename T, stl::size_t N, typename Hash, typename KeyEqual>
+    constexpr static_map<Key, T, N, Hash, KeyEqual>::static_map(const value_type (&items)[N], const hasher& hash, const key_equal& equal)
+        : m_items(), m_seeds(), m_index(), m_hash(hash), m_key_equal(equal)
+    {
+        uint64_t   codes[N] = { };
+        size_type  bucket_sizes[__SLOTS] = { };
+        size_type  members[N] = { };
+        size_type  slots[N] = { };
+        bool       used[__SLOTS] = { };
+        size_type  largest = 0;
+
+        for (size_type i = 0; i < N; ++i)
+        {
+            this->m_items[i] = items[i];
+            codes[i] = this->m_code(items[i].first);
+
+            size_type& bucket_size = bucket_sizes[m_bucket(codes[i])];
+            if (++bucket_size > largest)
+                largest = bucket_size;
+        }
+
+        this->m_index.fill(N);
+
+        // largest buckets first, while most slots are still free
+        for (size_type size = largest; size > 0; --size)
+            for (size_type bucket = 0; bucket < __SLOTS; ++bucket)
+            {
+                if (bucket_sizes[bucket] != size)
+                    continue;
+
+                size_type count = 0;
+                for (size_type i = 0; i < N; ++i)
+                    if (m_bucket(codes[i]) == bucket)
+                    {
+                        for (size_type j = 0; j < count; ++j)
+                            if (codes[members[j]] == codes[i])
+                                throw std::invalid_argument(this->m_key_equal(items[members[j]].first, items[i].first)
+                                                            ? "stl::static_map: duplicate key"
+                                                            : "stl::static_map: keys with equal hashes");
+                        members[count++] = i;
+                    }
+
+                uint64_t seed = 0;
+
+                for (;; ++seed)
+                {
+                    if (seed == __MAX_SEED_TRIES)
+                        throw std::invalid_argument("stl::static_map: no perfect hash found");
+
+                    bool placed = true;
+
+                    for (size_type j = 0; j < count && placed; ++j)
+                    {
+                        slots[j] = m_slot(codes[members[j]], seed);
+                        placed = !used[slots[j]];
+
+                        for (size_type k = 0; k < j && placed; ++k)
+                            placed = slots[k] != slots[j];
+                    }
+
+                    if (placed)
+                        break;
+                }
+
+                this->m_seeds[bucket] = seed;
+
+                for (size_type j = 0; j < count; ++j)
+                {
+                    used[slots[j]] = true;
+                    this->m_index[slots[j]] = members[j];
+                }
+            }
+    }
+
+    template <typename Key, typename T, stl::size_t N, typename Hash, typename KeyEqual>
+    constexpr typename static_map<Key, T, N, Hash, KeyEqual>::const_iterator
+    static_map<Key, T, N, Hash, KeyEqual>::find(const key_type& key) const
+    {
+        // every index is in range by construction, so the tables are read through their data, without operator[]'s check
+        uint64_t code = this->m_code(key);
+        size_type index = this->m_index.data()[m_slot(code, this->m_seeds.data()[m_bucket(code)])];
+
+        if (index != N && this->m_key_equal(this->m_items.data()[index].first, key))
+            return this->m_items.cbegin() + index;
+
+        return this->end();
+    }
+
+    template <typename Key, typename T, stl::size_t N, typename Hash, typename KeyEqual>
+    constexpr const typename static_map<Key, T, N, Hash, KeyEqual>::mapped_type&
+    static_map<Key, T, N, Hash, KeyEqual>::at(const key_type& key) const
+    {
+        const_iterator it = this->find(key);
+
+        if (it == this->end())
+            throw std::out_of_range("stl::static_map::at: key not found");
+
+        return it->second;
+    }
+}
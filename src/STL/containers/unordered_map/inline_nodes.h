@@ -0,0 +1,195 @@
+#pragma once
+
+#include "../../traits/type_traits.h"
+#include "../../../cUtility/hashable.h"
+#include "../../../cUtility/stl_function.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define __INLINE_NODES_SSE2__ 1
+#else
+    #define __INLINE_NODES_SSE2__ 0
+#endif
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief Keys an inline map scans as one block instead of walking its chain: integers, enums and pointers of 4 or
+         *        8 bytes compared by @c stl::equal_to, whose equality is the equality of their bytes.
+         */
+        template <typename Key, typename KeyEqual>
+        struct __inline_key_scan
+            : public bool_constant<(is_integral<Key>::value || is_enum<Key>::value || is_pointer<Key>::value) &&
+                                   (sizeof(Key) == 4 || sizeof(Key) == 8) &&
+                                   (is_same<KeyEqual, stl::equal_to<Key>>::value || is_same<KeyEqual, stl::equal_to<void>>::value)> { };
+
+        /// @brief Copy of the keys of the inline nodes, slot by slot, padded to whole 16-byte vectors; empty when not scanned.
+        template <typename Key, size_t N, bool Scan>
+        struct __inline_key_block
+        {
+            constexpr static size_t __LANES = 16 / sizeof(Key);
+            constexpr static size_t __SLOTS = (N + __LANES - 1) / __LANES * __LANES;
+
+            alignas(16) Key m_inline_keys[__SLOTS];
+
+            // the lanes of free slots are compared too, so they hold a defined value
+            __inline_key_block() noexcept
+                : m_inline_keys() { }
+
+            void store_key(size_t slot, const Key& key) noexcept { this->m_inline_keys[slot] = key; }
+
+            /// @brief Bit @c i is set when slot @c i holds @c key; unused slots may match too and are masked by the caller.
+            uint32_t match_keys(const Key& key) const noexcept
+            { return this->match_keys(key, integral_constant<size_t, sizeof(Key)>()); }
+
+        private:
+        #if __INLINE_NODES_SSE2__
+            uint32_t match_keys(const Key& key, integral_constant<size_t, 4>) const noexcept
+            {
+                uint32_t bits;
+                std::memcpy(&bits, &key, sizeof(bits));
+
+                const __m128i needle = _mm_set1_epi32(static_cast<int>(bits));
+                uint32_t mask = 0;
+
+                for (size_t i = 0; i < __SLOTS; i += 4)
+                {
+                    __m128i lanes = _mm_load_si128(reinterpret_cast<const __m128i*>(this->m_inline_keys + i));
+                    mask |= static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lanes, needle)))) << i;
+                }
+
+                return mask;
+            }
+
+            // SSE2 has no 64-bit compare: both 32-bit halves of a lane must match
+            uint32_t match_keys(const Key& key, integral_constant<size_t, 8>) const noexcept
+            {
+                long long bits;
+                std::memcpy(&bits, &key, sizeof(bits));
+
+                const __m128i needle = _mm_set1_epi64x(bits);
+                uint32_t mask = 0;
+
+                for (size_t i = 0; i < __SLOTS; i += 2)
+                {
+                    __m128i halves = _mm_cmpeq_epi32(_mm_load_si128(reinterpret_cast<const __m128i*>(this->m_inline_keys + i)), needle);
+                    __m128i lanes = _mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+                    mask |= static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(lanes))) << i;
+                }
+
+                return mask;
+            }
+        #else
+            template <size_t Size>
+            uint32_t match_keys(const Key& key, integral_constant<size_t, Size>) const noexcept
+            {
+                uint32_t mask = 0;
+
+                for (size_t i = 0; i < __SLOTS; ++i)
+                    mask |= static_cast<uint32_t>(this->m_inline_keys[i] == key) << i;
+
+                return mask;
+            }
+        #endif
+        };
+
+        template <typename Key, size_t N>
+        struct __inline_key_block<Key, N, false>
+        {
+            void store_key(size_t, const Key&) noexcept { }
+
+            uint32_t match_keys(const Key&) const noexcept { return 0; }
+        };
+
+        /**
+         * @brief Node storage an @c unordered_map inherits from: @c N nodes inside the map object, chained from a single
+         *        bucket of its own, for maps that stay small. Slots are handed out lowest first and tracked by one bitmask.
+         */
+        template <typename Key, typename T, size_t N, bool Scan>
+        struct __inline_node_storage : public __inline_key_block<Key, N, Scan>
+        {
+            static_assert(N <= 32, "stl::unordered_map: at most 32 inline nodes");
+
+            typedef __hash_node<Key, T> node;
+
+            node*     m_inline_head;
+            uint32_t  m_inline_used;    // bit i: slot i holds a node
+            alignas(node) unsigned char m_inline_slots[N][sizeof(node)];
+
+            __inline_node_storage() noexcept
+                : m_inline_head(nullptr), m_inline_used(0) { }
+
+            // the map copies and moves its nodes one by one, never the raw slots
+            __inline_node_storage(const __inline_node_storage&) = delete;
+            __inline_node_storage& operator=(const __inline_node_storage&) = delete;
+
+            node** inline_bucket() const noexcept { return const_cast<node**>(&this->m_inline_head); }
+
+            /// @brief Forgets every slot, once their nodes have been destroyed or moved out.
+            void inline_reset() noexcept
+            {
+                this->m_inline_head = nullptr;
+                this->m_inline_used = 0;
+            }
+
+            /// @brief Raw memory for a node; the map constructs it and then calls @c inline_commit. A slot must be free.
+            node* inline_acquire() noexcept
+            { return reinterpret_cast<node*>(this->m_inline_slots[__builtin_ctz(~this->m_inline_used)]); }
+
+            void inline_commit(node* entry) noexcept
+            {
+                size_t slot = this->m_slot_of(entry);
+                this->m_inline_used |= static_cast<uint32_t>(1) << slot;
+                this->store_key(slot, entry->m_pair.first);
+            }
+
+            /// @brief Frees the slot of an already destroyed node.
+            void inline_release(node* entry) noexcept
+            { this->m_inline_used &= ~(static_cast<uint32_t>(1) << this->m_slot_of(entry)); }
+
+            /// @brief Inline node holding @c key, found by one block compare of the key copies; only used when @c Scan.
+            node* inline_match(const Key& key) const noexcept
+            {
+                uint32_t mask = this->match_keys(key) & this->m_inline_used;
+
+                return mask != 0 ? reinterpret_cast<node*>(const_cast<unsigned char*>(this->m_inline_slots[__builtin_ctz(mask)])) : nullptr;
+            }
+
+        private:
+            size_t m_slot_of(const node* entry) const noexcept
+            { return static_cast<size_t>(reinterpret_cast<const unsigned char*>(entry) - this->m_inline_slots[0]) / sizeof(node); }
+        };
+
+        /**
+         * @brief Without inline nodes the single bucket is a shared static one, always empty: a map that has not allocated
+         *        yet reads it like any other table, and its first insert allocates a real table before writing a bucket.
+         */
+        template <typename Key, typename T, bool Scan>
+        struct __inline_node_storage<Key, T, 0, Scan>
+        {
+            typedef __hash_node<Key, T> node;
+
+            static node* s_empty_bucket;
+
+            node** inline_bucket() const noexcept { return &s_empty_bucket; }
+
+            void inline_reset() noexcept { }
+
+            node* inline_acquire() noexcept { return nullptr; }
+
+            void inline_commit(node*) noexcept { }
+
+            void inline_release(node*) noexcept { }
+
+            node* inline_match(const Key&) const noexcept { return nullptr; }
+        };
+
+        template <typename Key, typename T, bool Scan>
+        typename __inline_node_storage<Key, T, 0, Scan>::node* __inline_node_storage<Key, T, 0, Scan>::s_empty_bucket = nullptr;
+    }
+}
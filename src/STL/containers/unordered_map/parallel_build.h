@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../../traits/type_traits.h"
+#include "../../allocator/allocator.h"
+#include "../vector/vector.h"
+
+#include <mutex>
+#include <thread>
+#include <exception>
+
+namespace stl
+{
+    /**
+     * @brief Asks for the parallel form of an @c unordered_map bulk operation (@c rehash, range @c insert, range construction),
+     *        run on @c threads threads, the calling one among them; 0 takes @c std::thread::hardware_concurrency().
+     *        Fewer threads are used when the work is too small to pay for starting them.
+     */
+    struct parallel_t
+    {
+        size_t threads;
+
+        explicit parallel_t(size_t threads = 0) noexcept
+            : threads(threads) { }
+    };
+
+    namespace __detail
+    {
+        /// @brief Threads to use for @c work items: as many as asked, but none with less than @c grain items to do.
+        inline size_t __parallel_threads(const parallel_t& par, size_t work, size_t grain) noexcept
+        {
+            size_t threads = par.threads != 0 ? par.threads : static_cast<size_t>(std::thread::hardware_concurrency());
+            size_t useful = work / grain;
+
+            if (threads > useful)
+                threads = useful;
+
+            return threads == 0 ? 1 : threads;
+        }
+
+        /**
+         * @brief Runs @c f(t) for every @c t in [0, @c threads), @c f(0) on the calling thread and the others on threads started
+         *        for the call. A share whose thread cannot be started runs on the calling thread instead. Returns once every
+         *        share is done, rethrowing the first exception one of them threw.
+         */
+        template <typename F>
+        void __parallel_run(size_t threads, F&& f)
+        {
+            std::exception_ptr error;
+            std::mutex error_mutex;
+
+            auto run = [&](size_t t)
+            {
+                try
+                {
+                    f(t);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+
+                    if (!error)
+                        error = std::current_exception();
+                }
+            };
+
+            stl::vector<std::thread> workers;
+            workers.reserve(threads);
+
+            for (size_t t = 1; t < threads; ++t)
+            {
+                try
+                {
+                    workers.emplace_back(run, t);
+                }
+                catch (...)
+                {
+                    run(t);
+                }
+            }
+
+            run(0);
+
+            for (size_t t = 0; t < workers.size(); ++t)
+                workers.data()[t].join();
+
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+        /// @brief Allocators whose @c allocate and @c deallocate may be called from several threads at once on one instance.
+        template <typename Alloc>
+        struct __concurrent_allocator : false_type { };
+
+        template <typename T>
+        struct __concurrent_allocator<allocator<T>> : true_type { };
+    }
+}
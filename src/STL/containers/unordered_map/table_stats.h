@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../../traits/type_traits.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace stl
+{
+    /**
+     * @brief Snapshot of the shape and history of a chained hash table, as returned by @c unordered_map::stats().
+     *        The shape fields (chains, bytes) are computed on demand and always available; the counters (lookups,
+     *        rehashes) are only collected when the map is instantiated with @c CollectStats and read zero otherwise.
+     */
+    struct table_stats
+    {
+        constexpr static size_t __HISTOGRAM_SIZE = 16;
+
+        size_t  size;
+        size_t  bucket_count;
+        size_t  chain_histogram[__HISTOGRAM_SIZE];    // [i]: buckets holding i nodes, the last entry counts every longer chain too
+        size_t  max_chain;
+
+        size_t  find_hits;
+        size_t  find_misses;
+        double  avg_probes_hit;                       // nodes compared per successful lookup, the match included
+        double  avg_probes_miss;                      // nodes compared per failed lookup, i.e. the chain length walked
+
+        size_t  rehash_count;                         // full rehashes, plus incremental rehashes started
+        double  rehash_ms;                            // time spent rehashing, incremental migration steps included
+
+        size_t  bucket_bytes;
+        size_t  node_bytes;
+    };
+
+    namespace __detail
+    {
+        /**
+         * @brief Lookup and rehash counters a hash table inherits from; the disabled specialization is empty and every call is a no-op.
+         *        Lookups are const and may run on several threads at once, so their counters are relaxed atomics: each one is
+         *        exact, but a snapshot taken while lookups run may pair the hits of one moment with the probes of the next.
+         */
+        template <bool Enabled>
+        struct __table_stats_storage
+        {
+            typedef std::chrono::steady_clock::time_point time_point;
+
+            mutable std::atomic<size_t>         m_find_hits;
+            mutable std::atomic<size_t>         m_find_misses;
+            mutable std::atomic<size_t>         m_hit_probes;
+            mutable std::atomic<size_t>         m_miss_probes;
+            size_t                              m_rehash_count;
+            std::chrono::steady_clock::duration m_rehash_time;
+
+            __table_stats_storage() noexcept
+            { this->reset_stats(); }
+
+            __table_stats_storage(const __table_stats_storage& other) noexcept
+            { *this = other; }
+
+            __table_stats_storage& operator=(const __table_stats_storage& other) noexcept
+            {
+                this->m_find_hits.store(other.m_find_hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                this->m_find_misses.store(other.m_find_misses.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                this->m_hit_probes.store(other.m_hit_probes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                this->m_miss_probes.store(other.m_miss_probes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                this->m_rehash_count = other.m_rehash_count;
+                this->m_rehash_time = other.m_rehash_time;
+
+                return *this;
+            }
+
+            void record_find(size_t probes, bool hit) const noexcept
+            {
+                if (hit)
+                {
+                    this->m_find_hits.fetch_add(1, std::memory_order_relaxed);
+                    this->m_hit_probes.fetch_add(probes, std::memory_order_relaxed);
+                }
+                else
+                {
+                    this->m_find_misses.fetch_add(1, std::memory_order_relaxed);
+                    this->m_miss_probes.fetch_add(probes, std::memory_order_relaxed);
+                }
+            }
+
+            void record_rehash() noexcept { ++this->m_rehash_count; }
+
+            time_point rehash_clock() const noexcept { return std::chrono::steady_clock::now(); }
+
+            void record_rehash_time(time_point start) noexcept { this->m_rehash_time += std::chrono::steady_clock::now() - start; }
+
+            void reset_stats() noexcept
+            {
+                this->m_find_hits.store(0, std::memory_order_relaxed);
+                this->m_find_misses.store(0, std::memory_order_relaxed);
+                this->m_hit_probes.store(0, std::memory_order_relaxed);
+                this->m_miss_probes.store(0, std::memory_order_relaxed);
+                this->m_rehash_count = 0;
+                this->m_rehash_time = std::chrono::steady_clock::duration::zero();
+            }
+
+            void fill_stats(table_stats& stats) const noexcept
+            {
+                stats.find_hits = this->m_find_hits.load(std::memory_order_relaxed);
+                stats.find_misses = this->m_find_misses.load(std::memory_order_relaxed);
+
+                const size_t hit_probes = this->m_hit_probes.load(std::memory_order_relaxed);
+                const size_t miss_probes = this->m_miss_probes.load(std::memory_order_relaxed);
+
+                stats.avg_probes_hit = stats.find_hits != 0 ? static_cast<double>(hit_probes) / stats.find_hits : 0;
+                stats.avg_probes_miss = stats.find_misses != 0 ? static_cast<double>(miss_probes) / stats.find_misses : 0;
+                stats.rehash_count = this->m_rehash_count;
+                stats.rehash_ms = std::chrono::duration<double, std::milli>(this->m_rehash_time).count();
+            }
+        };
+
+        template <>
+        struct __table_stats_storage<false>
+        {
+            typedef int time_point;
+
+            void record_find(size_t, bool) const noexcept { }
+
+            void record_rehash() noexcept { }
+
+            time_point rehash_clock() const noexcept { return 0; }
+
+            void record_rehash_time(time_point) noexcept { }
+
+            void reset_stats() noexcept { }
+
+            void fill_stats(table_stats& stats) const noexcept
+            {
+                stats.find_hits = stats.find_misses = stats.rehash_count = 0;
+                stats.avg_probes_hit = stats.avg_probes_miss = stats.rehash_ms = 0;
+            }
+        };
+    }
+}
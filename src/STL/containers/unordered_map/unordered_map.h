@@ -2,10 +2,16 @@
 
 #include "../../iterator.h"
 #include "../../allocator/allocator.h"
+#include "../../allocator/pool_allocator.h"
 #include "../../functional_hash/hash.h"
+#include "../../functional_hash/hash_policy.h"
+#include "../vector/vector.h"
 #include "../../../cUtility/stl_pair.h"
 #include "../../../cUtility/stl_function.h"
 #include "../../../cUtility/hashable.h"
+#include "table_stats.h"
+#include "inline_nodes.h"
+#include "parallel_build.h"
 
 #include <stdexcept>
 #include <initializer_list>
@@ -20,22 +26,48 @@ namespace stl
      * @param T          Value type
      * @param Hash       Hash function type
      * @param KeyEqual   Key comparison function type
-     * @param Allocator  Allocator type
+     * @param Allocator     Allocator type
+     * @param RehashPolicy  Bucket sizing policy: @c stl::power2_rehash_policy (mask indexing), @c stl::prime_rehash_policy (modulo indexing)
+     *                      or @c stl::incremental_rehash_policy (mask indexing, growth spread over the following operations)
+     * @param CollectStats  Counts lookup probes and rehash time for @c stats(); compiled out entirely when false
+     * @param InlineCapacity  Up to this many entries (at most 32) live inside the map object, chained from a single bucket
+     *                        of its own, and are found without hashing: integral keys by one SIMD compare of all of them.
+     *                        The map allocates a bucket array and heap nodes only once it grows past them. With 0, the
+     *                        default, there are no inline nodes and the bucket array is allocated by the first insert.
      */
     template <
         typename Key, 
         typename T, 
-        typename Hash      = stl::hash<Key>, 
-        typename KeyEqual  = stl::equal_to<Key>, 
-        typename Allocator = stl::allocator<stl::pair_node<Key, T>>
-    > class unordered_map
+        typename Hash         = stl::hash<Key>, 
+        typename KeyEqual     = stl::equal_to<Key>, 
+        typename Allocator    = stl::allocator<stl::pair_node<Key, T>>,
+        typename RehashPolicy = stl::power2_rehash_policy,
+        bool CollectStats     = false,
+        stl::size_t InlineCapacity = 0
+    > class unordered_map : private __detail::__table_stats_storage<CollectStats>,
+                            private __detail::__inline_node_storage<Key, T, InlineCapacity, __detail::__inline_key_scan<Key, KeyEqual>::value>
     {
         constexpr static unsigned short   __DEFAULT_BUCKET_SIZE = 16;
         constexpr static float            __DEFAULT_LOAD_FACTOR = .75;
+        constexpr static unsigned short   __PREFETCH_DISTANCE   = 16;      // find_batch: keys between a prefetch and its use, per stage
+        constexpr static unsigned short   __BULK_PARTITION      = 4096;    // insert(first, last): buckets linked together, a slice that stays in cache
+        constexpr static unsigned short   __PARALLEL_GRAIN      = 32768;   // parallel rehash and insert: fewest nodes worth a thread of their own
 
+        // inline entries are moved to the heap only when neither half can throw on it, and copied otherwise
+        constexpr static bool __NOTHROW_PROMOTE = noexcept(Key(stl::declval<Key>())) && noexcept(T(stl::declval<T>()));
+
+        using stats_storage    = __detail::__table_stats_storage<CollectStats>;
         using allocator_traits = stl::allocator_traits<Allocator>;
         using bucket_allocator = typename Allocator::template rebind<stl::pair_node<Key, T>*>::other;
 
+        // the inline nodes are scanned as a block for a key_type key, and walked for a heterogeneous one
+        template <typename K>
+        using inline_scan_t = bool_constant<__detail::__inline_key_scan<Key, KeyEqual>::value && is_same<K, Key>::value>;
+
+        // enables the heterogeneous overloads for K when Hash and KeyEqual are both transparent
+        template <typename K>
+        using transparent_t = typename enable_if<__detail::__transparent_lookup<Hash, KeyEqual, K>::value>::type;
+
     public:
         typedef Key                                                         key_type;
         typedef T                                                           mapped_type;
@@ -45,6 +77,7 @@ namespace stl
         typedef Hash                                                        hasher;
         typedef KeyEqual                                                    key_equal;          
         typedef Allocator                                                   allocator_type;     
+        typedef RehashPolicy                                                rehash_policy;
         typedef value_type&                                                 reference;
         typedef const value_type&                                           const_reference;
         typedef typename allocator_traits::pointer                          pointer;
@@ -55,14 +88,20 @@ namespace stl
         typedef typename stl::const_node_iterator<key_type, mapped_type>    const_local_iterator;
         
         struct node_type;
+        struct insert_return_type;
+
+        // A map asked for no more than the default bucket count starts on its inline bucket and allocates nothing until
+        // an insert outgrows it; copies of a map with at most InlineCapacity entries start there too.
 
         unordered_map()
-            : m_table(nullptr), m_size(0), m_capacity(__DEFAULT_BUCKET_SIZE), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(), m_key_equal(), m_alloc()
-        { this->m_default_initialize(__DEFAULT_BUCKET_SIZE); } 
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(), m_key_equal(), m_alloc(),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_inline_initialize(); } 
 
         explicit unordered_map(size_type bucket_count, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
-            : m_table(nullptr), m_size(0), m_capacity(bucket_count), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(hash), m_key_equal(equal), m_alloc(alloc)
-        { this->m_default_initialize(bucket_count); }
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(hash), m_key_equal(equal), m_alloc(alloc),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_table_initialize(bucket_count); }
 
         unordered_map(size_type bucket_count, const allocator_type& alloc)
             : unordered_map(bucket_count, Hash(), KeyEqual(), alloc) { }
@@ -76,7 +115,7 @@ namespace stl
         template <typename InputIt, typename = stl::RequireIterator<InputIt>>
         unordered_map(InputIt first, InputIt last, size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
             : unordered_map(bucket_count, hash, equal, alloc)
-        { this->m_range_initialize(first, last); }
+        { this->insert(first, last); }
         
         template <typename InputIt, typename = stl::RequireIterator<InputIt>>
         unordered_map(InputIt first, InputIt last, size_type bucket_count, const allocator_type& alloc)
@@ -86,34 +125,42 @@ namespace stl
         unordered_map(InputIt first, InputIt last, size_type bucket_count, const hasher& hash, const allocator_type& alloc)
             : unordered_map(first, last, bucket_count, hash, KeyEqual(), alloc) { }
 
+        /// @brief Range construction built on several threads, see @c insert(const parallel_t&, InputIt, InputIt).
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        unordered_map(const parallel_t& par, InputIt first, InputIt last, size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(),
+                      const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
+            : unordered_map(bucket_count, hash, equal, alloc)
+        { this->insert(par, first, last); }
+
         unordered_map(const unordered_map& other) 
-            : m_table(nullptr), m_size(0), m_capacity(other.m_capacity), m_load_factor(other.m_load_factor),
-              m_hash(other.m_hash), m_key_equal(other.m_key_equal), m_alloc(allocator_traits::select_on_container_copy_construction(other.m_alloc))
-        { this->m_range_initialize(other.cbegin(), other.cend(), this->m_capacity); }
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(other.m_load_factor),
+              m_hash(other.m_hash), m_key_equal(other.m_key_equal), m_alloc(allocator_traits::select_on_container_copy_construction(other.m_alloc)),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_copy_from(other); }
 
         unordered_map(const unordered_map& other, const allocator_type& alloc)
-            : m_table(nullptr), m_size(0), m_capacity(other.m_capacity), m_load_factor(other.m_load_factor),
-              m_hash(other.m_hash), m_key_equal(other.m_key_equal), m_alloc(alloc)
-        { this->m_range_initialize(other.cbegin(), other.cend(), this->m_capacity); }
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(other.m_load_factor),
+              m_hash(other.m_hash), m_key_equal(other.m_key_equal), m_alloc(alloc),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_copy_from(other); }
+
+        // the moved-from map is left empty on its inline bucket, as after default construction
 
         unordered_map(unordered_map&& other) 
-            : m_table(other.m_table), m_size(other.m_size), m_capacity(other.m_capacity), m_load_factor(other.m_load_factor),
-              m_hash(stl::move(other.m_hash)), m_key_equal(stl::move(other.m_key_equal)), m_alloc(stl::move(other.m_alloc)) 
-        { 
-            other.m_size = other.m_capacity = 0;
-            other.m_table = nullptr;
-        }
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(other.m_load_factor),
+              m_hash(stl::move(other.m_hash)), m_key_equal(stl::move(other.m_key_equal)), m_alloc(stl::move(other.m_alloc)),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_move_from(other); }
 
         unordered_map(unordered_map&& other, const allocator_type& alloc)
-            : m_table(other.m_table), m_size(other.m_size), m_capacity(other.m_capacity), m_load_factor(other.m_load_factor),
-              m_hash(stl::move(other.m_hash)), m_key_equal(stl::move(other.m_key_equal)), m_alloc(alloc) 
-        { 
-            other.m_size = other.m_capacity = 0;
-            other.m_table = nullptr;
-        }
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(other.m_load_factor),
+              m_hash(stl::move(other.m_hash)), m_key_equal(stl::move(other.m_key_equal)), m_alloc(alloc),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
+        { this->m_move_from(other); }
 
         unordered_map(std::initializer_list<value_type> ilist, size_type bucket_count = __DEFAULT_BUCKET_SIZE, const hasher& hash = Hash(), const key_equal& equal = KeyEqual(), const allocator_type& alloc = Allocator())
-            : m_table(nullptr), m_size(0), m_capacity(bucket_count), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(hash), m_key_equal(equal), m_alloc(alloc)
+            : m_table(nullptr), m_size(0), m_capacity(0), m_load_factor(__DEFAULT_LOAD_FACTOR), m_hash(hash), m_key_equal(equal), m_alloc(alloc),
+              m_old_table(nullptr), m_old_capacity(0), m_migrate_pos(0)
         { this->m_range_initialize(ilist.begin(), ilist.end(), bucket_count); }
 
         unordered_map(std::initializer_list<value_type> ilist, size_type bucket_count, const allocator_type& alloc)
@@ -129,21 +176,13 @@ namespace stl
         {
             if (this != &other)
             {
-                if (this->m_table != nullptr)
-                {
-                    if (this->m_size > 0)
-                        this->clear();
-
-                    this->m_check_rehash(other.m_size, this->m_capacity, this->m_load_factor);
-                }
+                this->m_destroy_table();
 
-                this->m_size = other.m_size;
-                this->m_capacity = other.m_capacity;
                 this->m_load_factor = other.m_load_factor;
                 this->m_hash = other.m_hash;
                 this->m_key_equal = other.m_key_equal;
                 this->m_alloc = allocator_traits::select_on_container_copy_construction(other.m_alloc);
-                this->m_range_initialize(other.cbegin(), other.cend(), this->m_capacity);
+                this->m_copy_from(other);
             }
 
             return *this;
@@ -153,19 +192,13 @@ namespace stl
         {
             if (this != &other)
             {
-                if (this->m_table != nullptr)      
-                    this->m_destroy_table();
+                this->m_destroy_table();
 
-                this->m_table = other.m_table;
-                this->m_size = other.m_size;
-                this->m_capacity = other.m_capacity;
                 this->m_load_factor = other.m_load_factor;
                 this->m_hash = stl::move(other.m_hash);
                 this->m_key_equal = stl::move(other.m_key_equal);
                 this->m_alloc = stl::move(other.m_alloc);
-
-                other.m_size = other.m_capacity = 0;
-                other.m_table = nullptr;
+                this->m_move_from(other);
             }
 
             return *this;
@@ -173,22 +206,15 @@ namespace stl
 
         unordered_map& operator=(std::initializer_list<value_type> ilist)
         {
-            if (this->m_table != nullptr)
-            {
-                if (this->m_size > 0)
-                    this->clear();
-
-                this->m_deallocate_table();
-                this->m_table = nullptr;
-            }
-
-            this->m_capacity = __DEFAULT_BUCKET_SIZE;
+            this->m_destroy_table();
             this->m_load_factor = __DEFAULT_LOAD_FACTOR;
 
-            while (this->m_capacity * this->m_load_factor < ilist.size())
-                this->m_capacity *= 2;
+            size_type bucket_count = __DEFAULT_BUCKET_SIZE;
+
+            while (bucket_count * this->m_load_factor < ilist.size())
+                bucket_count *= 2;
 
-            this->m_range_initialize(ilist.begin(), ilist.end(), this->m_capacity);
+            this->m_range_initialize(ilist.begin(), ilist.end(), bucket_count);
 
             return *this;
         }
@@ -196,11 +222,37 @@ namespace stl
         allocator_type get_allocator() const noexcept 
         { return this->m_alloc; }
 
-        iterator begin() { return iterator(this->m_table, this->m_table + this->m_capacity, *this->m_table); }
+        hasher hash_function() const
+        { return this->m_hash; }
+
+        key_equal key_eq() const
+        { return this->m_key_equal; }
+
+        // While an incremental rehash is pending, iteration reads the buckets of the old table not migrated yet, then the
+        // new table, whose buckets stay empty until their source is migrated: every entry is visited once and nothing moves.
+        // end() only compares by node.
+
+        iterator begin() 
+        { 
+            if (this->m_capacity == 0)
+                return this->end();
+
+            iterator it = this->template m_first_bucket<iterator>();
+            it.m_skip_empty_buckets();
+            return it;
+        }
 
         iterator end() { return iterator(this->m_table + this->m_capacity, this->m_table + this->m_capacity, nullptr); }
 
-        const_iterator cbegin() const noexcept { return const_iterator(this->m_table, this->m_table + this->m_capacity, *this->m_table); }
+        const_iterator cbegin() const noexcept 
+        { 
+            if (this->m_capacity == 0)
+                return this->cend();
+
+            const_iterator it = this->template m_first_bucket<const_iterator>();
+            it.m_skip_empty_buckets();
+            return it;
+        }
 
         const_iterator cend() const noexcept { return const_iterator(this->m_table + this->m_capacity, this->m_table + this->m_capacity, nullptr); }
 
@@ -215,24 +267,66 @@ namespace stl
 
         void clear() noexcept;
 
+        // Every insertion looks the key up first, hashing it once, and constructs the entry only when the key is new:
+        // exactly once, in place in its node. A key already present costs no construction and no allocation.
+        // Hints are accepted for compatibility and ignored.
+
         pair<iterator, bool> insert(const_reference node)
-        { return this->m_insert(node.m_pair.first, node.m_pair.second); }
+        { return this->m_emplace_unique(node.m_pair.first, node.m_pair.second); }
 
         pair<iterator, bool> insert(const key_type &key, const value_type value)
         { return this->m_insert(key, value); }
 
         pair<iterator, bool> insert(value_type&& node)
-        { return this->m_insert(stl::move(node.m_pair.first), stl::move(node.m_pair.second)); }
-
-        iterator insert(const_iterator hint, const_reference node)
-        { return this->m_insert(hint, node.m_pair.first, node.m_pair.second); }
-
-        iterator insert(const_iterator hint, value_type&& node)
-        { return this->insert(hint, stl::move(node.m_pair.first), stl::move(node.m_pair.second)); }
-
+        { return this->m_emplace_unique(stl::move(node.m_pair.first), stl::move(node.m_pair.second)); }
+
+        iterator insert(const_iterator, const_reference node)
+        { return this->insert(node).first; }
+
+        iterator insert(const_iterator, value_type&& node)
+        { return this->insert(stl::move(node)).first; }
+
+        /**
+         * @brief Links the node held by @c nh into the map, with no allocation and no copy, unless its key is present:
+         *        then @c nh keeps the node and is returned in @c insert_return_type::node. The key is hashed again, so
+         *        it may have been changed through @c nh.key() since it was extracted.
+         */
+        insert_return_type insert(node_type&& nh);
+
+        iterator insert(const_iterator, node_type&& nh)
+        { return this->insert(stl::move(nh)).position; }
+
+        /**
+         * @brief Moves every entry of @c source whose key is not in this map into it; the others stay in @c source.
+         *        With equal allocators the nodes themselves are relinked: nothing is allocated, freed or copied.
+         *        Otherwise, and for entries entering or leaving inline nodes, the entries are moved into new nodes.
+         */
+        void merge(unordered_map& source);
+
+        void merge(unordered_map&& source)
+        { this->merge(source); }
+
+        /**
+         * @brief Inserts the entries of [@c first, @c last) whose keys are not in the map yet, the first of several equal keys winning.
+         *        A forward range of @c value_type is built in bulk: the table grows at most once, every key is hashed up front,
+         *        and the entries are then linked @c __BULK_PARTITION buckets at a time, their nodes allocated in one block when
+         *        the allocator can hand it out (@c stl::pool_allocator). Any other range is inserted one entry at a time.
+         */
         template <typename InputIt, typename = stl::RequireIterator<InputIt>>
         void insert(InputIt first, InputIt last);
 
+        /**
+         * @brief @c insert(first, last) on several threads. Hashing, sorting the entries by slice and linking the slices are each
+         *        split between the threads, which own disjoint bucket ranges while linking, so no bucket is ever shared.
+         *        Nodes are allocated from the worker threads only when the allocator can take it (@c stl::allocator, or one
+         *        block handed out up front by @c stl::pool_allocator); with any other allocator the linking stays on the
+         *        calling thread. Any range but a forward range of @c value_type is inserted as by the sequential @c insert.
+         *        @c Hash, @c KeyEqual and the entry copies run concurrently; if a copy throws, the entries already linked stay.
+         */
+        template <typename InputIt, typename = stl::RequireIterator<InputIt>>
+        void insert(const parallel_t& par, InputIt first, InputIt last)
+        { this->m_insert_range(par, first, last, bulk_insert_t<InputIt>()); }
+
         void insert(std::initializer_list<value_type> ilist)
         { this->insert(ilist.begin(), ilist.end()); }
 
@@ -241,138 +335,202 @@ namespace stl
         { return this->m_insert(stl::forward<Args>(args)...); }
 
         template <typename... Args>
-        iterator emplace_hint(const_iterator hint, Args&&... args)
-        { return this->m_insert(hint, stl::forward<Args>(args)...); }
+        iterator emplace_hint(const_iterator, Args&&... args)
+        { return this->m_insert(stl::forward<Args>(args)...).first; }
 
+        /// @brief Inserts @c mapped_type(args...) under @c key unless the key is present, in which case @c args are left untouched.
         template <typename... Args>
         pair<iterator, bool> try_emplace(const key_type& key, Args&&... args)
-        { return this->m_try_emplace(key, stl::forward<Args>(args)...); }
+        { return this->m_emplace_unique(key, stl::forward<Args>(args)...); }
 
         template <typename... Args>
         pair<iterator, bool> try_emplace(key_type&& key, Args&&... args)
-        { return this->m_try_emplace(stl::move(key), stl::forward<Args>(args)...); }
+        { return this->m_emplace_unique(stl::move(key), stl::forward<Args>(args)...); }
 
+        /// @brief A key of another type is looked up as is when the map is transparent, and converted to @c key_type first otherwise.
         template <typename K, typename... Args>
         pair<iterator, bool> try_emplace(K&& key, Args&&... args)
-        { return this->m_try_emplace(stl::forward<K>(key), stl::forward<Args>(args)...); }
+        { return this->m_emplace_key(stl::forward<K>(key), stl::forward<Args>(args)...); }
 
         template <typename... Args>
-        iterator try_emplace(const_iterator hint, const key_type& key, Args&&... args)
-        { return this->m_try_emplace(hint, key, stl::forward<Args>(args)...); }
+        iterator try_emplace(const_iterator, const key_type& key, Args&&... args)
+        { return this->try_emplace(key, stl::forward<Args>(args)...).first; }
 
         template <typename... Args>
-        iterator try_emplace(const_iterator hint, key_type&& key, Args&&... args)
-        { return this->m_try_emplace(hint, stl::move(key), stl::forward<Args>(args)...); }
+        iterator try_emplace(const_iterator, key_type&& key, Args&&... args)
+        { return this->try_emplace(stl::move(key), stl::forward<Args>(args)...).first; }
 
         template <typename K, typename... Args>
-        iterator try_emplace(const_iterator hint, K&& key, Args&&... args)
-        { return this->try_emplace(hint, stl::forward<K>(key), stl::forward<Args>(args)...); }
+        iterator try_emplace(const_iterator, K&& key, Args&&... args)
+        { return this->try_emplace(stl::forward<K>(key), stl::forward<Args>(args)...).first; }
 
+        // Iterators carry the predecessor of their node within its bucket, so erasing through one unlinks in O(1) and
+        // a range costs O(distance(first, last)). Erasing, like looking up, never advances an incremental rehash, which
+        // would relink the chains under the caller's other iterators.
+
+        /// @brief Erases [first, last) and returns an iterator to @c last.
         iterator erase(const_iterator first, const_iterator last);
 
-        iterator erase(iterator pos);
+        iterator erase(iterator pos)
+        { return pos.m_current != nullptr ? this->m_erase(pos.m_bucket_begin, pos.m_prev, pos.m_current) : this->end(); }
 
         iterator erase(const_iterator pos)
-        { return this->erase(pos, stl::next(pos)); }
+        { return pos.m_current != nullptr ? this->m_erase(pos.m_bucket_begin, pos.m_prev, pos.m_current) : this->end(); }
 
         size_type erase(const key_type& key)
-        {
-            iterator it = this->find(key);
+        { return this->m_erase_key(key); }
 
-            if (it != this->end())
-            {
-                this->erase(it);
-                return 1;
-            }
-
-            return 0;
-        }
-
-        template <typename K>
-        size_type erase(K&& x);
+        /// @brief Heterogeneous erase; like the standard, not viable for arguments convertible to an iterator.
+        template <typename K, typename = transparent_t<K>, 
+                  typename = typename enable_if<!is_convertible<K, iterator>::value && !is_convertible<K, const_iterator>::value>::type>
+        size_type erase(K&& x)
+        { return this->m_erase_key(x); }
 
         void swap(unordered_map& other) noexcept
         {
+            // inline nodes cannot change owner by a pointer swap, so a map on its inline bucket swaps by moves
+            if (this->m_is_inline() || other.m_is_inline())
+            {
+                unordered_map temp(stl::move(other));
+                other = stl::move(*this);
+                *this = stl::move(temp);
+
+                stl::swap(static_cast<stats_storage&>(*this), static_cast<stats_storage&>(other));
+                return;
+            }
+
             stl::swap(this->m_table, other.m_table);
             stl::swap(this->m_capacity, other.m_capacity);
             stl::swap(this->m_size, other.m_size);
             stl::swap(this->m_hash, other.m_hash);
             stl::swap(this->m_key_equal, other.m_key_equal);
             stl::swap(this->m_alloc, other.m_alloc);
+            stl::swap(this->m_old_table, other.m_old_table);
+            stl::swap(this->m_old_capacity, other.m_old_capacity);
+            stl::swap(this->m_migrate_pos, other.m_migrate_pos);
+            stl::swap(static_cast<stats_storage&>(*this), static_cast<stats_storage&>(other));
         }
 
         node_type extract(const_iterator pos)
         { return this->extract(pos.m_current->m_pair.first); }
 
-        node_type extract(const key_type& key);
+        node_type extract(const key_type& key)
+        { return this->m_extract(key); }
 
-        template <typename K>
-        node_type extract(K&& x);
+        template <typename K, typename = transparent_t<K>, 
+                  typename = typename enable_if<!is_convertible<K, iterator>::value && !is_convertible<K, const_iterator>::value>::type>
+        node_type extract(K&& x)
+        { return this->m_extract(x); }
 
         constexpr pointer* table() const noexcept { return this->m_table; }
 
-        // let this func update cap
-        // old cap used for rehashing
+        /// @brief Rebuilds the bucket array with at least @c new_size buckets (rounded up by the @c RehashPolicy) and relinks every node.
         void rehash(size_type new_size);
 
+        /**
+         * @brief @c rehash(new_size) on several threads, in two passes: each thread sorts the nodes of its share of the old
+         *        buckets into one list per thread by destination bucket range, then each thread links the nodes bound for its
+         *        range into the new table. No node or bucket is written by two threads; @c Hash must not throw.
+         */
+        void rehash(const parallel_t& par, size_type new_size);
+
         void reserve(size_type count)
         {
+            if (this->m_is_inline() && count <= InlineCapacity)
+                return;
+
             size_type new_cap = static_cast<size_type>(count / this->m_load_factor);
             new_cap = (1 > new_cap) ? 1 : new_cap; // Ensure at least 1 bucket exists
             this->rehash(new_cap);
         }
 
-        iterator find(const key_type& key)
+        void reserve(const parallel_t& par, size_type count)
         {
-            pointer entry = this->m_table[this->hash(key)];
-
-            while (entry != nullptr)
-            {
-                if (this->m_key_equal(entry->m_pair.first, key))
-                    return iterator(this->m_table, this->m_table + this->m_capacity, entry);
-
-                entry = entry->m_next;
-            }
+            if (this->m_is_inline() && count <= InlineCapacity)
+                return;
 
-            return this->end();
+            size_type new_cap = static_cast<size_type>(count / this->m_load_factor);
+            this->rehash(par, (1 > new_cap) ? 1 : new_cap);
         }
 
+        iterator find(const key_type& key)
+        { return this->template m_find<iterator>(key); }
+
         const_iterator find(const key_type& key) const
-        {
-            pointer entry = this->m_table[this->hash(key)];
+        { return this->template m_find<const_iterator>(key); }
 
-            while (entry != nullptr)
-            {
-                if (this->m_key_equal(entry->m_pair.first, key))
-                    return const_iterator(this->m_table, this->m_table + this->m_capacity, entry);
+        bool contains(const key_type& key) const
+        { return this->m_find_node(key) != nullptr; }
 
-                entry = entry->m_next;
-            }
+        // Heterogeneous lookup: hashes and compares @c x as is, so e.g. a @c std::string keyed map is searched by
+        // @c std::string_view or @c const char* without materialising a key.
+
+        template <typename K, typename = transparent_t<K>>
+        iterator find(const K& x)
+        { return this->template m_find<iterator>(x); }
+
+        template <typename K, typename = transparent_t<K>>
+        const_iterator find(const K& x) const
+        { return this->template m_find<const_iterator>(x); }
+
+        template <typename K, typename = transparent_t<K>>
+        bool contains(const K& x) const
+        { return this->m_find_node(x) != nullptr; }
+
+        // Keys are unique, so a range holds at most the found node.
 
-            return this->cend();
+        pair<iterator, iterator> equal_range(const key_type& key)
+        {
+            iterator it = this->find(key);
+            return {it, it == this->end() ? it : stl::next(it)};
         }
 
-        bool contains(const key_type& key)
+        pair<const_iterator, const_iterator> equal_range(const key_type& key) const
         {
-            pointer entry = this->m_table[this->hash(key)];
+            const_iterator it = this->find(key);
+            return {it, it == this->cend() ? it : stl::next(it)};
+        }
 
-            while (entry != nullptr)
-            {
-                if (this->m_key_equal(entry->m_pair.first, key))
-                    return true;
+        template <typename K, typename = transparent_t<K>>
+        pair<iterator, iterator> equal_range(const K& x)
+        {
+            iterator it = this->find(x);
+            return {it, it == this->end() ? it : stl::next(it)};
+        }
 
-                entry = entry->m_next;
-            }
+        template <typename K, typename = transparent_t<K>>
+        pair<const_iterator, const_iterator> equal_range(const K& x) const
+        {
+            const_iterator it = this->find(x);
+            return {it, it == this->cend() ? it : stl::next(it)};
+        }
 
-            return false;
+        /**
+         * @brief Looks up @c n keys at once, writing @c end() to @c out for the missing ones. The keys go through a software
+         *        pipeline: the bucket of key @c i + 2D and the chain head of key @c i + D are prefetched while key @c i is compared
+         *        (D = @c __PREFETCH_DISTANCE), so the cache misses of different keys overlap instead of queueing.
+         */
+        void find_batch(const key_type* keys, size_type n, iterator* out)
+        {
+            this->m_find_nodes(keys, n, [this, out](size_type i, pointer* bucket, pointer prev, pointer node) {
+                out[i] = node != nullptr ? this->template m_make_iterator<iterator>(bucket, node, prev) : this->end();
+            });
         }
 
+        /// @brief Batched @c contains with the same prefetching as @c find_batch.
+        void contains_batch(const key_type* keys, size_type n, bool* out) const
+        { this->m_find_nodes(keys, n, [out](size_type i, pointer*, pointer, pointer node) { out[i] = node != nullptr; }); }
+
+        // While an incremental rehash is pending, bucket n of the old table stands for the new buckets n and n + old count
+        // until it is migrated: the bucket interface reads it as bucket n, and bucket n + old count as empty. Every key
+        // is then found in bucket(key), and no const member has to finish the migration.
+
         size_type bucket_count() const noexcept { return m_capacity; }
 
         size_type bucket_size(size_type index) const
         {
             size_type count = 0;
-            pointer entry = this->m_table[index];
+            pointer entry = *this->m_local_bucket(index);
 
             while (entry != nullptr)
             {
@@ -384,7 +542,12 @@ namespace stl
         }
 
         size_type bucket(const key_type& key) const
-        { return this->hash(key); }
+        { 
+            pointer* bucket = this->m_bucket_for(this->m_hash(key));
+            pointer* table = this->m_bucket_end(bucket) == this->m_table + this->m_capacity ? this->m_table : this->m_old_table;
+
+            return static_cast<size_type>(bucket - table);
+        }
 
         mapped_type& at(const key_type& key)
         {
@@ -439,32 +602,18 @@ namespace stl
         { return this->try_emplace(stl::forward<K>(x)).first->second; }
 
         size_type count(const key_type& key) const
-        {
-            iterator it = this->find(key);
+        { return this->contains(key) ? 1 : 0; }
 
-            if (it == this->end())
-                return 0;
-
-            return 1;
-        }
-
-        template <typename K>
+        template <typename K, typename = transparent_t<K>>
         size_type count(const K& x) const
-        {
-            iterator it = this->find(stl::forward<K>(x));
-
-            if (it == this->end())
-                return 0;
-
-            return 1;
-        }
+        { return this->contains(x) ? 1 : 0; }
 
         local_iterator begin(size_type n) 
         { 
             if (n >= this->m_capacity)
                 throw std::out_of_range("Index out of bounds!\n");
 
-            return local_iterator(*(this->m_table + n));
+            return local_iterator(*this->m_local_bucket(n));
         }
 
         local_iterator end(size_type)
@@ -475,7 +624,7 @@ namespace stl
             if (n >= this->m_capacity)
                 throw std::out_of_range("Index out of bounds!\n");
 
-            return const_local_iterator(*(this->m_table + n));
+            return const_local_iterator(*this->m_local_bucket(n));
         }
 
         const_local_iterator cend(size_type n) const
@@ -486,6 +635,16 @@ namespace stl
             return const_local_iterator(*(this->m_table + n));
         }
 
+        /**
+         * @brief Chain length histogram and memory split, walked on demand in O(buckets), plus the lookup and rehash counters
+         *        when @c CollectStats is set. During an incremental rehash the chains are those of @c bucket_size, and the
+         *        bucket bytes count both arrays.
+         */
+        table_stats stats() const;
+
+        /// @brief Zeroes the lookup and rehash counters.
+        void reset_stats() noexcept { stats_storage::reset_stats(); }
+
     private:
         pointer*        m_table;
         size_type       m_size;             // total number of elements. It is incremented everytime a new <key, value> element is added
@@ -494,13 +653,262 @@ namespace stl
         hasher          m_hash;
         key_equal       m_key_equal;
         allocator_type  m_alloc;
+        pointer*        m_old_table;        // incremental rehash: bucket array still being drained into m_table, nullptr when idle
+        size_type       m_old_capacity;
+        size_type       m_migrate_pos;      // incremental rehash: buckets [0, m_migrate_pos) of m_old_table are already migrated
 
-        size_type hash(const key_type& key)
-        { return static_cast<size_type>(this->m_hash(key) % this->m_capacity); }
+        size_type hash(const key_type& key) const
+        { return RehashPolicy::bucket_index(this->m_hash(key), this->m_capacity); }
 
         pointer* m_get_table(const size_type bucket_count);
 
-        pointer m_get_node(key_type&& key, mapped_type&& value);
+        /// @brief New node for the entry: in a free inline slot while the map is on its inline bucket, else from the allocator.
+        template <typename K, typename... Args>
+        pointer m_get_node(size_type code, K&& key, Args&&... args);
+
+        /// @brief Node allocated and constructed in place, the key from @c key and the mapped value from @c args.
+        template <typename K, typename... Args>
+        pointer m_get_heap_node(size_type code, K&& key, Args&&... args);
+
+        /// @brief Destroys @c node and gives its memory back to the inline slots or to the allocator.
+        void m_release_node(pointer node)
+        {
+            if (InlineCapacity != 0 && this->m_is_inline())
+            {
+                node->~value_type();
+                this->inline_release(node);
+            }
+            else
+            {
+                this->m_alloc.destroy(node);
+                this->m_alloc.deallocate(node, 1);
+            }
+        }
+
+        /// @brief Heap node holding the entry of the inline @c node, hashed for the first time. @c node is left in place,
+        ///        and intact if this throws; the caller releases it.
+        pointer m_promote_node(pointer node);
+
+        /// @brief Moves every inline node into a heap node linked into @c table, and empties the inline bucket.
+        void m_promote_inline(pointer* table, size_type bucket_count);
+
+        /// @brief @c value as the source of a promoted entry: an rvalue when promoting moves, else a const lvalue.
+        template <typename V>
+        static typename conditional<__NOTHROW_PROMOTE, V&&, const V&>::type m_promoted(V& value) noexcept
+        { return static_cast<typename conditional<__NOTHROW_PROMOTE, V&&, const V&>::type>(value); }
+
+        /**
+         * @brief True while the map holds no bucket array of its own: with inline nodes, the single bucket chaining them;
+         *        without, the shared empty bucket a map reads before its first insert.
+         */
+        bool m_is_inline() const noexcept
+        { return this->m_table == this->inline_bucket(); }
+
+        void m_inline_initialize() noexcept
+        {
+            this->m_table = this->inline_bucket();
+            this->m_capacity = 1;
+        }
+
+        /// @brief Node holding @c key among the inline nodes; tiny maps never hash.
+        template <typename K>
+        pointer m_inline_find(const K& key) const
+        { return this->m_inline_find(key, inline_scan_t<K>()); }
+
+        template <typename K>
+        pointer m_inline_find(const K& key, stl::true_type) const
+        { return this->inline_match(key); }
+
+        template <typename K>
+        pointer m_inline_find(const K& key, stl::false_type) const
+        {
+            pointer entry = *this->m_table;
+
+            while (entry != nullptr && !this->m_key_equal(entry->m_pair.first, key))
+                entry = entry->m_next;
+
+            return entry;
+        }
+
+        /// @brief Hash code of the key stored in @c node; read from the node when @c stl::cache_hash_code is enabled for @c Key.
+        size_type m_node_hash(const value_type* node) const
+        { return this->m_node_hash(node, stl::bool_constant<value_type::hash_code_cached>()); }
+
+        size_type m_node_hash(const value_type* node, stl::true_type) const
+        { return node->hash_code(); }
+
+        size_type m_node_hash(const value_type* node, stl::false_type) const
+        { return this->m_hash(node->m_pair.first); }
+
+        /// @brief Key comparison that first rejects on a cached hash code mismatch, so @c KeyEqual only runs on probable hits.
+        template <typename K>
+        bool m_node_equals(const value_type* node, const K& key, size_type code) const
+        { return this->m_node_equals(node, key, code, stl::bool_constant<value_type::hash_code_cached>()); }
+
+        template <typename K>
+        bool m_node_equals(const value_type* node, const K& key, size_type code, stl::true_type) const
+        { return node->hash_code() == code && this->m_key_equal(node->m_pair.first, key); }
+
+        template <typename K>
+        bool m_node_equals(const value_type* node, const K& key, size_type, stl::false_type) const
+        { return this->m_key_equal(node->m_pair.first, key); }
+
+        /**
+         * @brief Bucket holding (or receiving) the keys with hash @c code. While an incremental rehash is in progress, the old
+         *        bucket is used until it has been migrated: old bucket @c i only ever splits into new buckets @c i and @c i + old_count.
+         */
+        pointer* m_bucket_for(size_type code) const
+        {
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr)
+            {
+                size_type old_index = RehashPolicy::bucket_index(code, this->m_old_capacity);
+
+                if (old_index >= this->m_migrate_pos)
+                    return this->m_old_table + old_index;
+            }
+
+            return this->m_table + RehashPolicy::bucket_index(code, this->m_capacity);
+        }
+
+        /**
+         * @brief End of the bucket array @c bucket belongs to, or @c nullptr if it is not a live bucket (an old bucket
+         *        already migrated, or one of a table freed since).
+         */
+        pointer* m_bucket_end(pointer* bucket) const
+        {
+            if (bucket >= this->m_table && bucket < this->m_table + this->m_capacity)
+                return this->m_table + this->m_capacity;
+
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr &&
+                bucket >= this->m_old_table + this->m_migrate_pos && bucket < this->m_old_table + this->m_old_capacity)
+                return this->m_old_table + this->m_old_capacity;
+
+            return nullptr;
+        }
+
+        /// @brief Bucket @c n of the bucket interface: the old bucket @c n while it waits to be migrated, else the new one.
+        pointer* m_local_bucket(size_type n) const
+        {
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr && n >= this->m_migrate_pos && n < this->m_old_capacity)
+                return this->m_old_table + n;
+
+            return this->m_table + n;
+        }
+
+        /// @brief Iterator to @c node, found after @c prev in the live @c bucket; from an old bucket it walks on into the new table.
+        template <typename It>
+        It m_make_iterator(pointer* bucket, pointer node, pointer prev) const
+        {
+            pointer* bucket_end = this->m_bucket_end(bucket);
+
+            if (RehashPolicy::migrate_buckets != 0 && bucket_end != this->m_table + this->m_capacity)
+                return It(bucket, bucket_end, node, prev, this->m_table, this->m_table + this->m_capacity);
+
+            return It(bucket, bucket_end, node, prev);
+        }
+
+        /// @brief Iterator on the head of the first bucket to walk: the first old bucket not migrated yet, if any.
+        template <typename It>
+        It m_first_bucket() const
+        {
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr)
+                return this->template m_make_iterator<It>(this->m_old_table + this->m_migrate_pos, this->m_old_table[this->m_migrate_pos], nullptr);
+
+            return It(this->m_table, this->m_table + this->m_capacity, *this->m_table);
+        }
+
+        template <typename K>
+        pointer m_find_node(const K& key) const
+        {
+            if (InlineCapacity != 0 && this->m_is_inline())
+            {
+                pointer entry = this->m_inline_find(key);
+                this->record_find(entry != nullptr, entry != nullptr);
+                return entry;
+            }
+
+            size_type code = this->m_hash(key);
+            pointer entry = *this->m_bucket_for(code);
+            size_type probes = 0;
+
+            while (entry != nullptr && !this->m_node_equals(entry, key, code))
+            {
+                ++probes;
+                entry = entry->m_next;
+            }
+
+            this->record_find(probes + (entry != nullptr), entry != nullptr);
+            return entry;
+        }
+
+        /**
+         * @brief @c m_find_node that also reports the bucket and the predecessor of the node, as needed by an iterator.
+         *        An inline node is found by itself, so its predecessor is reported as @c nullptr, which @c m_erase checks.
+         */
+        template <typename K>
+        pointer m_locate(const K& key, pointer*& bucket, pointer& prev) const
+        {
+            size_type code;
+            return this->m_locate(key, bucket, prev, code);
+        }
+
+        /// @brief @c m_locate that also hands back the hash of @c key, or 0 when the inline bucket was searched unhashed.
+        template <typename K>
+        pointer m_locate(const K& key, pointer*& bucket, pointer& prev, size_type& code) const
+        {
+            if (InlineCapacity != 0 && this->m_is_inline())
+            {
+                bucket = this->m_table;
+                prev = nullptr;
+                code = 0;
+
+                pointer entry = this->m_inline_find(key);
+                this->record_find(entry != nullptr, entry != nullptr);
+                return entry;
+            }
+
+            code = this->m_hash(key);
+            bucket = this->m_bucket_for(code);
+            prev = nullptr;
+
+            pointer entry = *bucket;
+            size_type probes = 0;
+
+            while (entry != nullptr && !this->m_node_equals(entry, key, code))
+            {
+                ++probes;
+                prev = entry;
+                entry = entry->m_next;
+            }
+
+            this->record_find(probes + (entry != nullptr), entry != nullptr);
+            return entry;
+        }
+
+        template <typename It, typename K>
+        It m_find(const K& key) const
+        {
+            pointer* bucket;
+            pointer prev;
+            pointer entry = this->m_locate(key, bucket, prev);
+
+            if (entry == nullptr)
+                return It(this->m_table + this->m_capacity, this->m_table + this->m_capacity, nullptr);
+
+            return this->template m_make_iterator<It>(bucket, entry, prev);
+        }
+
+        /// @brief Unlinks and frees @c node, whose iterator says it sits in @c bucket after @c prev; returns the next iterator.
+        iterator m_erase(pointer* bucket, pointer prev, pointer node);
+
+        template <typename K>
+        size_type m_erase_key(const K& key);
+
+        template <typename K>
+        node_type m_extract(const K& key);
+
+        template <typename Emit>
+        void m_find_nodes(const key_type* keys, size_type count, Emit emit) const;
 
         void m_deallocate_table();
 
@@ -508,22 +916,171 @@ namespace stl
 
         void m_default_initialize(const size_type bucket_count);
 
+        /// @brief Starts on the inline bucket when @c bucket_count is no more than the default, else allocates the table.
+        void m_table_initialize(const size_type bucket_count)
+        {
+            if (bucket_count <= __DEFAULT_BUCKET_SIZE)
+                this->m_inline_initialize();
+            else
+                this->m_default_initialize(bucket_count);
+        }
+
         template <typename InputIt>
         void m_range_initialize(InputIt first, InputIt last, size_type bucket_count = __DEFAULT_BUCKET_SIZE);
 
-        void m_range_initialize(const_iterator first, const_iterator last, size_type bucket_count = __DEFAULT_BUCKET_SIZE);
+        /// @brief Fills an empty map without a table with the entries of @c other.
+        void m_copy_from(const unordered_map& other);
+
+        /// @brief Takes the entries of @c other into an empty map without a table, leaving @c other empty and inline.
+        void m_move_from(unordered_map& other);
 
         void m_check_rehash(size_type t_size, size_type b_size, float load_factor = __DEFAULT_LOAD_FACTOR);
 
-        template <typename... Args>
-        pair<iterator, bool> m_insert(Args&&... args);
+        void m_begin_incremental_rehash(size_type new_size);
 
-        template <typename... Args>
-        pair<iterator, bool> m_try_emplace(const key_type& key, Args&&... args);
+        void m_migrate_buckets(size_type count);
+
+        /// @brief Moves @c RehashPolicy::migrate_buckets buckets of a pending incremental rehash into the new table.
+        void m_migrate_step()
+        {
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr)
+                this->m_migrate_buckets(RehashPolicy::migrate_buckets);
+        }
+
+        void m_finish_rehash()
+        {
+            if (RehashPolicy::migrate_buckets != 0 && this->m_old_table != nullptr)
+                this->m_migrate_buckets(this->m_old_capacity - this->m_migrate_pos);
+        }
+
+        // a forward range of value_type can be walked twice and its entries addressed in place, as the bulk build needs
+        template <typename It>
+        using bulk_insert_t = bool_constant<is_base_of<forward_iterator_tag, typename iterator_traits<It>::iterator_category>::value &&
+                                            is_same<typename remove_cv<typename iterator_traits<It>::value_type>::type, value_type>::value>;
+
+        template <typename InputIt>
+        void m_insert_range(InputIt first, InputIt last, stl::false_type);
+
+        template <typename ForwardIt>
+        void m_insert_range(ForwardIt first, ForwardIt last, stl::true_type);
+
+        template <typename InputIt>
+        void m_insert_range(const parallel_t&, InputIt first, InputIt last, stl::false_type)
+        { this->m_insert_range(first, last, stl::false_type()); }
+
+        template <typename ForwardIt>
+        void m_insert_range(const parallel_t& par, ForwardIt first, ForwardIt last, stl::true_type);
+
+        // a key argument is used for the lookup as is when it is a key_type or the map is transparent for it
+        template <typename K>
+        using direct_key_t = bool_constant<is_same<typename remove_cv<typename remove_reference<K>::type>::type, key_type>::value ||
+                                           __detail::__transparent_lookup<Hash, KeyEqual, K>::value>;
+
+        /**
+         * @brief Core of every insertion: looks @c key up and, only if it is absent, builds the node in place from @c key
+         *        and @c args, before any growth, so arguments referring into the map stay valid while they are read.
+         */
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_unique(K&& key, Args&&... args)
+        {
+            size_type code;
+            pointer* bucket;
+            pointer prev;
+            pointer entry = this->m_locate(key, bucket, prev, code);
+
+            if (entry != nullptr)
+                return {this->template m_make_iterator<iterator>(bucket, entry, prev), false};
+
+            return this->m_emplace_new(code, bucket, prev, stl::forward<K>(key), stl::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Links the heap @c node, whose key is not in the map and hashes to @c code, where the failed lookup for it
+         *        ended (@c bucket, @c prev), after a step of a pending incremental rehash and growing the table. The node is
+         *        left untouched if growing throws.
+         */
+        iterator m_link_node(size_type code, pointer* bucket, pointer prev, pointer node);
+
+        /**
+         * @brief Miss path of @c m_emplace_unique, kept out of line so a hit costs no more than @c find.
+         *        @c bucket and @c prev are where the failed lookup ended: the tail of the chain of @c code.
+         */
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_new(size_type code, pointer* bucket, pointer prev, K&& key, Args&&... args);
+
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(K&& key, Args&&... args)
+        { return this->m_emplace_key(direct_key_t<K>(), stl::forward<K>(key), stl::forward<Args>(args)...); }
+
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(stl::true_type, K&& key, Args&&... args)
+        { return this->m_emplace_unique(stl::forward<K>(key), stl::forward<Args>(args)...); }
+
+        /// @brief The key is converted once, then moved into the node if it is new.
+        template <typename K, typename... Args>
+        pair<iterator, bool> m_emplace_key(stl::false_type, K&& key, Args&&... args)
+        {
+            key_type converted(stl::forward<K>(key));
+            return this->m_emplace_unique(stl::move(converted), stl::forward<Args>(args)...);
+        }
+
+        // emplace: a (key, value) pair of arguments and a whole entry are looked up before anything is built;
+        // any other argument list has to build its entry first to learn the key
+
+        template <typename K, typename V>
+        pair<iterator, bool> m_insert(K&& key, V&& value)
+        { return this->m_emplace_key(stl::forward<K>(key), stl::forward<V>(value)); }
+
+        pair<iterator, bool> m_insert(const value_type& node)
+        { return this->m_emplace_unique(node.m_pair.first, node.m_pair.second); }
+
+        pair<iterator, bool> m_insert(value_type& node)
+        { return this->m_emplace_unique(node.m_pair.first, node.m_pair.second); }
+
+        pair<iterator, bool> m_insert(value_type&& node)
+        { return this->m_emplace_unique(stl::move(node.m_pair.first), stl::move(node.m_pair.second)); }
 
         template <typename... Args>
-        iterator m_try_emplace(const_iterator hint, const key_type& key, Args&&... args);
+        pair<iterator, bool> m_insert(Args&&... args)
+        {
+            value_type node(stl::forward<Args>(args)...);
+            return this->m_emplace_unique(stl::move(node.m_pair.first), stl::move(node.m_pair.second));
+        }
     };
+
+    /**
+     * @brief Erases every element for which @c pred returns true in a single pass over the buckets.
+     * @return Number of erased elements
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity, typename Pred>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::size_type 
+    erase_if(unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>& map, Pred pred)
+    {
+        typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::size_type old_size = map.size();
+
+        for (auto it = map.begin(); it != map.end();)
+        {
+            if (pred(*it))
+                it = map.erase(it);
+            else
+                ++it;
+        }
+
+        return old_size - map.size();
+    }
+
+    /**
+     * @brief @c unordered_map for the many maps that only ever hold a handful of entries: the first @c N live inside the
+     *        map object, so such a map allocates nothing at all.
+     */
+    template <
+        typename Key,
+        typename T,
+        stl::size_t N         = 8,
+        typename Hash         = stl::hash<Key>,
+        typename KeyEqual     = stl::equal_to<Key>,
+        typename Allocator    = stl::allocator<stl::pair_node<Key, T>>
+    > using small_unordered_map = unordered_map<Key, T, Hash, KeyEqual, Allocator, stl::power2_rehash_policy, false, N>;
 }
 
 #include "unordered_map.tcc"
\ No newline at end of file
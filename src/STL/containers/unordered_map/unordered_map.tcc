@@ -1,34 +1,31 @@
 namespace stl
 {
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    class unordered_map<Key, T, Hash, KeyEqual, Allocator>::node_type
+    /**
+     * @brief Owner of a node extracted from a map: the entry is neither copied nor moved while it is held, and goes back
+     *        into a map with @c insert(node_type&&). A handle still holding its node destroys it with the map's allocator.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    struct unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::node_type
     {
-        node_type(pair_node<Key, T>* node = nullptr, const Allocator& alloc = Allocator())
-            : m_node(node), m_alloc(alloc) { }
+        typedef Key         key_type;
+        typedef T           mapped_type;
+        typedef Allocator   allocator_type;
+
+        node_type() noexcept
+            : m_node(nullptr), m_alloc() { }
 
         node_type(node_type&& other) noexcept
-            : m_node(other.m_node)
+            : m_node(other.m_node), m_alloc(stl::move(other.m_alloc))
         { other.m_node = nullptr; }
 
         ~node_type()
-        {
-            if (this->m_node != nullptr)
-            {
-                this->m_alloc.destroy(this->m_node);
-                this->m_alloc.deallocate(this->m_node, 1);
-                this->m_node = nullptr;
-            }
-        }
+        { this->m_reset(); }
 
         node_type& operator=(node_type&& other) noexcept
         {
             if (this != &other)
             {
-                if (this->m_node != other.m_node && this->m_node != nullptr)
-                {
-                    this->m_alloc.destroy(this->m_node);
-                    this->m_alloc.deallocate(this->m_node, 1);
-                }
+                this->m_reset();
 
                 this->m_node = other.m_node;
                 this->m_alloc = stl::move(other.m_alloc);
@@ -38,25 +35,65 @@ namespace stl
             return *this;
         }
 
-        const Key& key() const { return this->m_node->m_pair.first; }
+        key_type& key() const { return this->m_node->m_pair.first; }
 
-        T& mapped() { return this->m_node->m_pair.second; }
+        mapped_type& mapped() const { return this->m_node->m_pair.second; }
 
-        bool empty() const { return this->m_node == nullptr; }
+        allocator_type get_allocator() const { return this->m_alloc; }
+
+        bool empty() const noexcept { return this->m_node == nullptr; }
+
+        explicit operator bool() const noexcept { return this->m_node != nullptr; }
+
+        void swap(node_type& other) noexcept
+        {
+            stl::swap(this->m_node, other.m_node);
+            stl::swap(this->m_alloc, other.m_alloc);
+        }
 
     private:
-        pair_node<Key, T>* m_node;
-        Allocator          m_alloc;
+        friend class unordered_map;
+
+        pointer         m_node;
+        allocator_type  m_alloc;
+
+        node_type(pointer node, const allocator_type& alloc)
+            : m_node(node), m_alloc(alloc) { }
 
         node_type(const node_type&) = delete;
-        node_type& operator=(const node_type&) = delete; 
+        node_type& operator=(const node_type&) = delete;
+
+        void m_reset() noexcept
+        {
+            if (this->m_node != nullptr)
+            {
+                this->m_alloc.destroy(this->m_node);
+                this->m_alloc.deallocate(this->m_node, 1);
+                this->m_node = nullptr;
+            }
+        }
+    };
+
+    /// @brief Result of @c insert(node_type&&): where the key is, whether the node went in, and the node if it did not.
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    struct unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::insert_return_type
+    {
+        iterator    position;
+        bool        inserted;
+        node_type   node;
     };
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::clear() noexcept
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::clear() noexcept
     {
+        this->m_finish_rehash();
+
         for (size_type i = 0; i < this->m_capacity; ++i)
         {
+            // empty buckets are not written: the shared bucket of a map without a table must stay untouched
+            if (this->m_table[i] == nullptr)
+                continue;
+
             pointer entry = this->m_table[i];
 
             while (entry != nullptr)
@@ -64,199 +101,347 @@ namespace stl
                 pointer temp = entry;
                 entry = entry->m_next;
 
-                this->m_alloc.destroy(temp);
-                this->m_alloc.deallocate(temp, 1);
+                this->m_release_node(temp);
             }
 
             this->m_table[i] = nullptr;
         }
         
         this->m_size = 0;
+
+        // a pooled node allocator gets its slabs back in one go instead of keeping them for reuse
+        __detail::__release_allocator(this->m_alloc);
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
     template <typename InputIt, typename>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::insert(InputIt first, InputIt last)
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::insert(InputIt first, InputIt last)
     {
-        for (; first != last; ++first)
-            this->insert(*first);
+        this->m_insert_range(first, last, bulk_insert_t<InputIt>());
     }
 
-    /**
-     * Try to improve design
-     */
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator 
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(const_iterator first, const_iterator last)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::insert_return_type
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::insert(node_type&& nh)
     {
-        if (first == last)
-            return iterator(this->m_table, this->m_table + this->m_capacity, last);
+        if (nh.empty())
+            return {this->end(), false, node_type()};
 
-        const_iterator prev;
-        bool is_list_head = true;
+        size_type code;
+        pointer* bucket;
+        pointer prev;
+        pointer entry = this->m_locate(nh.key(), bucket, prev, code);
 
-        for (const_iterator cit = this->cbegin(); cit != this->cend(); ++cit)
-            if (cit.m_current->m_next == first.m_current)
-            {
-                is_list_head = false;
-                prev = cit;
-                break;
-            }
+        if (entry != nullptr)
+            return {this->template m_make_iterator<iterator>(bucket, entry, prev), false, stl::move(nh)};
 
-        if (is_list_head)
-        {
-            size_type hash_value = this->hash(first.m_current->m_pair.first);
-            this->m_table[hash_value] = last.m_current;
-        }
-        else
-            prev.m_current->m_next = last.m_current;
+        const bool in_place = InlineCapacity != 0 && this->m_is_inline();
 
-        const_iterator current = first;
-        while (current != last)
+        // a free inline slot, or a node this allocator cannot free, takes the entry by move: the handle frees the node
+        if ((in_place && this->m_size < InlineCapacity) || nh.m_alloc != this->m_alloc)
         {
-            const_iterator next = current + 1;
-
-            this->m_alloc.destroy(current.m_current);
-            this->m_alloc.deallocate(current.m_current, 1);
+            pointer node = nh.m_node;
+            iterator it = this->m_emplace_new(code, bucket, prev, stl::move(node->m_pair.first), stl::move(node->m_pair.second)).first;
 
-            current = next;
+            nh.m_reset();
+            return {it, true, node_type()};
         }
 
-        return iterator(this->m_table, this->m_table + this->m_capacity, last);
+        if (in_place)
+            code = this->m_hash(nh.key());
+
+        iterator it = this->m_link_node(code, bucket, prev, nh.m_node);
+
+        nh.m_node = nullptr;
+        return {it, true, node_type()};
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(iterator pos)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::merge(unordered_map& source)
     {
-        if (pos.m_current == nullptr)
-            return iterator(this->m_table, this->m_table + this->m_capacity, nullptr);
+        if (&source == this || source.m_size == 0)
+            return;
 
-        size_type hash_value = this->hash(pos.m_current->m_pair.first);
-        pointer entry = this->m_table[hash_value], prev = nullptr;
+        // the source is walked bucket by bucket, so it is first settled on a single table
+        source.m_finish_rehash();
 
-        while (entry != nullptr)
+        const bool relink = this->m_alloc == source.m_alloc;
+
+        for (size_type i = 0; i < source.m_capacity; ++i)
         {
-            if (this->m_key_equal(entry->m_pair.first, pos.m_current->m_pair.first))
+            pointer* link = source.m_table + i;
+
+            while (*link != nullptr)
             {
-                if (prev == nullptr)
-                    this->m_table[hash_value] = entry->m_next;
-                else
-                    prev->m_next = entry->m_next;
+                pointer node = *link;
 
-                this->m_alloc.destroy(entry);
-                this->m_alloc.deallocate(entry, 1);
+                size_type code;
+                pointer* bucket;
+                pointer prev;
 
-                return iterator(this->m_table, this->m_table + this->m_capacity, (prev == nullptr) ? this->m_table[hash_value] : prev->m_next);
-            }
+                if (this->m_locate(node->m_pair.first, bucket, prev, code) != nullptr)
+                {
+                    link = &node->m_next;
+                    continue;
+                }
 
-            prev = entry;
-            entry = entry->m_next;
+                const bool in_place = InlineCapacity != 0 && this->m_is_inline();
+
+                if (!relink || source.m_is_inline() || (in_place && this->m_size < InlineCapacity))
+                {
+                    this->m_emplace_new(code, bucket, prev, stl::move(node->m_pair.first), stl::move(node->m_pair.second));
+
+                    *link = node->m_next;
+                    source.m_release_node(node);
+                }
+                else
+                {
+                    *link = node->m_next;
+
+                    // a node that cannot be linked because the table failed to grow goes back where it was
+                    try
+                    {
+                        this->m_link_node(in_place ? this->m_hash(node->m_pair.first) : code, bucket, prev, node);
+                    }
+                    catch (...)
+                    {
+                        node->m_next = *link;
+                        *link = node;
+                        throw;
+                    }
+                }
+
+                --source.m_size;
+            }
         }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::iterator 
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::erase(const_iterator first, const_iterator last)
+    {
+        iterator it(first.m_bucket_begin, first.m_bucket_end, first.m_current, first.m_prev, first.m_next_begin, first.m_next_end);
 
-        return iterator(this->m_table, this->m_table + this->m_capacity, nullptr);
+        while (it.m_current != last.m_current)
+            it = this->m_erase(it.m_bucket_begin, it.m_prev, it.m_current);
+
+        return it;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    template <typename K>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::size_type
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::erase(K&& x)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::rehash(size_type new_size)
     {
-        pointer entry = this->m_table[this->hash(x)];
+        // an explicit rehash is always done in one step
+        this->m_finish_rehash();
 
-        while (entry != nullptr)
-        {
-            pointer next = entry->m_next;
+        auto start = this->rehash_clock();
+        this->record_rehash();
 
-            if (this->m_key_equal(entry->m_pair.first, stl::forward<K>(x)))
-            {
-                this->erase(iterator(this->m_table, this->m_table + this->m_capacity, entry));
-                return 1;
-            }
+        size_type min_size = static_cast<size_type>(this->m_size / this->m_load_factor) + 1;
 
-            entry = next;
-        }
+        if (new_size < min_size)
+            new_size = min_size;
 
-        return 0;
-    }
+        new_size = RehashPolicy::next_bucket_count(new_size);
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::rehash(size_type new_size)
-    {
         size_type old_cap = this->m_capacity;
         pointer* temp = this->m_get_table(new_size);
 
         for (size_type i = 0; i < new_size; ++i)
             *(temp + i) = nullptr;
 
-        for (size_type i = 0; i < old_cap; ++i)
+        // leaving the inline bucket: its nodes move to the heap, and if that throws the map keeps them as they were
+        if (InlineCapacity != 0 && this->m_is_inline())
         {
-            pointer entry = this->m_table[i];
-
-            while (entry != nullptr)
+            try
             {
-                pointer next = entry->m_next;
-                size_type new_hash = this->hash(entry->m_pair.first);
+                this->m_promote_inline(temp, new_size);
+            }
+            catch (...)
+            {
+                bucket_allocator __alloc = this->m_alloc;
+                __alloc.deallocate(temp, new_size);
+                throw;
+            }
+        }
+        else
+        {
+            for (size_type i = 0; i < old_cap; ++i)
+            {
+                pointer entry = this->m_table[i];
 
-                entry->m_next = temp[new_hash];
-                temp[new_hash] = entry;
-                entry = next;
+                while (entry != nullptr)
+                {
+                    pointer next = entry->m_next;
+                    size_type new_hash = RehashPolicy::bucket_index(this->m_node_hash(entry), new_size);
+
+                    entry->m_next = temp[new_hash];
+                    temp[new_hash] = entry;
+                    entry = next;
+                }
             }
         }
-        
+
         this->m_deallocate_table();
 
         this->m_capacity = new_size;
         this->m_table = temp;
+
+        this->record_rehash_time(start);
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::node_type
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::extract(const key_type& key)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::rehash(const parallel_t& par, size_type new_size)
     {
-        size_type hash_value = this->hash(key);
-        pointer entry = this->m_table[hash_value], prev = nullptr;
+        this->m_finish_rehash();
 
-        while (entry != nullptr)
+        const size_type threads = __detail::__parallel_threads(par, this->m_size + this->m_capacity, __PARALLEL_GRAIN);
+
+        // the inline nodes are too few to share out, and leaving them is the sequential rehash's job
+        if (threads <= 1 || this->m_is_inline())
+            return this->rehash(new_size);
+
+        auto start = this->rehash_clock();
+        this->record_rehash();
+
+        size_type min_size = static_cast<size_type>(this->m_size / this->m_load_factor) + 1;
+
+        if (new_size < min_size)
+            new_size = min_size;
+
+        new_size = RehashPolicy::next_bucket_count(new_size);
+
+        const size_type old_cap = this->m_capacity;
+        const size_type range = (new_size + threads - 1) / threads;     // new buckets linked by each thread
+        pointer* const old_table = this->m_table;
+        pointer* const temp = this->m_get_table(new_size);
+
+        // lists[s * threads + d]: nodes of thread s's old buckets bound for thread d's new ones, chained through m_next
+        stl::vector<pointer> lists(threads * threads, nullptr);
+        pointer* const heads = lists.data();
+
+        __detail::__parallel_run(threads, [&](size_type s)
         {
-            if (this->m_key_equal(entry->m_pair.first, key))
+            pointer* own = heads + s * threads;
+
+            for (size_type i = old_cap * s / threads; i < old_cap * (s + 1) / threads; ++i)
             {
-                if (prev == nullptr)
-                    this->m_table[hash_value] = entry->m_next;
-                else
-                    prev->m_next = entry->m_next;
-                
-                entry->m_next = nullptr;
-                --this->m_size;
-                
-                return node_type(entry, this->m_alloc);
+                pointer entry = old_table[i];
+
+                while (entry != nullptr)
+                {
+                    pointer next = entry->m_next;
+                    size_type d = RehashPolicy::bucket_index(this->m_node_hash(entry), new_size) / range;
+
+                    entry->m_next = own[d];
+                    own[d] = entry;
+                    entry = next;
+                }
             }
+        });
 
-            prev = entry;
-            entry = entry->m_next;
+        __detail::__parallel_run(threads, [&](size_type d)
+        {
+            const size_type last = (d + 1) * range < new_size ? (d + 1) * range : new_size;
+
+            for (size_type b = d * range; b < last; ++b)
+                temp[b] = nullptr;
+
+            for (size_type s = 0; s < threads; ++s)
+            {
+                pointer entry = heads[s * threads + d];
+
+                while (entry != nullptr)
+                {
+                    pointer next = entry->m_next;
+                    size_type new_hash = RehashPolicy::bucket_index(this->m_node_hash(entry), new_size);
+
+                    entry->m_next = temp[new_hash];
+                    temp[new_hash] = entry;
+                    entry = next;
+                }
+            }
+        });
+
+        this->m_deallocate_table();
+
+        this->m_capacity = new_size;
+        this->m_table = temp;
+
+        this->record_rehash_time(start);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    table_stats unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::stats() const
+    {
+        table_stats stats;
+
+        stats.size = this->m_size;
+        stats.bucket_count = this->m_capacity;
+        stats.max_chain = 0;
+
+        for (size_type i = 0; i < table_stats::__HISTOGRAM_SIZE; ++i)
+            stats.chain_histogram[i] = 0;
+
+        for (size_type i = 0; i < this->m_capacity; ++i)
+        {
+            size_type length = 0;
+
+            for (pointer entry = *this->m_local_bucket(i); entry != nullptr; entry = entry->m_next)
+                ++length;
+
+            ++stats.chain_histogram[length < table_stats::__HISTOGRAM_SIZE ? length : table_stats::__HISTOGRAM_SIZE - 1];
+
+            if (length > stats.max_chain)
+                stats.max_chain = length;
         }
 
-        return node_type();
+        // the inline bucket is part of the map object
+        stats.bucket_bytes = this->m_is_inline() ? 0 : (this->m_capacity + this->m_old_capacity) * sizeof(pointer);
+        stats.node_bytes = this->m_size * sizeof(value_type);
+
+        this->fill_stats(stats);
+
+        return stats;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    /// @c private_members
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
     template <typename K>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::node_type
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::extract(K&& x)
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::node_type
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_extract(const K& key)
     {
-        size_type hash_value = this->hash(x);
-        pointer entry = this->m_table[hash_value], prev = nullptr;
+        // inline nodes carry no hash code yet, so the inline chain is walked on keys alone
+        const bool in_place = InlineCapacity != 0 && this->m_is_inline();
+
+        size_type code = in_place ? 0 : this->m_hash(key);
+        pointer* bucket = in_place ? this->m_table : this->m_bucket_for(code);
+        pointer entry = *bucket, prev = nullptr;
 
         while (entry != nullptr)
         {
-            if (this->m_key_equal(entry->m_next.first, stl::forward<K>(x)))
+            if (in_place ? this->m_key_equal(entry->m_pair.first, key) : this->m_node_equals(entry, key, code))
             {
+                // a node handle gives its node back to the allocator, so an inline node leaves as a heap node,
+                // built before anything is unlinked
+                pointer node = in_place ? this->m_promote_node(entry) : entry;
+
                 if (prev == nullptr)
-                    this->m_table[hash_value] = entry->m_next;
+                    *bucket = entry->m_next;
                 else
                     prev->m_next = entry->m_next;
+                
+                --this->m_size;
+
+                if (in_place)
+                {
+                    entry->~value_type();
+                    this->inline_release(entry);
+                }
 
-                return node_type(entry);
+                node->m_next = nullptr;
+                return node_type(node, this->m_alloc);
             }
 
             prev = entry;
@@ -266,156 +451,776 @@ namespace stl
         return node_type();
     }
 
-    /// @c private_members
+    /**
+     * Three stage pipeline over the keys, each stage D = @c __PREFETCH_DISTANCE keys behind the previous one:
+     * hash key @c i and prefetch its bucket, load the chain head of key @c i - D and prefetch the node, then walk the chain
+     * of key @c i - 2D. A key's lines have been requested D iterations before they are needed, in time for the miss to resolve.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename Emit>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_find_nodes(const key_type* keys, size_type count, Emit emit) const
+    {
+        // nothing to prefetch on the inline bucket
+        if (InlineCapacity != 0 && this->m_is_inline())
+        {
+            for (size_type k = 0; k < count; ++k)
+            {
+                pointer entry = this->m_inline_find(keys[k]);
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::pointer*
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_get_table(const size_type bucket_count)
+                this->record_find(entry != nullptr, entry != nullptr);
+                emit(k, this->m_table, nullptr, entry);
+            }
+
+            return;
+        }
+
+        constexpr size_type __ring = 4 * __PREFETCH_DISTANCE;   // power of two holding the 2D + 1 keys in flight
+
+        size_type codes[__ring];
+        pointer* buckets[__ring];
+        pointer heads[__ring];
+
+        for (size_type i = 0; i < count + 2 * __PREFETCH_DISTANCE; ++i)
+        {
+            if (i < count)
+            {
+                size_type slot = i & (__ring - 1);
+
+                codes[slot] = this->m_hash(keys[i]);
+                buckets[slot] = this->m_bucket_for(codes[slot]);
+                __detail::__prefetch(buckets[slot]);
+            }
+
+            if (i >= __PREFETCH_DISTANCE && i - __PREFETCH_DISTANCE < count)
+            {
+                size_type slot = (i - __PREFETCH_DISTANCE) & (__ring - 1);
+
+                heads[slot] = *buckets[slot];
+
+                if (heads[slot] != nullptr)
+                    __detail::__prefetch(heads[slot]);
+            }
+
+            if (i >= 2 * __PREFETCH_DISTANCE)
+            {
+                size_type k = i - 2 * __PREFETCH_DISTANCE;
+                size_type slot = k & (__ring - 1);
+                pointer entry = heads[slot], prev = nullptr;
+
+                size_type probes = 0;
+
+                while (entry != nullptr && !this->m_node_equals(entry, keys[k], codes[slot]))
+                {
+                    ++probes;
+                    prev = entry;
+                    entry = entry->m_next;
+                }
+
+                this->record_find(probes + (entry != nullptr), entry != nullptr);
+                emit(k, buckets[slot], prev, entry);
+            }
+        }
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::pointer*
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_get_table(const size_type bucket_count)
     {
         bucket_allocator __alloc = this->m_alloc;
         pointer* __temp = __alloc.allocate(bucket_count);
         return __temp; 
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::pointer
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_get_node(key_type&& key, mapped_type&& value)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename K, typename... Args>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::pointer
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_get_node(size_type code, K&& key, Args&&... args)
+    {
+        if (InlineCapacity != 0 && this->m_is_inline())
+        {
+            // a slot is only committed once its entry is built, so a throwing constructor leaves it free
+            pointer __new_node = this->inline_acquire();
+
+            new (__new_node) stl::pair_node<key_type, mapped_type>(__detail::__emplace_second_t(), stl::forward<K>(key), stl::forward<Args>(args)...);
+            this->inline_commit(__new_node);
+
+            return __new_node;
+        }
+
+        return this->m_get_heap_node(code, stl::forward<K>(key), stl::forward<Args>(args)...);
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename K, typename... Args>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::pointer
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_get_heap_node(size_type code, K&& key, Args&&... args)
     {
         pointer __new_node = this->m_alloc.allocate(1);
 
-        new (__new_node) stl::pair_node<key_type, mapped_type>(stl::forward<key_type>(key), stl::forward<mapped_type>(value));
-        __new_node->m_next = nullptr;
+        try
+        {
+            new (__new_node) stl::pair_node<key_type, mapped_type>(__detail::__emplace_second_t(), stl::forward<K>(key), stl::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            this->m_alloc.deallocate(__new_node, 1);
+            throw;
+        }
+
+        __new_node->set_hash_code(code);
 
         return __new_node;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_default_initialize(const size_type bucket_count)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::pointer
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_promote_node(pointer node)
     {
-        this->m_capacity = bucket_count;
-        this->m_table = this->m_get_table(bucket_count);
+        size_type code = this->m_hash(node->m_pair.first);
+        return this->m_get_heap_node(code, this->m_promoted(node->m_pair.first), this->m_promoted(node->m_pair.second));
+    }
 
-        for (size_type i = 0; i < bucket_count; ++i)
+    /**
+     * Every inline node gets its heap node before any of them is released: all the keys are hashed and all the nodes
+     * allocated first, then the entries are moved over, or copied when a move could throw. Whatever throws, the inline
+     * nodes are left as they were and the heap nodes built so far are freed.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_promote_inline(pointer* table, size_type bucket_count)
+    {
+        constexpr size_type __slots = InlineCapacity != 0 ? InlineCapacity : 1;
+
+        size_type codes[__slots];
+        pointer nodes[__slots];
+        size_type allocated = 0, built = 0;
+
+        try
+        {
+            for (pointer entry = *this->m_table; entry != nullptr; entry = entry->m_next, ++allocated)
+            {
+                codes[allocated] = this->m_hash(entry->m_pair.first);
+                nodes[allocated] = this->m_alloc.allocate(1);
+            }
+
+            for (pointer entry = *this->m_table; entry != nullptr; entry = entry->m_next, ++built)
+                new (nodes[built]) stl::pair_node<key_type, mapped_type>(__detail::__emplace_second_t(), this->m_promoted(entry->m_pair.first), this->m_promoted(entry->m_pair.second));
+        }
+        catch (...)
+        {
+            for (size_type i = 0; i < allocated; ++i)
+            {
+                if (i < built)
+                    this->m_alloc.destroy(nodes[i]);
+
+                this->m_alloc.deallocate(nodes[i], 1);
+            }
+
+            throw;
+        }
+
+        pointer entry = *this->m_table;
+
+        for (size_type i = 0; i < built; ++i)
+        {
+            pointer next = entry->m_next;
+            size_type index = RehashPolicy::bucket_index(codes[i], bucket_count);
+
+            nodes[i]->set_hash_code(codes[i]);
+            nodes[i]->m_next = table[index];
+            table[index] = nodes[i];
+
+            entry->~value_type();
+            entry = next;
+        }
+
+        this->inline_reset();
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_default_initialize(const size_type bucket_count)
+    {
+        this->m_capacity = RehashPolicy::next_bucket_count(bucket_count);
+        this->m_table = this->m_get_table(this->m_capacity);
+
+        for (size_type i = 0; i < this->m_capacity; ++i)
             *(this->m_table + i) = nullptr;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_deallocate_table()
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_deallocate_table()
     {
-        bucket_allocator __alloc = this->m_alloc;
-        __alloc.deallocate(this->m_table, this->m_capacity);
+        if (!this->m_is_inline())
+        {
+            bucket_allocator __alloc = this->m_alloc;
+            __alloc.deallocate(this->m_table, this->m_capacity);
+        }
+
         this->m_table = nullptr;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_destroy_table()
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_destroy_table()
     {
         this->clear();
         this->m_deallocate_table();
         this->m_capacity = 0;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
     template <typename InputIt>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_range_initialize(InputIt first, InputIt last, size_type bucket_count)
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_range_initialize(InputIt first, InputIt last, size_type bucket_count)
     {
-        this->m_default_initialize(bucket_count);
-        
-        for (; first != last; ++first)
-            this->insert(*first);
+        this->m_table_initialize(bucket_count);
+        this->insert(first, last);
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_range_initialize(const_iterator first, const_iterator last, size_type bucket_count)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_copy_from(const unordered_map& other)
     {
-        this->m_default_initialize(bucket_count);
+        if (other.m_size <= InlineCapacity)
+            this->m_inline_initialize();
+        else
+            this->m_default_initialize(other.m_capacity);
 
-        for (; first != last; ++first)
-            this->insert(first.m_current);
+        for (const_iterator it = other.cbegin(); it != other.cend(); ++it)
+            this->insert(*it.m_current);
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    void unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_check_rehash(size_type t_size, size_type b_size, float load_factor)
+    /**
+     * A table changes owner by its pointers. Inline nodes cannot: they are moved one by one into this map's own slots,
+     * in chain order, and destroyed in @c other.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_move_from(unordered_map& other)
     {
-        if (static_cast<float>(t_size) / b_size > load_factor)
+        if (other.m_is_inline())
         {
-            size_type new_cap = this->m_capacity + this->m_capacity / 2 + 1;
-            this->rehash(new_cap);
+            this->m_inline_initialize();
+
+            pointer* link = this->m_table;
+
+            for (pointer entry = *other.m_table, next; entry != nullptr; entry = next)
+            {
+                next = entry->m_next;
+
+                *link = this->m_get_node(0, stl::move(entry->m_pair.first), stl::move(entry->m_pair.second));
+                link = &(*link)->m_next;
+
+                entry->~value_type();
+            }
+
+            this->m_size = other.m_size;
+
+            other.inline_reset();
+            other.m_size = 0;
+            return;
         }
+
+        this->m_table = other.m_table;
+        this->m_size = other.m_size;
+        this->m_capacity = other.m_capacity;
+        this->m_old_table = other.m_old_table;
+        this->m_old_capacity = other.m_old_capacity;
+        this->m_migrate_pos = other.m_migrate_pos;
+
+        other.m_inline_initialize();
+        other.m_size = other.m_old_capacity = other.m_migrate_pos = 0;
+        other.m_old_table = nullptr;
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    template <typename... Args>
-    pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_insert(Args&&... args)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_check_rehash(size_type t_size, size_type b_size, float load_factor)
     {
-        // check the load factor to see if the hash table needs resizing.
-        this->m_check_rehash(this->m_size, this->m_capacity, this->m_load_factor);
-        
-        // construct the node using perfect forwarding 
-        stl::pair_node<key_type, mapped_type> node(stl::forward<Args>(args)...);
+        // past the inline bucket the map moves to a real table in one step, whatever the policy
+        if (this->m_is_inline())
+        {
+            if (t_size >= InlineCapacity)
+                this->rehash(__DEFAULT_BUCKET_SIZE);
+
+            return;
+        }
+
+        if (static_cast<float>(t_size) / b_size <= load_factor)
+            return;
+
+        if (RehashPolicy::migrate_buckets != 0 && this->m_capacity != 0)
+            this->m_begin_incremental_rehash(this->m_capacity * 2);
+        else
+            this->rehash(RehashPolicy::next_bucket_count(this->m_capacity * 2));
+    }
+
+    /**
+     * The current table becomes the old table and a table of twice the size is allocated; nothing is moved yet.
+     * Old bucket @c i splits into new buckets @c i and @c i + old_count only, which is why this requires a power-of-two policy.
+     * The new buckets start empty and are only filled when their source bucket is migrated.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_begin_incremental_rehash(size_type new_size)
+    {
+        this->m_finish_rehash();
+        this->record_rehash();
+
+        pointer* temp = this->m_get_table(new_size);
 
-        key_type key = node.m_pair.first;
-        mapped_type value = node.m_pair.second;
+        // the new buckets are live from now on, for iterators and bucket scans too, while only migration fills them
+        for (size_type i = 0; i < new_size; ++i)
+            temp[i] = nullptr;
+
+        this->m_old_table = this->m_table;
+        this->m_old_capacity = this->m_capacity;
+        this->m_migrate_pos = 0;
 
-        size_type hash_value = this->hash(key);
-    
-        pointer prev = nullptr; // Keeps track of the last found pair in the forward list when the while is terminated              
-        pointer entry = *(this->m_table + hash_value); // select the entry point for the forward list
+        this->m_table = temp;
+        this->m_capacity = new_size;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_migrate_buckets(size_type count)
+    {
+        auto start = this->rehash_clock();
+        size_type last = this->m_migrate_pos + count;
 
-        // transverse the forward list to the end while looking for the key
-        while (entry != nullptr && !this->m_key_equal(entry->m_pair.first, key))
+        if (last > this->m_old_capacity)
+            last = this->m_old_capacity;
+
+        for (size_type i = this->m_migrate_pos; i < last; ++i)
         {
-            prev = entry;
-            entry = entry->m_next;
+            pointer entry = this->m_old_table[i];
+
+            while (entry != nullptr)
+            {
+                pointer next = entry->m_next;
+                size_type new_hash = RehashPolicy::bucket_index(this->m_node_hash(entry), this->m_capacity);
+
+                entry->m_next = this->m_table[new_hash];
+                this->m_table[new_hash] = entry;
+                entry = next;
+            }
         }
 
-        // if the entry is null that means the end of the list was reached and the key was not found
+        this->m_migrate_pos = last;
+
+        if (last == this->m_old_capacity)
+        {
+            bucket_allocator __alloc = this->m_alloc;
+            __alloc.deallocate(this->m_old_table, this->m_old_capacity);
+
+            this->m_old_table = nullptr;
+            this->m_old_capacity = this->m_migrate_pos = 0;
+        }
+
+        this->record_rehash_time(start);
+    }
+
+    /**
+     * The position comes from an iterator and is trusted when it still holds: @c bucket is live and @c node follows @c prev
+     * (or heads @c bucket). Otherwise, e.g. after an incremental rehash step moved the chain, the node is looked up again.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::iterator
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_erase(pointer* bucket, pointer prev, pointer node)
+    {
+        pointer* bucket_end = this->m_bucket_end(bucket);
+        pointer* link = prev != nullptr ? &prev->m_next : bucket;
+
+        if (bucket_end == nullptr || *link != node)
+        {
+            bucket = this->m_is_inline() ? this->m_table : this->m_bucket_for(this->m_node_hash(node));
+            prev = nullptr;
+            link = bucket;
+
+            while (*link != node)
+            {
+                prev = *link;
+                link = &prev->m_next;
+            }
+        }
+
+        *link = node->m_next;
+
+        iterator next = this->template m_make_iterator<iterator>(bucket, node->m_next, prev);
+        next.m_skip_empty_buckets();
+
+        this->m_release_node(node);
+        --this->m_size;
+
+        return next;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename K>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::size_type
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_erase_key(const K& key)
+    {
+        pointer* bucket;
+        pointer prev;
+        pointer entry = this->m_locate(key, bucket, prev);
+
         if (entry == nullptr)
+            return 0;
+
+        // only a count is returned, so unlike erase(pos) no iterator to the next entry is built; the inline nodes are
+        // matched without walking their chain, which leaves their predecessor to be found here
+        pointer* link = prev != nullptr ? &prev->m_next : bucket;
+
+        while (*link != entry)
+            link = &(*link)->m_next;
+
+        *link = entry->m_next;
+
+        this->m_release_node(entry);
+        --this->m_size;
+
+        return 1;
+    }
+
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename InputIt>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_insert_range(InputIt first, InputIt last, stl::false_type)
+    {
+        for (; first != last; ++first)
+            this->insert(*first);
+    }
+
+    /**
+     * The table is grown once for the whole range, then the range is walked twice: the first pass hashes every key and counts
+     * the keys falling in each slice of @c __BULK_PARTITION buckets, the second sorts the entries by slice (stably, so the
+     * first of equal keys still comes first). Linking then proceeds slice by slice: the buckets being written stay in cache,
+     * the entries are read with prefetching, since their order is known in advance, and the nodes of a slice are adjacent in
+     * memory, ready for the lookups that will walk them.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename ForwardIt>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_insert_range(ForwardIt first, ForwardIt last, stl::true_type)
+    {
+        size_type count = static_cast<size_type>(stl::distance(first, last));
+
+        if (count == 0)
+            return;
+
+        // a range that still fits the inline nodes is not worth sorting
+        if (InlineCapacity != 0 && this->m_is_inline() && this->m_size + count <= InlineCapacity)
+            return this->m_insert_range(first, last, stl::false_type());
+
+        size_type needed = static_cast<size_type>((this->m_size + count) / this->m_load_factor) + 1;
+
+        if (this->m_is_inline() || this->m_capacity < needed)
+            this->rehash(needed);
+        else
+            this->m_finish_rehash();
+
+        const size_type buckets = this->m_capacity;
+        const size_type partitions = (buckets + __BULK_PARTITION - 1) / __BULK_PARTITION;
+
+        stl::vector<size_type> codes;
+        stl::vector<size_type> offsets(partitions + 1, static_cast<size_type>(0));
+
+        codes.reserve(count);
+
+        for (ForwardIt it = first; it != last; ++it)
         {
-            // create a new pair for the new element
-            entry = this->m_get_node(stl::move(key), stl::move(value));
-            
-            // if prev is null that means the entry was null from the begining and there
-            // is not a list currently at that specific hash value. Therefore that bucket is assigned the address of the entry
-            if (prev == nullptr)
-                this->m_table[hash_value] = entry;
-            else
-                 // if prev != null that means that there is a list at the hash value and the entry is added at the back of this list
-                prev->m_next = entry;
-
-            // m_size gets incremented for each entry
-            ++this->m_size;
+            size_type code = this->m_hash((*it).m_pair.first);
+
+            codes.push_back(code);
+            ++offsets.data()[RehashPolicy::bucket_index(code, buckets) / __BULK_PARTITION + 1];
+        }
+
+        for (size_type p = 1; p <= partitions; ++p)
+            offsets.data()[p] += offsets.data()[p - 1];
+
+        stl::vector<const value_type*> sources(count, nullptr);
+        stl::vector<size_type> sorted_codes(count, static_cast<size_type>(0));
+        size_type i = 0;
+
+        for (ForwardIt it = first; it != last; ++it, ++i)
+        {
+            size_type code = codes.data()[i];
+            size_type slot = offsets.data()[RehashPolicy::bucket_index(code, buckets) / __BULK_PARTITION]++;
+
+            sources.data()[slot] = &*it;
+            sorted_codes.data()[slot] = code;
+        }
+
+        // nodes come from one block when the allocator allows it; keys already present leave theirs unused
+        pointer run = __detail::__allocate_contiguous(this->m_alloc, count);
+        size_type used = 0;
+        pointer pending = nullptr;
+
+        try
+        {
+            for (size_type j = 0; j < count; ++j)
+            {
+                if (j + __PREFETCH_DISTANCE < count)
+                    __detail::__prefetch(sources.data()[j + __PREFETCH_DISTANCE]);
+
+                const value_type& entry = *sources.data()[j];
+                size_type code = sorted_codes.data()[j];
+                pointer* bucket = this->m_table + RehashPolicy::bucket_index(code, buckets);
+                pointer prev = nullptr, node = *bucket;
+
+                while (node != nullptr && !this->m_node_equals(node, entry.m_pair.first, code))
+                {
+                    prev = node;
+                    node = node->m_next;
+                }
+
+                if (node != nullptr)
+                    continue;
+
+                pending = run != nullptr ? run + used : this->m_alloc.allocate(1);
+                new (pending) stl::pair_node<key_type, mapped_type>(entry.m_pair.first, entry.m_pair.second);
+
+                node = pending;
+                pending = nullptr;
+                node->set_hash_code(code);
+
+                if (prev == nullptr)
+                    *bucket = node;
+                else
+                    prev->m_next = node;
+
+                ++this->m_size;
+                ++used;
+            }
+        }
+        catch (...)
+        {
+            if (run == nullptr && pending != nullptr)
+                this->m_alloc.deallocate(pending, 1);
+
+            for (; run != nullptr && used < count; ++used)
+                this->m_alloc.deallocate(run + used, 1);
+
+            throw;
+        }
+
+        for (; run != nullptr && used < count; ++used)
+            this->m_alloc.deallocate(run + used, 1);
+    }
 
-            return {iterator(this->m_table, this->m_table + this->m_capacity, entry), true};
+    /**
+     * The sequential bulk build with each pass split between the threads. Thread t hashes the t-th share of the range and
+     * counts its keys per slice; the counts are laid out slice by slice, thread by thread within a slice, so the scatter that
+     * follows keeps the range order (the first of equal keys still wins) without any thread waiting on another. Each thread
+     * then links a contiguous run of slices, i.e. of buckets no other thread touches, the node of sorted entry j being slot j
+     * of the block when the allocator hands one out. An allocator that neither hands out blocks nor allows concurrent calls
+     * gets the linking done on the calling thread.
+     */
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename ForwardIt>
+    void unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_insert_range(const parallel_t& par, ForwardIt first, ForwardIt last, stl::true_type)
+    {
+        size_type count = static_cast<size_type>(stl::distance(first, last));
+        const size_type threads = __detail::__parallel_threads(par, count, __PARALLEL_GRAIN);
+
+        if (threads <= 1 || (InlineCapacity != 0 && this->m_is_inline() && this->m_size + count <= InlineCapacity))
+            return this->m_insert_range(first, last, stl::true_type());
+
+        size_type needed = static_cast<size_type>((this->m_size + count) / this->m_load_factor) + 1;
+
+        if (this->m_is_inline() || this->m_capacity < needed)
+            this->rehash(par, needed);
+        else
+            this->m_finish_rehash();
+
+        const size_type buckets = this->m_capacity;
+        const size_type partitions = (buckets + __BULK_PARTITION - 1) / __BULK_PARTITION;
+
+        stl::vector<const value_type*> items(count, nullptr);
+        stl::vector<size_type> codes(count, static_cast<size_type>(0));
+        stl::vector<size_type> offsets(partitions * threads + 1, static_cast<size_type>(0));   // [p * threads + t]
+        stl::vector<const value_type*> sources(count, nullptr);
+        stl::vector<size_type> sorted_codes(count, static_cast<size_type>(0));
+        stl::vector<size_type> inserted(threads, static_cast<size_type>(0));
+
+        const value_type** item = items.data();
+        size_type* code = codes.data();
+        size_type* offset = offsets.data();
+        const value_type** source = sources.data();
+        size_type* sorted_code = sorted_codes.data();
+
+        size_type i = 0;
+        for (ForwardIt it = first; it != last; ++it, ++i)
+            item[i] = &*it;
+
+        // counts go one slot ahead of their (slice, thread) cell, so the running sum leaves each cell on its first entry
+        __detail::__parallel_run(threads, [&](size_type t)
+        {
+            for (size_type k = count * t / threads; k < count * (t + 1) / threads; ++k)
+            {
+                code[k] = this->m_hash(item[k]->m_pair.first);
+                ++offset[RehashPolicy::bucket_index(code[k], buckets) / __BULK_PARTITION * threads + t + 1];
+            }
+        });
+
+        for (size_type c = 1; c <= partitions * threads; ++c)
+            offset[c] += offset[c - 1];
+
+        // a slice's entries start where its first cell does: kept before the scatter moves the cells on
+        stl::vector<size_type> slice_begin(partitions + 1, count);
+
+        for (size_type p = 0; p < partitions; ++p)
+            slice_begin.data()[p] = offset[p * threads];
+
+        __detail::__parallel_run(threads, [&](size_type t)
+        {
+            for (size_type k = count * t / threads; k < count * (t + 1) / threads; ++k)
+            {
+                size_type slot = offset[RehashPolicy::bucket_index(code[k], buckets) / __BULK_PARTITION * threads + t]++;
+
+                source[slot] = item[k];
+                sorted_code[slot] = code[k];
+            }
+        });
+
+        // nodes come from one block, or from the allocator on every linking thread if it allows it, else on this thread alone;
+        // a linked entry clears its source, so the block slots left over are those whose source is still set
+        pointer run = __detail::__allocate_contiguous(this->m_alloc, count);
+        const size_type linkers = run != nullptr || __detail::__concurrent_allocator<Allocator>::value ? threads : 1;
+
+        try
+        {
+            __detail::__parallel_run(linkers, [&](size_type t)
+            {
+                const size_type* begin = slice_begin.data();
+                size_type linked = 0;
+                pointer pending = nullptr;
+
+                try
+                {
+                    for (size_type j = begin[partitions * t / linkers]; j < begin[partitions * (t + 1) / linkers]; ++j)
+                    {
+                        const value_type& entry = *source[j];
+                        size_type hash_code = sorted_code[j];
+                        pointer* bucket = this->m_table + RehashPolicy::bucket_index(hash_code, buckets);
+                        pointer prev = nullptr, node = *bucket;
+
+                        while (node != nullptr && !this->m_node_equals(node, entry.m_pair.first, hash_code))
+                        {
+                            prev = node;
+                            node = node->m_next;
+                        }
+
+                        if (node != nullptr)
+                            continue;
+
+                        pending = run != nullptr ? run + j : this->m_alloc.allocate(1);
+                        new (pending) stl::pair_node<key_type, mapped_type>(entry.m_pair.first, entry.m_pair.second);
+
+                        node = pending;
+                        pending = nullptr;
+                        node->set_hash_code(hash_code);
+
+                        if (prev == nullptr)
+                            *bucket = node;
+                        else
+                            prev->m_next = node;
+
+                        source[j] = nullptr;
+                        ++linked;
+                    }
+                }
+                catch (...)
+                {
+                    if (run == nullptr && pending != nullptr)
+                        this->m_alloc.deallocate(pending, 1);
+
+                    inserted.data()[t] = linked;
+                    throw;
+                }
+
+                inserted.data()[t] = linked;
+            });
         }
+        catch (...)
+        {
+            for (size_type t = 0; t < threads; ++t)
+                this->m_size += inserted.data()[t];
+
+            for (size_type j = 0; run != nullptr && j < count; ++j)
+                if (source[j] != nullptr)
+                    this->m_alloc.deallocate(run + j, 1);
+
+            throw;
+        }
+
+        for (size_type t = 0; t < threads; ++t)
+            this->m_size += inserted.data()[t];
 
-        return {iterator(this->m_table, this->m_table + this->m_capacity, entry), false};
+        for (size_type j = 0; run != nullptr && j < count; ++j)
+            if (source[j] != nullptr)
+                this->m_alloc.deallocate(run + j, 1);
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    template <typename... Args>
-    pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator, bool>
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_try_emplace(const key_type& key, Args&&... args)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    template <typename K, typename... Args>
+    pair<typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::iterator, bool>
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_emplace_new(size_type code, pointer* bucket, pointer prev, K&& key, Args&&... args)
     {
-        iterator it = this->find(key);
+        // on the inline bucket the key was not hashed: the inline nodes are matched on keys alone
+        const bool in_place = InlineCapacity != 0 && this->m_is_inline();
+        pointer entry;
+
+        // an inline node goes to the front of the inline chain
+        if (in_place && this->m_size < InlineCapacity)
+        {
+            entry = this->m_get_node(0, stl::forward<K>(key), stl::forward<Args>(args)...);
+            entry->m_next = *bucket;
+            *bucket = entry;
+            ++this->m_size;
+
+            return {this->template m_make_iterator<iterator>(bucket, entry, nullptr), true};
+        }
+
+        // a full inline bucket is left for the heap, where every node carries its hash
+        if (in_place)
+            code = this->m_hash(key);
 
-        if (it != this->end())
-            return {it, false};
+        // the node is built before the table grows, then appended to its chain
+        entry = this->m_get_heap_node(code, stl::forward<K>(key), stl::forward<Args>(args)...);
 
-        return this->emplace(key, mapped_type(stl::forward<Args>(args)...));
+        try
+        {
+            return {this->m_link_node(code, bucket, prev, entry), true};
+        }
+        catch (...)
+        {
+            this->m_alloc.destroy(entry);
+            this->m_alloc.deallocate(entry, 1);
+            throw;
+        }
     }
 
-    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
-    template <typename... Args>
-    typename unordered_map<Key, T, Hash, KeyEqual, Allocator>::iterator
-    unordered_map<Key, T, Hash, KeyEqual, Allocator>::m_try_emplace(const_iterator hint, const key_type& key, Args&&... args)
+    template <typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator, typename RehashPolicy, bool CollectStats, stl::size_t InlineCapacity>
+    typename unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::iterator
+    unordered_map<Key, T, Hash, KeyEqual, Allocator, RehashPolicy, CollectStats, InlineCapacity>::m_link_node(size_type code, pointer* bucket, pointer prev, pointer node)
     {
-        iterator it = this->find(key);
+        pointer* table = this->m_table;
+
+        // an incremental rehash only moves on when an entry goes in, never under the iterators of lookups and erasures
+        this->m_migrate_step();
+        this->m_check_rehash(this->m_size, this->m_capacity, this->m_load_factor);
+
+        // the lookup ended on the tail of the chain, unless growing the table or migrating its bucket has since moved it
+        if (this->m_table != table || this->m_bucket_end(bucket) == nullptr)
+        {
+            bucket = this->m_bucket_for(code);
+            prev = nullptr;
+
+            for (pointer entry = *bucket; entry != nullptr; entry = entry->m_next)
+                prev = entry;
+        }
+
+        node->set_hash_code(code);
+        node->m_next = nullptr;
+
+        if (prev == nullptr)
+            *bucket = node;
+        else
+            prev->m_next = node;
 
-        if (it != this->end())
-            return iterator(this->m_table, this->m_table + this->m_capacity, nullptr);
+        ++this->m_size;
 
-        return this->emplace_hint(hint, key, mapped_type(stl::forward<Args>(args)...));
+        return this->template m_make_iterator<iterator>(bucket, node, prev);
     }
 }
\ No newline at end of file
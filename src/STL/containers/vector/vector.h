@@ -53,12 +53,13 @@ namespace stl
             : m_alloc(alloc), m_capacity(ilist.size()), m_size(ilist.size()), m_data(nullptr)
         { this->m_range_initialize(ilist.begin(), ilist.end()); }
 
+        // a copy allocates only the elements it holds, so its capacity is its size
         vector(const vector& other) 
-            : m_alloc(allocator_traits::select_on_container_copy_construction(other.m_alloc)), m_size(other.m_size), m_capacity(other.m_capacity), m_data(nullptr) 
+            : m_alloc(allocator_traits::select_on_container_copy_construction(other.m_alloc)), m_size(other.m_size), m_capacity(other.m_size), m_data(nullptr) 
         { this->m_range_initialize(other.cbegin(), other.cend()); }
 
         vector(const vector& other, const Allocator& alloc) 
-            : m_alloc(alloc), m_size(other.size()), m_capacity(other.capcacity()), m_data(nullptr)
+            : m_alloc(alloc), m_size(other.size()), m_capacity(other.size()), m_data(nullptr)
         { this->m_range_initialize(other.cbegin(), other.cend()); }
 
         ~vector() 
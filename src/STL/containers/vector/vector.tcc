@@ -29,11 +29,11 @@ namespace stl
             this->m_capacity = count;
         }
 
-        if (count > 0)
-        {
-            this->m_size = count;
-            this->m_default_initialize(count, value);
-        }
+        // the storage is in place by now; m_default_initialize would allocate it a second time
+        for (size_type i = 0; i < count; ++i)
+            this->m_alloc.construct(this->m_data + i, value);
+
+        this->m_size = count;
     }
 
     template <typename T, typename Allocator>
@@ -41,7 +41,10 @@ namespace stl
     void vector<T, Allocator>::assign(InputIt first, InputIt last)
     {
         if (first == last) 
+        {
+            this->clear();
             return;
+        }
 
         difference_type size = stl::distance(first, last);
 
@@ -88,8 +91,12 @@ namespace stl
 
         value_type *temp = this->m_alloc.allocate(new_cap);
 
+        // memcpy must not be handed a null source, even for zero bytes
         if (stl::is_trivially_copyable<value_type>::value)
-            std::memcpy(temp, this->m_data, this->m_size * sizeof(value_type));
+        {
+            if (this->m_data != nullptr)
+                std::memcpy(temp, this->m_data, this->m_size * sizeof(value_type));
+        }
         else
         {
             for (size_type i = 0; i < this->m_size; ++i)
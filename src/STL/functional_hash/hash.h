@@ -1,7 +1,15 @@
 #pragma once
 
 #include "../traits/type_traits.h"
+#include "../../cUtility/stl_pair.h"
 #include "hash_bytes.h"
+#include "hash_policy.h"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
 
 namespace stl
 {
@@ -18,6 +26,12 @@ namespace stl
     template <typename Key>
     struct hash;
 
+    // Keyed counterpart of hash, see seeded_hash.h.
+    struct sip_key;
+
+    template <typename Key>
+    struct seeded_hash;
+
     // Partial specializations for pointer types.
     template <typename T>
     struct hash<T*> : public hash_base<size_t, T*>
@@ -29,14 +43,14 @@ namespace stl
     };
 
     // Explicit specializations for integer types.
-    #define cxx_hashtable_define_trivial_hash(T)  \
-    template <>                                   \
-    struct hash<T> : public hash_base<size_t, T>  \
-    {                                             \
-        size_t operator()(T value) const noexcept \
-        {                                         \
-            return static_cast<size_t>(value);    \
-        }                                         \
+    #define cxx_hashtable_define_trivial_hash(T)            \
+    template <>                                             \
+    struct hash<T> : public hash_base<size_t, T>            \
+    {                                                       \
+        constexpr size_t operator()(T value) const noexcept \
+        {                                                   \
+            return static_cast<size_t>(value);              \
+        }                                                   \
     };
 
     cxx_hashtable_define_trivial_hash(bool)
@@ -57,6 +71,15 @@ namespace stl
 
     #undef cxx_hashtable_define_trivial_hash
 
+    /**
+     * @brief Folds an already computed hash into a running one: one add and an fmix64, so it costs a few cycles where
+     *        re-hashing bytes would call @c hash_bytes. Order matters, (a, b) and (b, a) fold to different values.
+     */
+    inline constexpr size_t hash_combine(size_t seed, size_t hash) noexcept
+    {
+        return __detail::__hash_mix(seed + 0x9e3779b97f4a7c15ULL + hash);
+    }
+
     struct hash_impl
     {
         static size_t hash(const void* ptr, size_t length, size_t seed = static_cast<size_t>(0xc70f6907UL))
@@ -70,10 +93,18 @@ namespace stl
             return hash(&value, sizeof(value));
         }
 
+        /// @brief Folds the @c stl::hash of @c value into the running hash @c seed, so non-trivial types hash by value, not by bytes.
+        template <typename T>
+        static size_t hash_combine(const T& value, size_t seed)
+        {
+            return stl::hash_combine(seed, stl::hash<T>()(value));
+        }
+
+        /// @brief Keyed form, for tables fed by untrusted keys: folds the @c stl::seeded_hash of @c value under @c key (needs seeded_hash.h).
         template <typename T>
-        static size_t hash_combine(const T& value, size_t hash)
+        static size_t hash_combine(const T& value, size_t seed, const sip_key& key)
         {
-            return hash(&value, sizeof(value), hash);
+            return stl::hash_combine(seed, stl::seeded_hash<T>(key)(value));
         }
     };
 
@@ -106,28 +137,173 @@ namespace stl
         }
     };
 
-    inline size_t stl_hash_string(const char* str)
+    /**
+     * @brief String hash kernel shared by every string specialization: @c hash_bytes over the characters, which
+     *        consumes 8 to 64 bytes per step and avalanches fully, so string keys spread evenly under both mask and modulo indexing.
+     *        In a constant expression the same value comes from @c hash_bytes_constexpr, so literal keys can be hashed at compile time.
+     */
+    inline constexpr size_t stl_hash_string(const char* str, size_t length)
     {
-        unsigned long hash_value = 0;
-        
-        for (; *str; ++str)
-            hash_value = 5 * hash_value + *str;
+    #if defined(__GNUC__) || defined(__clang__)
+        if (__builtin_is_constant_evaluated())
+            return hash_bytes_constexpr(str, length, static_cast<size_t>(0xc70f6907UL));
 
-        return static_cast<size_t>(hash_value);
+        return hash_impl::hash(str, length);
+    #else
+        return hash_bytes_constexpr(str, length, static_cast<size_t>(0xc70f6907UL));
+    #endif
     }
 
-    #define cxx_hashtable_define_trivial_hash(T)  \
-    template <>                                   \
-    struct hash<T> : public hash_base<size_t, T>  \
-    {                                             \
-        size_t operator()(T value) const noexcept \
-        {                                         \
-            return stl_hash_string(value);        \
-        }                                         \
+    /// @brief NUL-terminated overload; the length comes from @c char_traits (the C library's vectorized @c strlen at run time), so a C string hashes like its view.
+    inline constexpr size_t stl_hash_string(const char* str)
+    {
+        return stl_hash_string(str, std::char_traits<char>::length(str));
+    }
+
+    #define cxx_hashtable_define_trivial_hash(T)            \
+    template <>                                             \
+    struct hash<T> : public hash_base<size_t, T>            \
+    {                                                       \
+        constexpr size_t operator()(T value) const noexcept \
+        {                                                   \
+            return stl_hash_string(value);                  \
+        }                                                   \
     };
 
     cxx_hashtable_define_trivial_hash(char*)
     cxx_hashtable_define_trivial_hash(const char*)
 
     #undef cxx_hashtable_define_trivial_hash
-}
\ No newline at end of file
+
+    /**
+     * @brief String hashes are transparent: @c std::string, @c std::string_view and C strings all hash through
+     *        @c std::string_view, so a @c std::string keyed map paired with @c stl::equal_to<> can be searched without building a key.
+     */
+    template <>
+    struct hash<std::string_view> : public hash_base<size_t, std::string_view>
+    {
+        typedef void is_transparent;
+
+        constexpr size_t operator()(std::string_view value) const noexcept
+        {
+            return stl_hash_string(value.data(), value.size());
+        }
+    };
+
+    template <>
+    struct hash<std::string> : public hash_base<size_t, std::string>
+    {
+        typedef void is_transparent;
+
+        constexpr size_t operator()(std::string_view value) const noexcept
+        {
+            return stl_hash_string(value.data(), value.size());
+        }
+    };
+
+    /// @brief Hash of several values in order, each through its @c stl::hash and folded by @c hash_combine.
+    inline constexpr size_t hash_values() noexcept
+    {
+        return static_cast<size_t>(0xc70f6907UL);
+    }
+
+    template <typename T, typename... Rest>
+    inline constexpr size_t hash_values(const T& value, const Rest&... rest) noexcept
+    {
+        return hash_combine(hash_values(rest...), hash<T>()(value));
+    }
+
+    namespace __detail
+    {
+        /**
+         * @brief Keys whose equality is their byte equality, so they can be hashed as one block of bytes:
+         *        integers, enums and pointers, and pairs and tuples of them laid out without padding.
+         */
+        template <typename T>
+        struct __bytewise_hashable
+            : public __and_<__or_<is_integral<T>, is_enum<T>, is_pointer<T>>, has_unique_object_representations<T>> { };
+
+        template <typename T1, typename T2>
+        struct __bytewise_hashable<pair<T1, T2>>
+            : public __and_<__bytewise_hashable<T1>, __bytewise_hashable<T2>,
+                            is_trivially_copyable<pair<T1, T2>>, has_unique_object_representations<pair<T1, T2>>> { };
+
+        template <typename... Ts>
+        struct __bytewise_hashable<std::tuple<Ts...>>
+            : public __and_<__bytewise_hashable<Ts>...,
+                            is_trivially_copyable<std::tuple<Ts...>>, has_unique_object_representations<std::tuple<Ts...>>> { };
+
+        /// @brief Object bytes of up to 16 bytes: loaded as one or two words and mixed inline, cheaper than calling @c hash_bytes.
+        template <typename T>
+        inline size_t __hash_object(const T& value, true_type) noexcept
+        {
+            uint64_t words[2] = { 0, 0 };
+            std::memcpy(words, &value, sizeof(T));
+
+            size_t h = __hash_mix(words[0] + static_cast<size_t>(0xc70f6907UL));
+            return sizeof(T) <= 8 ? h : hash_combine(h, words[1]);
+        }
+
+        template <typename T>
+        inline size_t __hash_object(const T& value, false_type) noexcept
+        { return hash_impl::hash(value); }
+
+        template <typename T>
+        inline size_t __hash_object(const T& value) noexcept
+        { return __hash_object(value, bool_constant<sizeof(T) <= 16>()); }
+
+        template <typename T>
+        inline size_t __hash_aggregate(const T& value, true_type) noexcept
+        { return __hash_object(value); }
+
+        template <typename T1, typename T2>
+        inline size_t __hash_aggregate(const pair<T1, T2>& value, false_type) noexcept
+        { return hash_values(value.first, value.second); }
+
+        template <typename... Ts, size_t... I>
+        inline size_t __hash_tuple(const std::tuple<Ts...>& value, std::index_sequence<I...>) noexcept
+        { return hash_values(std::get<I>(value)...); }
+
+        template <typename... Ts>
+        inline size_t __hash_aggregate(const std::tuple<Ts...>& value, false_type) noexcept
+        { return __hash_tuple(value, std::index_sequence_for<Ts...>()); }
+    }
+
+    /**
+     * @brief Composite keys hash member by member through @c hash_values, or, when every member compares by its bytes and
+     *        the layout has no padding, as one block of bytes.
+     */
+    template <typename T1, typename T2>
+    struct hash<pair<T1, T2>> : public hash_base<size_t, pair<T1, T2>>
+    {
+        size_t operator()(const pair<T1, T2>& value) const noexcept
+        {
+            return __detail::__hash_aggregate(value, typename __detail::__bytewise_hashable<pair<T1, T2>>::type());
+        }
+    };
+
+    template <typename... Ts>
+    struct hash<std::tuple<Ts...>> : public hash_base<size_t, std::tuple<Ts...>>
+    {
+        size_t operator()(const std::tuple<Ts...>& value) const noexcept
+        {
+            return __detail::__hash_aggregate(value, typename __detail::__bytewise_hashable<std::tuple<Ts...>>::type());
+        }
+    };
+
+    /**
+     * @brief Hash for user aggregates compared member by member, such as @c struct @c { @c uint32_t @c tenant, @c object; @c }:
+     *        hashes the object's bytes, which is only sound without padding or floating point members, as checked at compile time.
+     */
+    template <typename T>
+    struct bytewise_hash : public hash_base<size_t, T>
+    {
+        static_assert(is_trivially_copyable<T>::value && has_unique_object_representations<T>::value,
+                      "stl::bytewise_hash: T must be trivially copyable with unique object representations");
+
+        size_t operator()(const T& value) const noexcept
+        {
+            return __detail::__hash_object(value);
+        }
+    };
+}
@@ -1,28 +1,369 @@
 #include "hash_bytes.h"
 
-namespace stl 
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+    #include <immintrin.h>
+#endif
+
+namespace stl
 {
-	size_t hash_bytes(const void* ptr, size_t length, size_t seed)
+    namespace __detail
     {
-        const unsigned char *data = static_cast<const unsigned char*>(ptr);
-        size_t hash = seed;
+        typedef std::uint64_t __u64;
+
+        constexpr static size_t __SECRET_SIZE     = 192;
+        constexpr static size_t __STRIPE_SIZE     = 64;                                        // bytes folded into the 8 lanes per step
+        constexpr static size_t __BLOCK_STRIPES   = (__SECRET_SIZE - __STRIPE_SIZE) / 8;       // stripes between two scrambles
+        constexpr static size_t __BLOCK_SIZE      = __BLOCK_STRIPES * __STRIPE_SIZE;
+
+        constexpr static __u64 __PRIME32_1 = 0x9E3779B1U;
+        constexpr static __u64 __PRIME64_1 = 0x9E3779B185EBCA87ULL;
+
+        // splitmix64 output seeded with the digits of pi, read at byte offsets by the striped path
+        alignas(64) static const unsigned char __secret[__SECRET_SIZE] = {
+            0x21, 0xa2, 0xbe, 0x4a, 0x9f, 0xf6, 0xb0, 0x2c, 0x89, 0x89, 0x14, 0x23, 0x47, 0x03, 0x17, 0x94,
+            0x03, 0xfe, 0x9d, 0x60, 0x50, 0x59, 0x55, 0xdd, 0x00, 0x28, 0xb1, 0xde, 0x50, 0xb1, 0xaf, 0xdb,
+            0xb6, 0x2c, 0x44, 0x6c, 0x2e, 0x9b, 0x78, 0x7e, 0xc4, 0xf8, 0xe4, 0xc7, 0x36, 0x56, 0x1e, 0xf4,
+            0xe4, 0xa7, 0xfb, 0xf8, 0x50, 0xd1, 0x59, 0x09, 0xea, 0x9e, 0xdb, 0x3c, 0xf1, 0x16, 0x73, 0xa9,
+            0x68, 0x00, 0x52, 0xf9, 0x58, 0x82, 0xcd, 0x74, 0x8b, 0x86, 0x16, 0xe1, 0x62, 0x4a, 0xc7, 0x55,
+            0xbd, 0x3c, 0x02, 0xa2, 0x99, 0xc7, 0xf4, 0xd2, 0xb9, 0x51, 0x7b, 0xa3, 0x79, 0xcb, 0x98, 0xdf,
+            0x05, 0x39, 0x4f, 0x52, 0x85, 0x58, 0x6f, 0x39, 0x76, 0xb2, 0xa3, 0x6c, 0x38, 0x56, 0x1d, 0xaf,
+            0x5a, 0xe8, 0x04, 0x51, 0x6b, 0xbe, 0xff, 0xa9, 0xb3, 0x33, 0xd5, 0x9f, 0x1b, 0xc5, 0xd0, 0x6b,
+            0x56, 0x4b, 0xab, 0x50, 0x1c, 0xe9, 0x0c, 0x98, 0xc5, 0x62, 0xfe, 0x80, 0x57, 0x39, 0xac, 0x28,
+            0xc7, 0xed, 0xbc, 0xa6, 0xe3, 0x12, 0x89, 0x76, 0x88, 0x7c, 0x2c, 0x33, 0xc9, 0xe8, 0xb3, 0x50,
+            0xda, 0x47, 0xbd, 0x20, 0xe5, 0xbf, 0x3b, 0xce, 0x4f, 0x7c, 0xbb, 0xe0, 0xe8, 0xc8, 0xa6, 0xcb,
+            0x6d, 0x34, 0x4a, 0x43, 0xb8, 0x4d, 0x19, 0xbf, 0x7f, 0x6d, 0x41, 0x60, 0x7b, 0x2a, 0x8f, 0x7d,
+        };
+
+        static inline __u64 __read64(const unsigned char* p) { __u64 v; std::memcpy(&v, p, 8); return v; }
 
-        for (size_t i = 0; i < length; ++i)
+        static inline __u64 __read32(const unsigned char* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+
+        /// @brief 1 to 3 bytes packed into one word: first, middle and last byte.
+        static inline __u64 __read_small(const unsigned char* p, size_t length)
+        { return (static_cast<__u64>(p[0]) << 16) | (static_cast<__u64>(p[length >> 1]) << 8) | p[length - 1]; }
+
+        /// @brief Full 64x64 -> 128 bit product, low half into @c a and high half into @c b.
+        static inline void __mum(__u64& a, __u64& b)
+        {
+        #if defined(__SIZEOF_INT128__)
+            unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<__u64>(r);
+            b = static_cast<__u64>(r >> 64);
+        #else
+            __u64 ha = a >> 32, hb = b >> 32, la = static_cast<std::uint32_t>(a), lb = static_cast<std::uint32_t>(b);
+            __u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            __u64 t = rl + (rm0 << 32), c = t < rl;
+            __u64 lo = t + (rm1 << 32);
+            c += lo < t;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        #endif
+        }
+
+        /// @brief 128 bit product folded back to 64 bits (low ^ high).
+        static inline __u64 __mix(__u64 a, __u64 b)
         {
-            hash ^= data[i];
-            hash *= 0x100000001b3; // 1099511628211
+            __mum(a, b);
+            return a ^ b;
         }
 
-        return hash;
+        static inline __u64 __avalanche(__u64 h)
+        {
+            h ^= h >> 37;
+            h *= 0x165667919E3779F9ULL;
+            return h ^ (h >> 32);
+        }
+
+        /**
+         * Up to @c __LONG_THRESHOLD bytes, after wyhash: inputs of at most 16 bytes are covered by two overlapping reads,
+         * longer ones are folded 48 bytes at a time through three independent multiply chains, then 16 at a time.
+         */
+        static __u64 __hash_short(const unsigned char* p, size_t length, __u64 seed)
+        {
+            __u64 a, b;
+
+            if (length <= 16)
+            {
+                // the seed still goes through both final multiplies; tiny keys skip the pre-mix
+                seed ^= __WY0;
+
+                if (length >= 4)
+                {
+                    size_t shift = (length >> 3) << 2;
+                    a = (__read32(p) << 32) | __read32(p + shift);
+                    b = (__read32(p + length - 4) << 32) | __read32(p + length - 4 - shift);
+                }
+                else if (length > 0)
+                {
+                    a = __read_small(p, length);
+                    b = 0;
+                }
+                else
+                    a = b = 0;
+            }
+            else
+            {
+                size_t i = length;
+
+                seed ^= __mix(seed ^ __WY0, __WY1);
+
+                if (i > 48)
+                {
+                    __u64 see1 = seed, see2 = seed;
+
+                    do
+                    {
+                        seed = __mix(__read64(p) ^ __WY1, __read64(p + 8) ^ seed);
+                        see1 = __mix(__read64(p + 16) ^ __WY2, __read64(p + 24) ^ see1);
+                        see2 = __mix(__read64(p + 32) ^ __WY3, __read64(p + 40) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+
+                    seed ^= see1 ^ see2;
+                }
+
+                while (i > 16)
+                {
+                    seed = __mix(__read64(p) ^ __WY1, __read64(p + 8) ^ seed);
+                    p += 16;
+                    i -= 16;
+                }
+
+                a = __read64(p + i - 16);
+                b = __read64(p + i - 8);
+            }
+
+            a ^= __WY1;
+            b ^= seed;
+            __mum(a, b);
+
+            return __mix(a ^ __WY0 ^ length, b ^ __WY1);
+        }
+
+        /*
+         * Striped path, after XXH3: 8 independent 64-bit lanes each take one word of every 64-byte stripe,
+         * acc[i] += lo32(d ^ k) * hi32(d ^ k) and acc[i ^ 1] += d, with the key k read from the secret at the stripe's
+         * offset. After every block of @c __BLOCK_STRIPES stripes the lanes are scrambled. The multiplies are 32x32 -> 64,
+         * so the lanes map directly onto SSE2 / AVX2 registers; all kernels compute the same value.
+         */
+
+        static inline void __accumulate_scalar(__u64* acc, const unsigned char* p, const unsigned char* key)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                __u64 data = __read64(p + 8 * i);
+                __u64 data_key = data ^ __read64(key + 8 * i);
+
+                acc[i ^ 1] += data;
+                acc[i] += (data_key & 0xFFFFFFFFULL) * (data_key >> 32);
+            }
+        }
+
+        static inline void __scramble_scalar(__u64* acc, const unsigned char* key)
+        {
+            for (size_t i = 0; i < 8; ++i)
+            {
+                __u64 a = acc[i];
+                a ^= a >> 47;
+                a ^= __read64(key + 8 * i);
+                acc[i] = a * __PRIME32_1;
+            }
+        }
+
+        [[maybe_unused]] static void __hash_long_scalar(__u64* acc, const unsigned char* p, size_t length)
+        {
+            size_t blocks = (length - 1) / __BLOCK_SIZE;
+
+            for (size_t b = 0; b < blocks; ++b, p += __BLOCK_SIZE)
+            {
+                for (size_t s = 0; s < __BLOCK_STRIPES; ++s)
+                    __accumulate_scalar(acc, p + s * __STRIPE_SIZE, __secret + s * 8);
+
+                __scramble_scalar(acc, __secret + __SECRET_SIZE - __STRIPE_SIZE);
+            }
+
+            size_t stripes = ((length - 1) - blocks * __BLOCK_SIZE) / __STRIPE_SIZE;
+
+            for (size_t s = 0; s < stripes; ++s)
+                __accumulate_scalar(acc, p + s * __STRIPE_SIZE, __secret + s * 8);
+        }
+
+    #if defined(__SSE2__) || defined(_M_X64)
+        static void __hash_long_sse2(__u64* acc, const unsigned char* p, size_t length)
+        {
+            __m128i lanes[4];
+
+            for (size_t j = 0; j < 4; ++j)
+                lanes[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + j);
+
+            const __m128i prime = _mm_set1_epi32(static_cast<int>(__PRIME32_1));
+
+            auto accumulate = [&lanes](const unsigned char* data, const unsigned char* key) {
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data) + j);
+                    __m128i dk = _mm_xor_si128(d, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + j));
+                    __m128i product = _mm_mul_epu32(dk, _mm_srli_epi64(dk, 32));
+                    __m128i swapped = _mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2));
+                    lanes[j] = _mm_add_epi64(lanes[j], _mm_add_epi64(product, swapped));
+                }
+            };
+
+            size_t blocks = (length - 1) / __BLOCK_SIZE;
+
+            for (size_t b = 0; b < blocks; ++b, p += __BLOCK_SIZE)
+            {
+                for (size_t s = 0; s < __BLOCK_STRIPES; ++s)
+                    accumulate(p + s * __STRIPE_SIZE, __secret + s * 8);
+
+                const unsigned char* key = __secret + __SECRET_SIZE - __STRIPE_SIZE;
+
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    __m128i a = _mm_xor_si128(lanes[j], _mm_srli_epi64(lanes[j], 47));
+                    a = _mm_xor_si128(a, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key) + j));
+                    __m128i lo = _mm_mul_epu32(a, prime);
+                    __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), prime);
+                    lanes[j] = _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+                }
+            }
+
+            size_t stripes = ((length - 1) - blocks * __BLOCK_SIZE) / __STRIPE_SIZE;
+
+            for (size_t s = 0; s < stripes; ++s)
+                accumulate(p + s * __STRIPE_SIZE, __secret + s * 8);
+
+            for (size_t j = 0; j < 4; ++j)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + j, lanes[j]);
+        }
+    #endif
+
+    #if (defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))) || defined(__AVX2__)
+        #if !defined(__AVX2__)
+            #define __STL_TARGET_AVX2 __attribute__((target("avx2")))
+        #else
+            #define __STL_TARGET_AVX2
+        #endif
+
+        __STL_TARGET_AVX2
+        static void __hash_long_avx2(__u64* acc, const unsigned char* p, size_t length)
+        {
+            __m256i lo_lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc));
+            __m256i hi_lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + 1);
+
+            const __m256i prime = _mm256_set1_epi32(static_cast<int>(__PRIME32_1));
+
+            size_t blocks = (length - 1) / __BLOCK_SIZE;
+            size_t stripes = ((length - 1) - blocks * __BLOCK_SIZE) / __STRIPE_SIZE;
+
+            for (size_t b = 0; b <= blocks; ++b, p += __BLOCK_SIZE)
+            {
+                size_t count = b < blocks ? __BLOCK_STRIPES : stripes;
+
+                for (size_t s = 0; s < count; ++s)
+                {
+                    const __m256i* data = reinterpret_cast<const __m256i*>(p + s * __STRIPE_SIZE);
+                    const __m256i* key = reinterpret_cast<const __m256i*>(__secret + s * 8);
+
+                    __m256i d0 = _mm256_loadu_si256(data), d1 = _mm256_loadu_si256(data + 1);
+                    __m256i dk0 = _mm256_xor_si256(d0, _mm256_loadu_si256(key));
+                    __m256i dk1 = _mm256_xor_si256(d1, _mm256_loadu_si256(key + 1));
+
+                    lo_lanes = _mm256_add_epi64(lo_lanes, _mm256_add_epi64(_mm256_mul_epu32(dk0, _mm256_srli_epi64(dk0, 32)),
+                                                                           _mm256_shuffle_epi32(d0, _MM_SHUFFLE(1, 0, 3, 2))));
+                    hi_lanes = _mm256_add_epi64(hi_lanes, _mm256_add_epi64(_mm256_mul_epu32(dk1, _mm256_srli_epi64(dk1, 32)),
+                                                                           _mm256_shuffle_epi32(d1, _MM_SHUFFLE(1, 0, 3, 2))));
+                }
+
+                if (b == blocks)
+                    break;
+
+                const __m256i* key = reinterpret_cast<const __m256i*>(__secret + __SECRET_SIZE - __STRIPE_SIZE);
+                __m256i* lanes[2] = { &lo_lanes, &hi_lanes };
+
+                for (size_t j = 0; j < 2; ++j)
+                {
+                    __m256i a = _mm256_xor_si256(*lanes[j], _mm256_srli_epi64(*lanes[j], 47));
+                    a = _mm256_xor_si256(a, _mm256_loadu_si256(key + j));
+                    __m256i lo = _mm256_mul_epu32(a, prime);
+                    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+                    *lanes[j] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+                }
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc), lo_lanes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + 1, hi_lanes);
+        }
+
+        #undef __STL_TARGET_AVX2
+        #define __STL_HAS_AVX2_KERNEL
+    #endif
+
+        typedef void (*__hash_long_kernel)(__u64*, const unsigned char*, size_t);
+
+        /// @brief Widest kernel the build and, for AVX2 without @c -mavx2, the running CPU support.
+        static __hash_long_kernel __select_kernel()
+        {
+        #if defined(__AVX2__)
+            return __hash_long_avx2;
+        #elif defined(__STL_HAS_AVX2_KERNEL)
+            if (__builtin_cpu_supports("avx2"))
+                return __hash_long_avx2;
+        #endif
+
+        #if defined(__SSE2__) || defined(_M_X64)
+            return __hash_long_sse2;
+        #else
+            return __hash_long_scalar;
+        #endif
+        }
+
+        static __u64 __hash_long(const unsigned char* p, size_t length, __u64 seed)
+        {
+            static const __hash_long_kernel kernel = __select_kernel();
+
+            __u64 acc[8] = {
+                0xC2B2AE3DULL + seed,              0x9E3779B185EBCA87ULL - seed,
+                0xC2B2AE3D27D4EB4FULL + seed,      0x165667B19E3779F9ULL - seed,
+                0x85EBCA77C2B2AE63ULL + seed,      0x85EBCA77ULL - seed,
+                0x27D4EB2F165667C5ULL + seed,      0x9E3779B1ULL - seed,
+            };
+
+            kernel(acc, p, length);
+
+            // the last stripe always ends on the last byte; its key is offset so it never matches a regular stripe's
+            __accumulate_scalar(acc, p + length - __STRIPE_SIZE, __secret + __SECRET_SIZE - __STRIPE_SIZE - 7);
+
+            __u64 h = length * __PRIME64_1;
+
+            for (size_t i = 0; i < 4; ++i)
+                h += __mix(acc[2 * i] ^ __read64(__secret + 11 + 16 * i), acc[2 * i + 1] ^ __read64(__secret + 19 + 16 * i));
+
+            return __avalanche(h);
+        }
+    }
+
+    size_t hash_bytes(const void* ptr, size_t length, size_t seed)
+    {
+        const unsigned char* data = static_cast<const unsigned char*>(ptr);
+
+        if (length <= __detail::__LONG_THRESHOLD)
+            return static_cast<size_t>(__detail::__hash_short(data, length, seed));
+
+        return static_cast<size_t>(__detail::__hash_long(data, length, seed));
     }
 }
 
 /**
-   XOR bit operation 
-  
+   XOR bit operation
+
    BIT A |  BIT B |   A XOR B
    0	 |  0	  |   0
    0	 |  1	  |   1
    1	 |  0	  |   1
    1	 |  1	  |   0
- */
\ No newline at end of file
+ */
@@ -5,8 +5,131 @@
 
 namespace stl
 {
-    // Hash function implementation for the nontrivial specialization.
+    /**
+     * Hash function implementation for the nontrivial specialization.
+     * Up to 1024 bytes the input is folded 16 or 48 bytes at a time through 128-bit multiplies (wyhash style); longer
+     * inputs are accumulated in 64-byte stripes over 8 lanes (XXH3 style), with an AVX2 or SSE2 kernel picked at
+     * startup on x86-64. Every kernel produces the same value.
+     */
     size_t hash_bytes(const void* ptr, size_t length, size_t seed);
+
+    namespace __detail
+    {
+        constexpr static size_t __LONG_THRESHOLD = 1024;        // inputs above it take the striped path
+
+        // wyhash's default secret, for the short path
+        constexpr static uint64_t __WY0 = 0xa0761d6478bd642fULL;
+        constexpr static uint64_t __WY1 = 0xe7037ed1a0b428dbULL;
+        constexpr static uint64_t __WY2 = 0x8ebc6af09c88c6e3ULL;
+        constexpr static uint64_t __WY3 = 0x589965cc75374cc3ULL;
+
+        // Little-endian loads out of single bytes, the only reads allowed in a constant expression.
+        inline constexpr uint64_t __ce_read(const char* p, size_t bytes) noexcept
+        {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i)
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(p[i])) << (8 * i);
+            return value;
+        }
+
+        /// @brief Full 64x64 -> 128 bit product, low half into @c a and high half into @c b.
+        inline constexpr void __ce_mum(uint64_t& a, uint64_t& b) noexcept
+        {
+        #if defined(__SIZEOF_INT128__)
+            unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+            a = static_cast<uint64_t>(r);
+            b = static_cast<uint64_t>(r >> 64);
+        #else
+            uint64_t ha = a >> 32, hb = b >> 32, la = a & 0xffffffffULL, lb = b & 0xffffffffULL;
+            uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            uint64_t t = rl + (rm0 << 32), c = t < rl;
+            uint64_t lo = t + (rm1 << 32);
+            c += lo < t;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+        #endif
+        }
+
+        inline constexpr uint64_t __ce_mix(uint64_t a, uint64_t b) noexcept
+        {
+            __ce_mum(a, b);
+            return a ^ b;
+        }
+
+        /// @brief The short path of @c hash_bytes step for step, over @c char reads; see hash_bytes.cpp for the algorithm.
+        inline constexpr uint64_t __hash_short_constexpr(const char* p, size_t length, uint64_t seed) noexcept
+        {
+            uint64_t a = 0, b = 0;
+
+            if (length <= 16)
+            {
+                seed ^= __WY0;
+
+                if (length >= 4)
+                {
+                    size_t shift = (length >> 3) << 2;
+                    a = (__ce_read(p, 4) << 32) | __ce_read(p + shift, 4);
+                    b = (__ce_read(p + length - 4, 4) << 32) | __ce_read(p + length - 4 - shift, 4);
+                }
+                else if (length > 0)
+                {
+                    a = (__ce_read(p, 1) << 16) | (__ce_read(p + (length >> 1), 1) << 8) | __ce_read(p + length - 1, 1);
+                    b = 0;
+                }
+            }
+            else
+            {
+                size_t i = length;
+
+                seed ^= __ce_mix(seed ^ __WY0, __WY1);
+
+                if (i > 48)
+                {
+                    uint64_t see1 = seed, see2 = seed;
+
+                    do
+                    {
+                        seed = __ce_mix(__ce_read(p, 8) ^ __WY1, __ce_read(p + 8, 8) ^ seed);
+                        see1 = __ce_mix(__ce_read(p + 16, 8) ^ __WY2, __ce_read(p + 24, 8) ^ see1);
+                        see2 = __ce_mix(__ce_read(p + 32, 8) ^ __WY3, __ce_read(p + 40, 8) ^ see2);
+                        p += 48;
+                        i -= 48;
+                    } while (i > 48);
+
+                    seed ^= see1 ^ see2;
+                }
+
+                while (i > 16)
+                {
+                    seed = __ce_mix(__ce_read(p, 8) ^ __WY1, __ce_read(p + 8, 8) ^ seed);
+                    p += 16;
+                    i -= 16;
+                }
+
+                a = __ce_read(p + i - 16, 8);
+                b = __ce_read(p + i - 8, 8);
+            }
+
+            a ^= __WY1;
+            b ^= seed;
+            __ce_mum(a, b);
+
+            return __ce_mix(a ^ __WY0 ^ length, b ^ __WY1);
+        }
+    }
+
+    /**
+     * @c hash_bytes usable in constant expressions, equal to it on little-endian targets: string literals hashed at
+     * compile time land in the same buckets as the same strings hashed at run time. Inputs longer than 1024 bytes take
+     * @c hash_bytes itself, so they only hash at run time.
+     */
+    inline constexpr size_t hash_bytes_constexpr(const char* ptr, size_t length, size_t seed)
+    {
+        if (length > __detail::__LONG_THRESHOLD)
+            return hash_bytes(ptr, length, seed);
+
+        return static_cast<size_t>(__detail::__hash_short_constexpr(ptr, length, seed));
+    }
 }
 
-#endif // HASH_BYTES_H
\ No newline at end of file
+#endif // HASH_BYTES_H
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../traits/type_traits.h"
+
+namespace stl
+{
+    namespace __detail
+    {
+        /**
+         * @brief Finalizer of MurmurHash3 (fmix64). Every input bit affects every output bit, which is required before
+         *        masking off the low bits of hashes that are weak there (e.g. @c stl::hash<int> is the identity and
+         *        @c stl::hash<T*> has zero low bits).
+         */
+        inline constexpr size_t __hash_mix(size_t h) noexcept
+        {
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return h;
+        }
+
+        /// @brief Smallest prime >= 2^k + 1 for every k, used as the bucket counts of @c stl::prime_rehash_policy.
+        constexpr size_t __prime_list[] = {
+            2ULL, 3ULL, 5ULL, 11ULL, 17ULL, 37ULL, 67ULL, 131ULL, 257ULL, 521ULL, 1031ULL, 2053ULL, 4099ULL, 8209ULL, 16411ULL,
+            32771ULL, 65537ULL, 131101ULL, 262147ULL, 524309ULL, 1048583ULL, 2097169ULL, 4194319ULL, 8388617ULL, 16777259ULL,
+            33554467ULL, 67108879ULL, 134217757ULL, 268435459ULL, 536870923ULL, 1073741827ULL, 2147483659ULL, 4294967311ULL,
+            8589934609ULL, 17179869209ULL, 34359738421ULL, 68719476767ULL, 137438953481ULL, 274877906951ULL, 549755813911ULL,
+            1099511627791ULL, 2199023255579ULL, 4398046511119ULL, 8796093022237ULL, 17592186044423ULL, 35184372088891ULL,
+            70368744177679ULL, 140737488355333ULL, 281474976710677ULL, 562949953421381ULL, 1125899906842679ULL,
+            2251799813685269ULL, 4503599627370517ULL, 9007199254740997ULL, 18014398509482143ULL, 36028797018963971ULL,
+            72057594037928017ULL, 144115188075855881ULL, 288230376151711813ULL, 576460752303423619ULL, 1152921504606847009ULL,
+            2305843009213693967ULL, 4611686018427388039ULL, 9223372036854775837ULL
+        };
+    }
+
+    /**
+     * @brief Bucket sizing policy keeping the bucket count a power of two, so the bucket index is a mask of the hash instead of a division.
+     *        The hash is post-mixed first because the low bits of trivial hashes are not uniformly distributed.
+     */
+    struct power2_rehash_policy
+    {
+        /// @brief Buckets moved per operation while growing; 0 rehashes the whole table at once.
+        static constexpr size_t migrate_buckets = 0;
+
+        /// @brief Smallest valid bucket count >= @c n.
+        static constexpr size_t next_bucket_count(size_t n) noexcept
+        {
+            size_t count = 1;
+
+            while (count < n)
+                count <<= 1;
+
+            return count;
+        }
+
+        static constexpr size_t bucket_index(size_t hash, size_t bucket_count) noexcept
+        { return __detail::__hash_mix(hash) & (bucket_count - 1); }
+    };
+
+    /**
+     * @brief Bucket sizing policy keeping the bucket count prime and using the raw hash modulo the bucket count.
+     *        Costs an integer division per lookup, but tolerates poor hash functions without any mixing.
+     */
+    struct prime_rehash_policy
+    {
+        static constexpr size_t migrate_buckets = 0;
+
+        static constexpr size_t next_bucket_count(size_t n) noexcept
+        {
+            for (size_t prime : __detail::__prime_list)
+                if (prime >= n)
+                    return prime;
+
+            return __detail::__prime_list[sizeof(__detail::__prime_list) / sizeof(size_t) - 1];
+        }
+
+        static constexpr size_t bucket_index(size_t hash, size_t bucket_count) noexcept
+        { return hash % bucket_count; }
+    };
+
+    /**
+     * @brief Power-of-two policy growing incrementally: the old and new bucket arrays coexist and every insert moves
+     *        @c MigrateBuckets buckets, so no single insert pays for rehashing the whole table.
+     *        Growth triggers after another 3/4 of the old bucket count inserts at the earliest, so any value >= 2 finishes in time.
+     *
+     *        Iterators walk the old table, then the new one. Only the operations that relink chains invalidate them:
+     *        - an insertion that adds an entry (@c merge included), while a migration is pending or when it starts one;
+     *        - @c rehash, @c reserve, @c clear and the range @c insert, which finish the migration, as @c merge does on its source;
+     *        - erasing or extracting an entry, for the iterators to that entry.
+     *        Lookups, @c find_batch, an insertion of a present key and the const members never migrate nor invalidate,
+     *        so concurrent const calls stay safe mid-migration.
+     *        References and pointers to an entry stay valid until it is erased: nodes are relinked, never moved.
+     */
+    template <size_t MigrateBuckets = 4>
+    struct incremental_rehash_policy : power2_rehash_policy
+    {
+        static_assert(MigrateBuckets > 0, "an incremental rehash must migrate at least one bucket per operation");
+
+        static constexpr size_t migrate_buckets = MigrateBuckets;
+    };
+}
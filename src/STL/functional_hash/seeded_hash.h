@@ -0,0 +1,168 @@
+#pragma once
+
+#include "hash.h"
+#include "siphash.h"
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief The SipHash key of a seeded hash: drawn per instance by default, kept by copies.
+        class __seeded_hash_key
+        {
+        public:
+            __seeded_hash_key()
+                : m_key(random_sip_key()) { }
+
+            explicit __seeded_hash_key(const sip_key& key) noexcept
+                : m_key(key) { }
+
+            const sip_key& key() const noexcept { return this->m_key; }
+
+        protected:
+            sip_key m_key;
+        };
+
+        /// @brief SipHash of the object bytes, as one word when they fit in one.
+        template <typename T>
+        inline size_t __sip_hash_object(const T& value, const sip_key& key) noexcept
+        {
+            if (sizeof(T) > 8)
+                return static_cast<size_t>(sip_hash_bytes(&value, sizeof(T), key));
+
+            uint64_t word = 0;
+            std::memcpy(&word, &value, sizeof(T));
+
+            return static_cast<size_t>(sip_hash_word(word, key));
+        }
+
+        // integers, enums, pointers, and pairs and tuples of them without padding: their bytes are their value
+        template <typename T>
+        inline size_t __seeded_hash_value(const T& value, const sip_key& key, true_type, false_type) noexcept
+        { return __sip_hash_object(value, key); }
+
+        // float and double: the bytes too, with -0.0 hashed as 0.0 since they compare equal
+        template <typename T>
+        inline size_t __seeded_hash_value(const T& value, const sip_key& key, false_type, true_type) noexcept
+        { return __sip_hash_object(value != 0 ? value : T(0), key); }
+
+        // anything else can only be reached through its stl::hash word
+        template <typename T>
+        inline size_t __seeded_hash_value(const T& value, const sip_key& key, false_type, false_type) noexcept
+        { return static_cast<size_t>(sip_hash_word(static_cast<uint64_t>(hash<T>()(value)), key)); }
+
+        template <typename T>
+        struct __seeded_float : public bool_constant<is_same<T, float>::value || is_same<T, double>::value> { };
+    }
+
+    /**
+     * @brief Keyed counterpart of @c hash_values: every value through its @c stl::seeded_hash under @c key, folded in
+     *        order by @c hash_impl::hash_combine, so no member is ever reduced by an unkeyed hash first.
+     */
+    inline size_t hash_values(const sip_key&) noexcept
+    {
+        return static_cast<size_t>(0xc70f6907UL);
+    }
+
+    template <typename T, typename... Rest>
+    inline size_t hash_values(const sip_key& key, const T& value, const Rest&... rest) noexcept
+    {
+        return hash_impl::hash_combine(value, hash_values(key, rest...), key);
+    }
+
+    /**
+     * @brief Keyed drop-in @c Hash for tables fed by untrusted keys. Every default-constructed instance draws its own
+     *        SipHash key, so each @c unordered_map built with it is seeded differently and colliding keys cannot be
+     *        precomputed; copies keep the key, as the cached hash codes of a copied table require.
+     *        The key itself goes through SipHash: the bytes of integer, enum, pointer and floating point keys and of
+     *        pairs and tuples without padding, the members of other pairs and tuples (see @c hash_values), the
+     *        characters of strings. Any other type is keyed through its @c stl::hash word, so a collision of that
+     *        hash survives the key; specialize @c seeded_hash for such types when their keys are untrusted.
+     */
+    template <typename Key>
+    struct seeded_hash : public hash_base<size_t, Key>, public __detail::__seeded_hash_key
+    {
+        using __detail::__seeded_hash_key::__seeded_hash_key;
+
+        size_t operator()(const Key& value) const noexcept
+        {
+            return __detail::__seeded_hash_value(value, this->m_key, typename __detail::__bytewise_hashable<Key>::type(),
+                                                 typename __detail::__seeded_float<Key>::type());
+        }
+    };
+
+    template <typename T1, typename T2>
+    struct seeded_hash<pair<T1, T2>> : public hash_base<size_t, pair<T1, T2>>, public __detail::__seeded_hash_key
+    {
+        using __detail::__seeded_hash_key::__seeded_hash_key;
+
+        size_t operator()(const pair<T1, T2>& value) const noexcept
+        {
+            return this->m_hash(value, typename __detail::__bytewise_hashable<pair<T1, T2>>::type());
+        }
+
+    private:
+        size_t m_hash(const pair<T1, T2>& value, true_type) const noexcept
+        { return __detail::__sip_hash_object(value, this->m_key); }
+
+        size_t m_hash(const pair<T1, T2>& value, false_type) const noexcept
+        { return hash_values(this->m_key, value.first, value.second); }
+    };
+
+    template <typename... Ts>
+    struct seeded_hash<std::tuple<Ts...>> : public hash_base<size_t, std::tuple<Ts...>>, public __detail::__seeded_hash_key
+    {
+        using __detail::__seeded_hash_key::__seeded_hash_key;
+
+        size_t operator()(const std::tuple<Ts...>& value) const noexcept
+        {
+            return this->m_hash(value, typename __detail::__bytewise_hashable<std::tuple<Ts...>>::type());
+        }
+
+    private:
+        size_t m_hash(const std::tuple<Ts...>& value, true_type) const noexcept
+        { return __detail::__sip_hash_object(value, this->m_key); }
+
+        size_t m_hash(const std::tuple<Ts...>& value, false_type) const noexcept
+        { return this->m_hash_members(value, std::index_sequence_for<Ts...>()); }
+
+        template <size_t... I>
+        size_t m_hash_members(const std::tuple<Ts...>& value, std::index_sequence<I...>) const noexcept
+        { return hash_values(this->m_key, std::get<I>(value)...); }
+    };
+
+    namespace __detail
+    {
+        /// @brief Seeded string hash over the characters themselves, transparent like @c stl::hash<std::string>.
+        template <typename Key>
+        struct __seeded_string_hash : public hash_base<size_t, Key>, public __seeded_hash_key
+        {
+            typedef void is_transparent;
+
+            using __seeded_hash_key::__seeded_hash_key;
+
+            size_t operator()(std::string_view value) const noexcept
+            { return static_cast<size_t>(sip_hash_bytes(value.data(), value.size(), this->m_key)); }
+        };
+    }
+
+    #define cxx_hashtable_define_seeded_string_hash(T)                                      \
+    template <>                                                                             \
+    struct seeded_hash<T> : public __detail::__seeded_string_hash<T>                        \
+    {                                                                                       \
+        using __detail::__seeded_string_hash<T>::__seeded_string_hash;                      \
+    };
+
+    cxx_hashtable_define_seeded_string_hash(char*)
+    cxx_hashtable_define_seeded_string_hash(const char*)
+    cxx_hashtable_define_seeded_string_hash(std::string_view)
+    cxx_hashtable_define_seeded_string_hash(std::string)
+
+    #undef cxx_hashtable_define_seeded_string_hash
+}
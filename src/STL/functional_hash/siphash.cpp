@@ -0,0 +1,79 @@
+#include "siphash.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+namespace stl
+{
+    namespace __detail
+    {
+        /// @brief SipHash-c-d; the public entry point is 1-3, the reference 2-4 shares the code.
+        template <int CompressionRounds, int FinalizationRounds>
+        static uint64_t __sip_hash(const unsigned char* data, size_t length, const sip_key& key)
+        {
+            uint64_t v0 = key.k0 ^ 0x736f6d6570736575ULL;
+            uint64_t v1 = key.k1 ^ 0x646f72616e646f6dULL;
+            uint64_t v2 = key.k0 ^ 0x6c7967656e657261ULL;
+            uint64_t v3 = key.k1 ^ 0x7465646279746573ULL;
+
+            const unsigned char* end = data + (length & ~static_cast<size_t>(7));
+
+            for (; data != end; data += 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, data, 8);
+
+                v3 ^= word;
+                for (int i = 0; i < CompressionRounds; ++i) __sip_round(v0, v1, v2, v3);
+                v0 ^= word;
+            }
+
+            // the 0 to 7 trailing bytes, little endian, with the length in the top byte
+            uint64_t last = static_cast<uint64_t>(length) << 56;
+            for (size_t i = 0; i < (length & 7); ++i)
+                last |= static_cast<uint64_t>(data[i]) << (8 * i);
+
+            v3 ^= last;
+            for (int i = 0; i < CompressionRounds; ++i) __sip_round(v0, v1, v2, v3);
+            v0 ^= last;
+
+            v2 ^= 0xff;
+            for (int i = 0; i < FinalizationRounds; ++i) __sip_round(v0, v1, v2, v3);
+
+            return v0 ^ v1 ^ v2 ^ v3;
+        }
+
+        static inline uint64_t __splitmix64(uint64_t x)
+        {
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return x;
+        }
+    }
+
+    uint64_t sip_hash_bytes(const void* ptr, size_t length, const sip_key& key)
+    {
+        return __detail::__sip_hash<1, 3>(static_cast<const unsigned char*>(ptr), length, key);
+    }
+
+    sip_key random_sip_key()
+    {
+        constexpr uint64_t golden = 0x9e3779b97f4a7c15ULL;
+
+        static const sip_key secret = [] {
+            std::random_device device;
+            auto draw = [&device] { return (static_cast<uint64_t>(device()) << 32) ^ device(); };
+            uint64_t k0 = draw();
+            return sip_key{ k0, draw() };
+        }();
+        static std::atomic<uint64_t> counter(0);
+
+        uint64_t n = counter.fetch_add(1, std::memory_order_relaxed) + 1;
+        return sip_key{ __detail::__splitmix64(secret.k0 + n * golden), __detail::__splitmix64(secret.k1 + n * golden) };
+    }
+}
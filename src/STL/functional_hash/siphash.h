@@ -0,0 +1,67 @@
+#ifndef __SIPHASH_H__
+#define __SIPHASH_H__
+
+#include "../traits/type_traits.h"
+
+namespace stl
+{
+    /// @brief 128-bit secret key of the SipHash family.
+    struct sip_key
+    {
+        uint64_t k0;
+        uint64_t k1;
+    };
+
+    namespace __detail
+    {
+        inline constexpr uint64_t __rotl64(uint64_t x, int r) noexcept
+        { return (x << r) | (x >> (64 - r)); }
+
+        inline void __sip_round(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) noexcept
+        {
+            v0 += v1; v1 = __rotl64(v1, 13); v1 ^= v0; v0 = __rotl64(v0, 32);
+            v2 += v3; v3 = __rotl64(v3, 16); v3 ^= v2;
+            v0 += v3; v3 = __rotl64(v3, 21); v3 ^= v0;
+            v2 += v1; v1 = __rotl64(v1, 17); v1 ^= v2; v2 = __rotl64(v2, 32);
+        }
+    }
+
+    /**
+     * Keyed hash for inputs an attacker controls: SipHash-1-3 (one compression round per 8-byte word, three finalization
+     * rounds) of @c length bytes under @c key. Without the key, inputs sharing a hash or a bucket cannot be precomputed.
+     */
+    uint64_t sip_hash_bytes(const void* ptr, size_t length, const sip_key& key);
+
+    /// @brief SipHash-1-3 of one word; equal to @c sip_hash_bytes over its 8 bytes on little-endian targets, but inline and loop free.
+    inline uint64_t sip_hash_word(uint64_t word, const sip_key& key) noexcept
+    {
+        uint64_t v0 = key.k0 ^ 0x736f6d6570736575ULL;
+        uint64_t v1 = key.k1 ^ 0x646f72616e646f6dULL;
+        uint64_t v2 = key.k0 ^ 0x6c7967656e657261ULL;
+        uint64_t v3 = key.k1 ^ 0x7465646279746573ULL;
+
+        v3 ^= word;
+        __detail::__sip_round(v0, v1, v2, v3);
+        v0 ^= word;
+
+        const uint64_t last = 8ULL << 56;
+        v3 ^= last;
+        __detail::__sip_round(v0, v1, v2, v3);
+        v0 ^= last;
+
+        v2 ^= 0xff;
+        __detail::__sip_round(v0, v1, v2, v3);
+        __detail::__sip_round(v0, v1, v2, v3);
+        __detail::__sip_round(v0, v1, v2, v3);
+
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+
+    /**
+     * A fresh key per call: a 128-bit process secret drawn once from @c std::random_device, stepped through splitmix64 by
+     * an atomic counter. Cheap enough to seed every table, distinct across calls, but not a cryptographic generator.
+     */
+    sip_key random_sip_key();
+}
+
+#endif // __SIPHASH_H__
@@ -20,7 +20,7 @@ namespace stl
     struct random_access_iterator_tag : public bidirectional_iterator_tag {};
     
     /// @brief Primary template (fallback) | SFINAE Compatibility
-    template <typename Iterator, typename = __void_t<>>
+    template <typename Iterator, typename = void>
     struct __iterator_traits { };
 
     /**
@@ -35,12 +35,12 @@ namespace stl
      * @typedef @c `iterator_category`  -  category of the iterator `[input / output / forward / bidirectional / random access]`
      */
     template <typename Iterator>
-    struct __iterator_traits<Iterator, __void_t<
+    struct __iterator_traits<Iterator, typename __void_t<
         typename Iterator::difference_type,
         typename Iterator::value_type,
         typename Iterator::pointer,
         typename Iterator::reference,
-        typename Iterator::iterator_category>>
+        typename Iterator::iterator_category>::type>
     {
         typedef typename Iterator::difference_type     difference_type;
         typedef typename Iterator::value_type          value_type;
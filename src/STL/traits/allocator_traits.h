@@ -72,7 +72,7 @@ namespace stl
 
         template <typename T, typename... Args>
         static auto construct(Alloc& __a, T* __p, Args&&... __args) 
-        -> decltype(this->_S_construct(__a, __p, stl::forward<Args>(__args)...)) { _S_construct(__a, __p, stl::forward<Args>(__args)...); }
+        -> decltype(_S_construct(__a, __p, stl::forward<Args>(__args)...)) { _S_construct(__a, __p, stl::forward<Args>(__args)...); }
 
         template <typename T>
         static void destroy(Alloc& __a, T* __p) { _S_destroy(__a, __p, 0); }
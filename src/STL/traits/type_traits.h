@@ -87,7 +87,7 @@ namespace stl
     struct __and_<booleanT1, booleanT2> : public conditional<booleanT1::value, booleanT2, booleanT1>::type { };
 
     template <typename booleanT1, typename booleanT2, typename booleanT3, typename... booleanTn>
-    struct __and_<booleanT1, booleanT2, booleanT3, booleanTn...> : public conditional<booleanT1::value, booleanT1, __and_<booleanT2, booleanT3, booleanTn...>>::type { };
+    struct __and_<booleanT1, booleanT2, booleanT3, booleanTn...> : public conditional<booleanT1::value, __and_<booleanT2, booleanT3, booleanTn...>, booleanT1>::type { };
 
     template <typename booleanT>
     struct __not_ : public integral_constant<bool, !booleanT::value> { };
@@ -593,9 +593,19 @@ namespace stl
     template <typename T>
     struct is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> { };
 
+    /// @brief True when equal values of @c T have identical bytes: no padding, no floating point, no user-visible representation slack.
+    template <typename T>
+    struct has_unique_object_representations : public integral_constant<bool, __has_unique_object_representations(T)> { };
+
     template <typename Base, typename Derived>
     struct is_base_of : public integral_constant<bool, __is_base_of(Base, Derived)> { };
 
+    template <typename T, typename U>
+    struct is_same : public false_type { };
+
+    template <typename T>
+    struct is_same<T, T> : public true_type { };
+
     ////
     
     struct nonesuch
@@ -0,0 +1,152 @@
+#include "../STL/containers/concurrent_unordered_map/concurrent_unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+// The baseline this container replaces: one map behind one global lock.
+struct locked_umap
+{
+    std::mutex                     m_mutex;
+    stl::unordered_map<int, int>   m_map;
+
+    bool find(int key, int& value)
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        auto it = this->m_map.find(key);
+        if (it == this->m_map.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    void insert_or_assign(int key, int value)
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        auto it = this->m_map.find(key);
+        if (it != this->m_map.end()) it->second = value;
+        else this->m_map.emplace(key, value);
+    }
+
+    void erase(int key)
+    {
+        std::lock_guard<std::mutex> lock(this->m_mutex);
+        this->m_map.erase(key);
+    }
+};
+
+struct sharded_umap
+{
+    stl::concurrent_unordered_map<int, int> m_map;
+
+    sharded_umap() : m_map(64) { }
+
+    bool find(int key, int& value)
+    {
+        return this->m_map.cvisit(key, [&](const int& v) { value = v; });
+    }
+
+    void insert_or_assign(int key, int value) { this->m_map.insert_or_assign(key, value); }
+
+    void erase(int key) { this->m_map.erase(key); }
+};
+
+/**
+ * Runs @c ops operations split across @c threads workers on a map prefilled with @c keys keys. @c write_pct percent of the
+ * operations are writes (half insert_or_assign, half erase), the rest are finds. Reports the best of @c iters runs in Mops/s.
+ */
+template <class Map>
+double bench_mops(const char* name, unsigned threads, int write_pct, std::size_t keys, std::size_t ops, int iters = 3)
+{
+    double best = 0;
+
+    for (int it = 0; it < iters; ++it)
+    {
+        Map m;
+        for (std::size_t i = 0; i < keys; ++i) m.insert_or_assign((int)i, (int)i);
+
+        std::vector<std::thread> workers;
+        std::vector<std::uint64_t> sums(threads, 0);
+        auto t0 = clock_type::now();
+
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]{
+                std::uint64_t x = 0x9e3779b97f4a7c15ULL * (t + 1);
+                std::uint64_t acc = 0;
+                int value = 0;
+
+                for (std::size_t i = 0; i < ops / threads; ++i)
+                {
+                    std::uint64_t r = lcg_next(x);
+                    int k = (int)((r >> 16) % keys);
+
+                    if ((int)(r % 100) < write_pct)
+                    {
+                        if (r & 0x100) m.insert_or_assign(k, (int)i);
+                        else m.erase(k);
+                    }
+                    else if (m.find(k, value))
+                        acc += (std::uint64_t)value;
+                }
+
+                sums[t] = acc;
+            });
+        }
+
+        for (auto& w : workers) w.join();
+
+        auto t1 = clock_type::now();
+        for (std::uint64_t sum : sums) sink += sum;
+        double sec = std::chrono::duration<double>(t1 - t0).count();
+        double mops = ops / sec / 1e6;
+        if (mops > best) best = mops;
+    }
+
+    std::cout << name << " threads=" << threads << " writes=" << write_pct << "%: " << best << " Mops/s\n";
+    fout << name << " threads=" << threads << " writes=" << write_pct << "%: " << best << " Mops/s\n";
+
+    return best;
+}
+
+int main()
+{
+    const std::size_t K = 1 << 20;   // keys
+    const std::size_t O = 4000000;   // operations per run, split across the threads
+
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned max_threads = hw > 8 ? hw : 8;
+
+    std::cout << "K=" << K << " O=" << O << " hardware threads=" << hw << "\n\n";
+
+    for (int write_pct : {5, 50})
+    {
+        for (unsigned t = 1; t <= max_threads; t *= 2)
+        {
+            bench_mops<locked_umap>("global mutex + stl::unordered_map<int,int>", t, write_pct, K, O);
+            bench_mops<sharded_umap>("stl::concurrent_unordered_map<int,int> (64 shards)", t, write_pct, K, O);
+        }
+
+        std::cout << "\n";
+    }
+
+    std::cout << "Done. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
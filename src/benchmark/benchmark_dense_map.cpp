@@ -0,0 +1,105 @@
+#include "../STL/containers/unordered_map/unordered_map.h"
+#include "../STL/containers/flat_hash_map/flat_hash_map.h"
+#include "../STL/containers/dense_unordered_map/dense_unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+
+using clock_type = std::chrono::steady_clock;
+using ull = unsigned long long;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static void print_line(const std::string& line)
+{
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+static double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+// Best of a few full scans, so the first (cold) pass does not decide the figure.
+template <class Map>
+static double scan_ms(const Map& m)
+{
+    double best = 1e300;
+
+    for (int round = 0; round < 5; ++round)
+    {
+        auto t0 = clock_type::now();
+        ull sum = 0;
+
+        for (auto it = m.cbegin(); it != m.cend(); ++it)
+            sum += it->first ^ it->second;
+
+        double ms = ms_since(t0);
+        best = ms < best ? ms : best;
+        sink += sum;
+    }
+
+    return best;
+}
+
+// Fills n keys, then erases all but keep_percent of them: the bucket array stays at its full size, so the load
+// factor drops with the survivors. The scan time is reported for the survivors.
+template <class Map>
+static void run(const char* name, const std::vector<ull>& keys, std::size_t keep_percent)
+{
+    Map m;
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        m[keys[i]] = i;
+
+    std::size_t keep = keys.size() * keep_percent / 100;
+
+    for (std::size_t i = keep; i < keys.size(); ++i)
+        m.erase(keys[i]);
+
+    double ms = scan_ms(m);
+
+    print_line(std::string(name) + ": entries=" + std::to_string(m.size())
+               + " load=" + std::to_string((float)m.size() / m.bucket_count())
+               + " scan=" + std::to_string(ms) + " ms (" + std::to_string(ms * 1e6 / m.size()) + " ns/entry)");
+}
+
+int main()
+{
+    const std::size_t n = 1000000;
+    std::vector<ull> keys;
+    std::uint64_t x = 12345;
+
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        keys.push_back(lcg_next(x));
+
+    for (std::size_t keep : {100, 50, 10, 1})
+    {
+        print_line("--- " + std::to_string(n) + " keys inserted, " + std::to_string(keep) + "% kept");
+
+        run<std::unordered_map<ull, ull>>("std::unordered_map", keys, keep);
+        run<stl::unordered_map<ull, ull>>("stl::unordered_map", keys, keep);
+        run<stl::flat_hash_map<ull, ull>>("stl::flat_hash_map", keys, keep);
+        run<stl::dense_unordered_map<ull, ull>>("stl::dense_unordered_map", keys, keep);
+    }
+
+    std::cout << "\nDone. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
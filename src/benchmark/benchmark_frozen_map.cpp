@@ -0,0 +1,160 @@
+#include "../STL/containers/unordered_map/unordered_map.h"
+#include "../STL/containers/flat_hash_map/flat_hash_map.h"
+#include "../STL/containers/frozen_unordered_map/frozen_unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <malloc.h>
+
+using clock_type = std::chrono::steady_clock;
+using ull = unsigned long long;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static void print_line(const std::string& line)
+{
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+// Bytes held by malloc, mmap'ed blocks included: the difference around a build is the map's footprint.
+static std::size_t heap_bytes()
+{
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+static double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+static ull make_key(ull x, ull*) { return x; }
+static std::string make_key(ull x, std::string*) { return "key:" + std::to_string(x); }
+
+// Nanoseconds per find over probes, in the given order; hits add their value to the sink so the loads are kept.
+template <class Map, class Key>
+static double find_ns(const Map& m, const std::vector<Key>& probes)
+{
+    auto t0 = clock_type::now();
+    ull found = 0;
+
+    for (const Key& key : probes)
+    {
+        auto it = m.find(key);
+        if (it != m.cend())
+            found += it->second + 1;
+    }
+
+    double ns = ms_since(t0) * 1e6 / probes.size();
+    sink += found;
+    return ns;
+}
+
+template <class Map, class Key>
+static void report(const char* name, const Map& m, double build_ms, std::size_t bytes,
+                   const std::vector<Key>& hits, const std::vector<Key>& misses)
+{
+    double hit = find_ns(m, hits), miss = find_ns(m, misses);
+
+    print_line(std::string(name) + ": build=" + std::to_string((long long)build_ms) + " ms"
+               + " memory=" + std::to_string(bytes >> 20) + " MB (" + std::to_string((double)bytes / m.size()) + " B/key)"
+               + " hit=" + std::to_string(hit) + " ns miss=" + std::to_string(miss) + " ns");
+}
+
+template <class Map, class Key>
+static Map* build_by_insert(const std::vector<stl::pair<Key, ull>>& entries, double& ms, std::size_t& bytes)
+{
+    std::size_t before = heap_bytes();
+    auto t0 = clock_type::now();
+
+    Map* m = new Map();
+    m->reserve(entries.size());
+    for (const auto& entry : entries)
+        m->emplace(entry.first, entry.second);
+
+    ms = ms_since(t0);
+    bytes = heap_bytes() - before;
+    return m;
+}
+
+// n keys: unordered_map and flat_hash_map filled by insert, frozen_unordered_map frozen from the unordered_map
+// and from the entry range; hits in random order, misses on keys never inserted.
+template <class Key>
+static void run(const char* label, std::size_t n)
+{
+    using umap   = stl::unordered_map<Key, ull>;
+    using flat   = stl::flat_hash_map<Key, ull>;
+    using frozen = stl::frozen_unordered_map<Key, ull>;
+
+    std::vector<stl::pair<Key, ull>> entries;
+    std::vector<Key> hits, misses;
+    std::uint64_t x = 12345, y = 0x9e3779b97f4a7c15ULL;
+
+    entries.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        entries.push_back(stl::pair<Key, ull>(make_key(lcg_next(x), (Key*)nullptr), i));
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        hits.push_back(entries[(std::size_t)(lcg_next(y) >> 33) % n].first);
+        misses.push_back(make_key(lcg_next(y) | 1ULL << 63, (Key*)nullptr));
+    }
+
+    print_line(std::string("--- ") + label + ", " + std::to_string(n) + " keys");
+
+    double ms;
+    std::size_t bytes;
+
+    umap* chained = build_by_insert<umap>(entries, ms, bytes);
+    report("stl::unordered_map", *chained, ms, bytes, hits, misses);
+
+    {
+        std::size_t before = heap_bytes();
+        auto t0 = clock_type::now();
+        frozen* m = new frozen(*chained);
+        ms = ms_since(t0);
+        bytes = heap_bytes() - before;
+        report("stl::frozen_unordered_map from unordered_map", *m, ms, bytes, hits, misses);
+        delete m;
+    }
+
+    delete chained;
+
+    {
+        auto t0 = clock_type::now();
+        frozen m(entries.data(), entries.data() + entries.size());
+        ms = ms_since(t0);
+        print_line("stl::frozen_unordered_map from range: build=" + std::to_string((long long)ms) + " ms buckets="
+                   + std::to_string(m.bucket_count()));
+    }
+
+    flat* open = build_by_insert<flat>(entries, ms, bytes);
+    report("stl::flat_hash_map", *open, ms, bytes, hits, misses);
+    delete open;
+}
+
+int main()
+{
+    run<ull>("uint64 keys", 1000000);
+    run<ull>("uint64 keys", 10000000);
+    run<std::string>("std::string keys", 1000000);
+
+    std::cout << "\nDone. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
@@ -0,0 +1,517 @@
+#include "../STL/functional_hash/hash.h"
+#include "../STL/functional_hash/hash_policy.h"
+#include "../STL/functional_hash/seeded_hash.h"
+#include "../STL/containers/unordered_map/unordered_map.h"
+#include "../STL/containers/static_map/static_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static void print_line(const char* line)
+{
+    std::cout << line;
+    fout << line;
+}
+
+// Random value of T: every byte of the value representation random (see key_bits for how many of them count).
+template <class T>
+static T random_value(std::uint64_t& x)
+{
+    T value;
+    unsigned char bytes[sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(T); ++i) bytes[i] = (unsigned char)(lcg_next(x) >> 56);
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+static std::string random_value_string(std::uint64_t& x, std::size_t length)
+{
+    std::string s(length, ' ');
+    for (char& c : s) c = (char)('!' + (lcg_next(x) >> 58));
+    return s;
+}
+
+// Bits of T that carry the value: x87 long double has 80 of them, whatever sizeof says.
+template <class T> static std::size_t key_bits() { return sizeof(T) * 8; }
+template <> std::size_t key_bits<long double>() { return 80; }
+
+static void flip_bit(void* data, std::size_t bit)
+{ static_cast<unsigned char*>(data)[bit / 8] ^= (unsigned char)(1u << (bit % 8)); }
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Throughput
+
+template <class T, class H>
+void bench_throughput(const char* name, const std::vector<T>& values, H hash, std::size_t calls)
+{
+    double best = 1e30;
+
+    for (int it = 0; it < 3; ++it)
+    {
+        std::uint64_t acc = 0;
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0, j = 0; i < calls; ++i)
+        {
+            acc += hash(values[j]);
+            if (++j == values.size()) j = 0;
+        }
+        auto t1 = clock_type::now();
+
+        sink += acc;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / calls;
+        if (ns < best) best = ns;
+    }
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-38s %8.2f ns/hash\n", name, best);
+    print_line(line);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Avalanche: flipping any input bit should flip every output bit with probability 1/2.
+
+/**
+ * For @c samples random keys, flips each of the @c bits input bits in turn and counts which output bits change.
+ * Reports the worst |P(flip) - 1/2| over all (input bit, output bit) pairs (0 ideal, 0.5 for a bit that never or always
+ * flips) and the mean, the mean number of output bits flipped per input flip (32 ideal) and the dead input bits,
+ * whose flip never changed the hash.
+ */
+template <class Key, class Flip, class H>
+void avalanche_report(const char* name, std::size_t bits, std::size_t samples, Key (*make)(std::uint64_t&), Flip flip, H hash)
+{
+    const std::size_t out_bits = sizeof(std::size_t) * 8;
+    std::vector<std::uint32_t> flips(bits * out_bits, 0);
+    std::uint64_t x = 42, flipped_total = 0;
+
+    for (std::size_t s = 0; s < samples; ++s)
+    {
+        Key key = make(x);
+        std::size_t h = hash(key);
+
+        for (std::size_t i = 0; i < bits; ++i)
+        {
+            Key other = key;
+            flip(other, i);
+            std::size_t d = h ^ hash(other);
+
+            flipped_total += (std::uint64_t)__builtin_popcountll(d);
+            for (std::size_t j = 0; j < out_bits; ++j)
+                flips[i * out_bits + j] += (d >> j) & 1;
+        }
+    }
+
+    double worst = 0, mean = 0;
+    for (std::uint32_t f : flips)
+    {
+        double bias = (double)f / samples - 0.5;
+        if (bias < 0) bias = -bias;
+        if (bias > worst) worst = bias;
+        mean += bias;
+    }
+    mean /= flips.size();
+
+    std::size_t dead = 0;
+    for (std::size_t i = 0; i < bits; ++i)
+    {
+        std::uint64_t changed = 0;
+        for (std::size_t j = 0; j < out_bits; ++j) changed += flips[i * out_bits + j];
+        dead += changed == 0;
+    }
+
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-36s worst bias=%.3f mean bias=%.3f bits flipped=%5.2f/%zu dead bits=%zu/%zu\n",
+                  name, worst, mean, (double)flipped_total / (samples * bits), out_bits, dead, bits);
+    print_line(line);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Bucket distribution and collisions of a key set, sized like stl::unordered_map at its 0.75 load factor.
+
+/**
+ * Chi-square over the buckets normalised by its degrees of freedom (about 1.0 for a uniform hash), the longest chain,
+ * and the collision rate: the share of keys sharing a bucket with an earlier key, next to what a uniform hash gives
+ * at the same load. Indexing is the raw low bits (mask), the power2 policy (mix + mask) or the prime policy (modulo).
+ */
+void distribution_report(const char* name, const std::vector<std::size_t>& hashes)
+{
+    std::size_t wanted = (std::size_t)(hashes.size() / 0.75) + 1;
+
+    auto report = [&](const char* indexing, std::size_t buckets, auto index) {
+        std::vector<std::uint32_t> load(buckets, 0);
+        for (std::size_t h : hashes) ++load[index(h, buckets)];
+
+        double n = (double)hashes.size(), expected = n / buckets, chi2 = 0;
+        std::uint32_t max_load = 0;
+        std::size_t used = 0;
+
+        for (std::uint32_t l : load)
+        {
+            chi2 += (l - expected) * (l - expected) / expected;
+            if (l > max_load) max_load = l;
+            used += l != 0;
+        }
+
+        double uniform_used = buckets * (1 - std::exp(-expected));
+
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-36s %-7s chi2/df=%10.3f max=%-7u collisions=%.3f (uniform %.3f)\n",
+                      name, indexing, chi2 / (buckets - 1), max_load, (n - used) / n, (n - uniform_used) / n);
+        print_line(line);
+    };
+
+    report("mask", stl::power2_rehash_policy::next_bucket_count(wanted), [](std::size_t h, std::size_t n) { return h & (n - 1); });
+    report("power2", stl::power2_rehash_policy::next_bucket_count(wanted), stl::power2_rehash_policy::bucket_index);
+    report("prime", stl::prime_rehash_policy::next_bucket_count(wanted), stl::prime_rehash_policy::bucket_index);
+}
+
+template <class T, class H>
+std::vector<std::size_t> hash_all(const std::vector<T>& keys, H hash)
+{
+    std::vector<std::size_t> hashes;
+    hashes.reserve(keys.size());
+    for (const T& key : keys) hashes.push_back(hash(key));
+    return hashes;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Downstream: what the hash does to unordered_map lookups.
+
+template <class Map, class T>
+void bench_find(const char* name, const std::vector<T>& keys, std::size_t queries)
+{
+    Map m;
+    for (std::size_t i = 0; i < keys.size(); ++i) m.insert({keys[i], (int)i});
+
+    std::vector<std::size_t> order(queries);
+    std::uint64_t x = 99;
+    for (std::size_t& o : order) o = lcg_next(x) % keys.size();
+
+    double best = 1e30;
+
+    for (int it = 0; it < 3; ++it)
+    {
+        std::uint64_t acc = 0;
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < queries; ++i)
+        {
+            auto f = m.find(keys[order[i]]);
+            if (f != m.end()) acc += (std::uint64_t)f->second;
+        }
+        auto t1 = clock_type::now();
+
+        sink += acc;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / queries;
+        if (ns < best) best = ns;
+    }
+
+    stl::table_stats stats = m.stats();
+
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-50s %8.2f ns/find  max chain=%zu\n", name, best, stats.max_chain);
+    print_line(line);
+}
+
+template <class T, class H = stl::hash<T>>
+using power2_map = stl::unordered_map<T, int, H>;
+
+template <class T, class H = stl::hash<T>>
+using prime_map = stl::unordered_map<T, int, H, stl::equal_to<T>, stl::allocator<stl::pair_node<T, int>>, stl::prime_rehash_policy>;
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Adversarial keys: an attacker who knows the hash picks keys sharing one bucket.
+
+static std::uint64_t inverse_odd(std::uint64_t a)
+{
+    std::uint64_t x = a;
+    for (int i = 0; i < 5; ++i) x *= 2 - a * x;    // Newton: doubles the correct low bits per step
+    return x;
+}
+
+// Inverse of the power2 policy's fmix64, so a chosen mixed value can be turned back into the key producing it.
+static std::uint64_t unmix(std::uint64_t h)
+{
+    h ^= h >> 33;
+    h *= inverse_odd(0xc4ceb9fe1a85ec53ULL);
+    h ^= h >> 33;
+    h *= inverse_odd(0xff51afd7ed558ccdULL);
+    h ^= h >> 33;
+    return h;
+}
+
+/// Inserts @c keys, then looks each up once in random order; reports the build time, ns per find and the longest chain.
+template <class Map>
+void adversarial_run(const char* name, const std::vector<unsigned long long>& keys)
+{
+    Map m;
+
+    auto t0 = clock_type::now();
+    for (std::size_t i = 0; i < keys.size(); ++i) m.insert({keys[i], (int)i});
+    auto t1 = clock_type::now();
+
+    std::vector<std::size_t> order(keys.size());
+    std::uint64_t x = 7;
+    for (std::size_t& o : order) o = lcg_next(x) % keys.size();
+
+    std::uint64_t acc = 0;
+    auto t2 = clock_type::now();
+    for (std::size_t o : order) acc += (std::uint64_t)m.find(keys[o])->second;
+    auto t3 = clock_type::now();
+    sink += acc;
+
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-50s build=%9.2f ms %10.2f ns/find  max chain=%zu\n", name,
+                  std::chrono::duration<double, std::milli>(t1 - t0).count(),
+                  std::chrono::duration<double, std::nano>(t3 - t2).count() / keys.size(), m.stats().max_chain);
+    print_line(line);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Compile-time tables: literal keys looked up in a constexpr stl::static_map against a runtime-built unordered_map.
+
+constexpr auto opcode_table = stl::make_static_map<std::string_view, int>({
+    {"add", 0}, {"sub", 1}, {"mul", 2}, {"div", 3}, {"mod", 4}, {"and", 5}, {"or", 6}, {"xor", 7},
+    {"not", 8}, {"shl", 9}, {"shr", 10}, {"sar", 11}, {"load", 12}, {"store", 13}, {"push", 14}, {"pop", 15},
+    {"jump", 16}, {"jz", 17}, {"jnz", 18}, {"call", 19}, {"ret", 20}, {"cmp", 21}, {"test", 22}, {"mov", 23},
+    {"lea", 24}, {"inc", 25}, {"dec", 26}, {"neg", 27}, {"nop", 28}, {"halt", 29}, {"syscall", 30}, {"breakpoint", 31} });
+
+static_assert(opcode_table.at("syscall") == 30, "the opcode table is built and searched at compile time");
+
+constexpr auto port_table = stl::make_static_map<int, int>({
+    {21, 0}, {22, 1}, {23, 2}, {25, 3}, {53, 4}, {80, 5}, {110, 6}, {143, 7}, {443, 8}, {465, 9}, {587, 10},
+    {993, 11}, {995, 12}, {3306, 13}, {5432, 14}, {6379, 15}, {8080, 16}, {8443, 17}, {9200, 18}, {27017, 19} });
+
+template <class Keys, class Find>
+void bench_lookup(const char* name, const Keys& keys, Find find, std::size_t queries)
+{
+    std::vector<std::size_t> order(4096);
+    std::uint64_t x = 31;
+    for (std::size_t& o : order) o = lcg_next(x) % keys.size();
+
+    double best = 1e30;
+
+    for (int it = 0; it < 3; ++it)
+    {
+        std::uint64_t acc = 0;
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < queries; ++i) acc += (std::uint64_t)find(keys[order[i & 4095]]);
+        auto t1 = clock_type::now();
+
+        sink += acc;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / queries;
+        if (ns < best) best = ns;
+    }
+
+    char line[200];
+    std::snprintf(line, sizeof(line), "%-50s %8.2f ns/find\n", name, best);
+    print_line(line);
+}
+
+// Hashes a key with its stl::hash, flipping bits of the object representation for the avalanche test.
+template <class T>
+static void flip_value(T& value, std::size_t bit) { flip_bit(&value, bit); }
+
+static void flip_string(std::string& value, std::size_t bit) { flip_bit(&value[0], bit); }
+
+int main()
+{
+    const std::size_t C = 50000000;   // hash calls per throughput measurement
+    const std::size_t A = 2000;       // avalanche samples per input bit
+    const std::size_t K = 1 << 20;    // keys per distribution test
+    const std::size_t Q = 2000000;    // finds per downstream measurement
+    const std::size_t N = 20000;      // adversarial keys (quadratic to insert when they all collide)
+
+    std::cout << "C=" << C << " A=" << A << " K=" << K << " Q=" << Q << " N=" << N << "\n\n";
+
+    std::uint64_t x = 123456789ULL;
+
+    // Throughput per type over 4096 random values (cache resident).
+    {
+        std::vector<int> ints(4096);
+        std::vector<unsigned long long> ulls(4096);
+        std::vector<float> floats(4096);
+        std::vector<double> doubles(4096);
+        std::vector<long double> long_doubles(4096);
+        std::vector<const int*> pointers(4096);
+        std::vector<std::string> s8(4096), s32(4096), s128(4096);
+        std::vector<stl::pair<int, int>> int_pairs(4096);
+        std::vector<stl::pair<int, std::string>> mixed_pairs(4096);
+        std::vector<std::tuple<int, int, int>> triples(4096);
+
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            ints[i] = (int)lcg_next(x);
+            ulls[i] = lcg_next(x);
+            floats[i] = (float)(lcg_next(x) >> 40) / 7.0f;
+            doubles[i] = (double)(lcg_next(x) >> 11) / 7.0;
+            long_doubles[i] = (long double)(lcg_next(x) >> 11) / 7.0L;
+            pointers[i] = &ints[lcg_next(x) % 4096];
+            s8[i] = random_value_string(x, 8);
+            s32[i] = random_value_string(x, 32);
+            s128[i] = random_value_string(x, 128);
+            int_pairs[i] = stl::pair<int, int>((int)lcg_next(x), (int)lcg_next(x));
+            mixed_pairs[i] = stl::pair<int, std::string>((int)lcg_next(x), s8[i]);
+            triples[i] = std::tuple<int, int, int>((int)lcg_next(x), (int)lcg_next(x), (int)lcg_next(x));
+        }
+
+        bench_throughput("stl::hash<int>", ints, stl::hash<int>(), C);
+        bench_throughput("stl::hash<unsigned long long>", ulls, stl::hash<unsigned long long>(), C);
+        bench_throughput("stl::hash<float>", floats, stl::hash<float>(), C);
+        bench_throughput("stl::hash<double>", doubles, stl::hash<double>(), C);
+        bench_throughput("stl::hash<long double>", long_doubles, stl::hash<long double>(), C);
+        bench_throughput("stl::hash<const int*>", pointers, stl::hash<const int*>(), C);
+        bench_throughput("stl::hash<std::string> (8 B)", s8, stl::hash<std::string>(), C);
+        bench_throughput("stl::hash<std::string> (32 B)", s32, stl::hash<std::string>(), C);
+        bench_throughput("stl::hash<std::string> (128 B)", s128, stl::hash<std::string>(), C / 4);
+        bench_throughput("stl::seeded_hash<int>", ints, stl::seeded_hash<int>(), C);
+        bench_throughput("stl::seeded_hash<const int*>", pointers, stl::seeded_hash<const int*>(), C);
+        bench_throughput("stl::seeded_hash<std::string> (8 B)", s8, stl::seeded_hash<std::string>(), C);
+        bench_throughput("stl::seeded_hash<std::string> (32 B)", s32, stl::seeded_hash<std::string>(), C);
+        bench_throughput("stl::seeded_hash<std::string> (128 B)", s128, stl::seeded_hash<std::string>(), C / 4);
+        bench_throughput("stl::hash<pair<int, int>> (bytes)", int_pairs, stl::hash<stl::pair<int, int>>(), C);
+        bench_throughput("hash_values(int, int) (combine)", int_pairs,
+                         [](const stl::pair<int, int>& p) { return stl::hash_values(p.first, p.second); }, C);
+        bench_throughput("stl::hash<pair<int, std::string>>", mixed_pairs, stl::hash<stl::pair<int, std::string>>(), C);
+        bench_throughput("stl::hash<tuple<int, int, int>>", triples, stl::hash<std::tuple<int, int, int>>(), C);
+    }
+
+    std::cout << "\n";
+
+    // Avalanche of the raw hash; unordered_map's power2 policy post-mixes, the prime policy uses it as is.
+    avalanche_report("stl::hash<int>", key_bits<int>(), A, random_value<int>, flip_value<int>, stl::hash<int>());
+    avalanche_report("stl::hash<unsigned long long>", key_bits<unsigned long long>(), A, random_value<unsigned long long>,
+                     flip_value<unsigned long long>, stl::hash<unsigned long long>());
+    avalanche_report("stl::hash<float>", key_bits<float>(), A, random_value<float>, flip_value<float>, stl::hash<float>());
+    avalanche_report("stl::hash<double>", key_bits<double>(), A, random_value<double>, flip_value<double>, stl::hash<double>());
+    avalanche_report("stl::hash<long double>", key_bits<long double>(), A, random_value<long double>,
+                     flip_value<long double>, stl::hash<long double>());
+    avalanche_report("stl::hash<const int*>", key_bits<const int*>(), A, random_value<const int*>, flip_value<const int*>,
+                     stl::hash<const int*>());
+    avalanche_report("stl::hash<std::string> (16 B)", 16 * 8, A, +[](std::uint64_t& s) { return random_value_string(s, 16); },
+                     flip_string, stl::hash<std::string>());
+    avalanche_report("power2 policy mix of stl::hash<int>", key_bits<int>(), A, random_value<int>, flip_value<int>,
+                     [](int v) { return stl::__detail::__hash_mix(stl::hash<int>()(v)); });
+
+    std::cout << "\n";
+
+    // Distribution and collisions of structured key sets.
+    std::vector<int> sequential(K), strided(K);
+    std::vector<const void*> heap_pointers(K), array_pointers(K);
+    std::vector<std::string> names(K);
+    std::vector<double> grid(K);
+    std::vector<stl::pair<int, int>> tenants(K);
+
+    std::vector<std::unique_ptr<std::uint64_t[]>> blocks;
+    blocks.reserve(K);
+    static std::uint64_t slots[1 << 20][4];
+
+    for (std::size_t i = 0; i < K; ++i)
+    {
+        sequential[i] = (int)i;
+        strided[i] = (int)(i * 1024);
+        blocks.emplace_back(new std::uint64_t[3]);
+        heap_pointers[i] = blocks.back().get();
+        array_pointers[i] = &slots[i][0];
+        names[i] = "key_" + std::to_string(i);
+        grid[i] = (double)i * 0.25;
+        tenants[i] = stl::pair<int, int>((int)(i >> 10), (int)(i & 1023));   // (tenant_id, object_id)
+    }
+
+    distribution_report("sequential int", hash_all(sequential, stl::hash<int>()));
+    distribution_report("int * 1024", hash_all(strided, stl::hash<int>()));
+    distribution_report("heap pointers (24 B blocks)", hash_all(heap_pointers, stl::hash<const void*>()));
+    distribution_report("array pointers (32 B stride)", hash_all(array_pointers, stl::hash<const void*>()));
+    distribution_report("double i * 0.25", hash_all(grid, stl::hash<double>()));
+    distribution_report("string \"key_<i>\"", hash_all(names, stl::hash<std::string>()));
+    distribution_report("(tenant, object) xor of hashes", hash_all(tenants, [](const stl::pair<int, int>& p) {
+        return stl::hash<int>()(p.first) ^ stl::hash<int>()(p.second); }));
+    distribution_report("(tenant, object) hash_values", hash_all(tenants, [](const stl::pair<int, int>& p) {
+        return stl::hash_values(p.first, p.second); }));
+    distribution_report("(tenant, object) stl::hash<pair>", hash_all(tenants, stl::hash<stl::pair<int, int>>()));
+
+    std::cout << "\n";
+
+    // Downstream: find latency on maps of the same key sets (hits, random order).
+    bench_find<power2_map<int>>("stl::unordered_map<int> (power2) int * 1024", strided, Q);
+    bench_find<prime_map<int>>("stl::unordered_map<int> (prime) int * 1024", strided, Q);
+    bench_find<power2_map<const void*>>("stl::unordered_map<const void*> (power2) array ptrs", array_pointers, Q);
+    bench_find<prime_map<const void*>>("stl::unordered_map<const void*> (prime) array ptrs", array_pointers, Q);
+    bench_find<power2_map<double>>("stl::unordered_map<double> (power2) i * 0.25", grid, Q);
+    bench_find<prime_map<double>>("stl::unordered_map<double> (prime) i * 0.25", grid, Q);
+    bench_find<power2_map<std::string>>("stl::unordered_map<std::string> (power2) key_<i>", names, Q);
+    bench_find<prime_map<std::string>>("stl::unordered_map<std::string> (prime) key_<i>", names, Q);
+    bench_find<power2_map<stl::pair<int, int>>>("stl::unordered_map<pair<int, int>> (power2) tenants", tenants, Q);
+    bench_find<prime_map<stl::pair<int, int>>>("stl::unordered_map<pair<int, int>> (prime) tenants", tenants, Q);
+    bench_find<power2_map<int, stl::seeded_hash<int>>>("seeded_hash<int> (power2) int * 1024", strided, Q);
+    bench_find<prime_map<int, stl::seeded_hash<int>>>("seeded_hash<int> (prime) int * 1024", strided, Q);
+    bench_find<power2_map<std::string, stl::seeded_hash<std::string>>>("seeded_hash<std::string> (power2) key_<i>", names, Q);
+    bench_find<prime_map<std::string, stl::seeded_hash<std::string>>>("seeded_hash<std::string> (prime) key_<i>", names, Q);
+
+    std::cout << "\n";
+
+    // Adversarial keys against the fixed hash, then the same keys under a per-map seed.
+    {
+        typedef unsigned long long ull;
+
+        // prime policy: multiples of the bucket count the table ends at
+        prime_map<ull> probe;
+        for (std::size_t i = 0; i < N; ++i) probe.insert({(ull)i, 0});
+        std::size_t buckets = probe.stats().bucket_count;
+
+        std::vector<ull> multiples(N), preimages(N);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            multiples[i] = (ull)(i * buckets);
+            preimages[i] = unmix((std::uint64_t)i << 32);   // power2 policy: mixed values with 32 zero low bits
+        }
+
+        adversarial_run<prime_map<ull>>("stl::hash (prime) multiples of bucket count", multiples);
+        adversarial_run<prime_map<ull, stl::seeded_hash<ull>>>("stl::seeded_hash (prime) multiples of bucket count", multiples);
+        adversarial_run<power2_map<ull>>("stl::hash (power2) fmix64 preimages", preimages);
+        adversarial_run<power2_map<ull, stl::seeded_hash<ull>>>("stl::seeded_hash (power2) fmix64 preimages", preimages);
+    }
+
+    std::cout << "\n";
+
+    // Literal keys: constexpr static_map against unordered_map holding the same entries.
+    {
+        std::vector<std::string_view> opcodes;
+        std::vector<int> ports;
+        stl::unordered_map<std::string, int, stl::hash<std::string>, stl::equal_to<>> opcode_map;
+        stl::unordered_map<int, int> port_map;
+
+        for (const auto& entry : opcode_table) { opcodes.push_back(entry.first); opcode_map.insert({std::string(entry.first), entry.second}); }
+        for (const auto& entry : port_table) { ports.push_back(entry.first); port_map.insert({entry.first, entry.second}); }
+
+        bench_lookup("stl::unordered_map<std::string> opcodes", opcodes, [&](std::string_view k) { return opcode_map.find(k)->second; }, Q);
+        bench_lookup("constexpr stl::static_map<std::string_view> opcodes", opcodes, [](std::string_view k) { return opcode_table.find(k)->second; }, Q);
+        bench_lookup("stl::unordered_map<int> ports", ports, [&](int k) { return port_map.find(k)->second; }, Q);
+        bench_lookup("constexpr stl::static_map<int> ports", ports, [](int k) { return port_table.find(k)->second; }, Q);
+    }
+
+    std::cout << "\nDone. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
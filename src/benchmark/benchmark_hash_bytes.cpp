@@ -0,0 +1,220 @@
+#include "../STL/functional_hash/hash.h"
+#include "../STL/functional_hash/hash_policy.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+// The byte-at-a-time FNV-1a loop hash_bytes used to be, kept as the baseline; out of line like hash_bytes itself.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+static std::size_t fnv1a_bytes(const void* ptr, std::size_t length, std::size_t seed)
+{
+    const unsigned char* data = static_cast<const unsigned char*>(ptr);
+    std::size_t hash = seed;
+
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+// The 5 * h + c recurrence stl::hash<const char*> used to be, kept as the baseline.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+static std::size_t legacy_string_hash(const char* str)
+{
+    unsigned long hash_value = 0;
+
+    for (; *str; ++str)
+        hash_value = 5 * hash_value + *str;
+
+    return static_cast<std::size_t>(hash_value);
+}
+
+/**
+ * Hashes keys of @c length bytes taken at successive offsets of @c buffer (a small working set, so the data is cache
+ * resident up to the largest keys) until about @c budget bytes went through, and reports the best of @c iters runs
+ * in GB/s and ns per hash. The calls are independent, so this is throughput, not latency.
+ */
+template <class F>
+double bench_gbps(const char* name, F&& f, const std::vector<unsigned char>& buffer, std::size_t length, std::size_t budget, int iters = 3)
+{
+    std::size_t calls = budget / length;
+    if (calls < 16) calls = 16;
+    if (calls > 20000000) calls = 20000000;
+
+    std::size_t span = buffer.size() - length;
+    double best = 0;
+
+    for (int it = 0; it < iters; ++it)
+    {
+        std::uint64_t acc = 0;
+        std::size_t offset = 0;
+
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < calls; ++i)
+        {
+            acc += f(buffer.data() + offset, length, 0xc70f6907UL);
+            offset += 64;
+            if (offset > span) offset = 0;
+        }
+        auto t1 = clock_type::now();
+
+        sink += acc;
+        double sec = std::chrono::duration<double>(t1 - t0).count();
+        double gbps = (double)calls * length / sec / 1e9;
+        if (gbps > best) best = gbps;
+    }
+
+    double ns = length / best;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-22s %8zu B: %8.3f GB/s %10.2f ns/hash\n", name, length, best, ns);
+    std::cout << line;
+    fout << line;
+
+    return best;
+}
+
+// Hashes every NUL-terminated key of @c keys once per pass until about @c budget bytes went through; best of @c iters in ns per key.
+template <class F>
+void bench_strings(const char* name, F&& f, const std::vector<std::string>& keys, std::size_t budget, int iters = 3)
+{
+    std::size_t bytes = 0;
+    for (const std::string& key : keys) bytes += key.size();
+
+    std::size_t passes = budget / bytes + 1;
+    double best = 1e30;
+
+    for (int it = 0; it < iters; ++it)
+    {
+        std::uint64_t acc = 0;
+
+        auto t0 = clock_type::now();
+        for (std::size_t p = 0; p < passes; ++p)
+            for (const std::string& key : keys) acc += f(key.c_str());
+        auto t1 = clock_type::now();
+
+        sink += acc;
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (passes * keys.size());
+        if (ns < best) best = ns;
+    }
+
+    char line[160];
+    std::snprintf(line, sizeof(line), "%-26s %6zu B keys: %8.2f ns/key %8.3f GB/s\n", name, keys[0].size(), best, keys[0].size() / best);
+    std::cout << line;
+    fout << line;
+}
+
+/**
+ * Bucket distribution of @c keys hashed by @c f in a table sized like stl::unordered_map's at its 0.75 load factor, under
+ * the raw low bits (mask), the power2 policy (mix + mask) and the prime policy (modulo). Chi-square is normalised by its
+ * degrees of freedom, so a uniform hash reads about 1.0; max is the longest chain.
+ */
+template <class F>
+void distribution_report(const char* name, F&& f, const std::vector<std::string>& keys)
+{
+    std::vector<std::size_t> hashes;
+    for (const std::string& key : keys) hashes.push_back(f(key.c_str()));
+
+    std::size_t wanted = (std::size_t)(keys.size() / 0.75) + 1;
+
+    auto report = [&](const char* indexing, std::size_t buckets, auto index) {
+        std::vector<std::uint32_t> load(buckets, 0);
+        for (std::size_t h : hashes) ++load[index(h, buckets)];
+
+        double expected = (double)keys.size() / buckets, chi2 = 0;
+        std::uint32_t max_load = 0;
+        std::size_t empty = 0;
+
+        for (std::uint32_t l : load)
+        {
+            chi2 += (l - expected) * (l - expected) / expected;
+            if (l > max_load) max_load = l;
+            empty += l == 0;
+        }
+
+        char line[200];
+        std::snprintf(line, sizeof(line), "%-26s %-7s buckets=%-8zu chi2/df=%9.3f max=%-6u empty=%.3f\n",
+                      name, indexing, buckets, chi2 / (buckets - 1), max_load, (double)empty / buckets);
+        std::cout << line;
+        fout << line;
+    };
+
+    report("mask", stl::power2_rehash_policy::next_bucket_count(wanted), [](std::size_t h, std::size_t n) { return h & (n - 1); });
+    report("power2", stl::power2_rehash_policy::next_bucket_count(wanted), stl::power2_rehash_policy::bucket_index);
+    report("prime", stl::prime_rehash_policy::next_bucket_count(wanted), stl::prime_rehash_policy::bucket_index);
+}
+
+int main()
+{
+    const std::size_t B = 1 << 28;   // bytes hashed per measurement
+
+    std::vector<unsigned char> buffer((1 << 20) + (1 << 16));
+    std::uint64_t x = 123456789ULL;
+    for (auto& c : buffer) { x = x * 2862933555777941757ULL + 3037000493ULL; c = (unsigned char)(x >> 56); }
+
+    std::cout << "B=" << B << " bytes per measurement\n\n";
+
+    for (std::size_t length : {1, 3, 4, 8, 12, 16, 24, 32, 48, 64, 100, 128, 256, 257, 512, 1024, 4096, 16384, 65536, 262144, 1048576})
+    {
+        bench_gbps("FNV-1a (previous)", fnv1a_bytes, buffer, length, length >= 4096 ? B / 8 : B);
+        bench_gbps("stl::hash_bytes", stl::hash_bytes, buffer, length, B);
+        std::cout << "\n";
+    }
+
+    // String keys: stl::hash<const char*> (strlen + hash_bytes) against the old recurrence, then the bucket spread of both.
+    auto make_keys = [](std::size_t count, std::size_t length) {
+        std::vector<std::string> keys(count);
+        std::uint64_t x = 555555555ULL;
+        for (auto& key : keys)
+            for (std::size_t i = 0; i < length; ++i) { x = x * 2862933555777941757ULL + 3037000493ULL; key += (char)('a' + (x >> 59)); }
+        return keys;
+    };
+
+    for (std::size_t length : {4, 8, 16, 32, 64, 256})
+    {
+        std::vector<std::string> keys = make_keys(4096, length);
+        bench_strings("legacy 5*h+c (previous)", legacy_string_hash, keys, B / 8);
+        bench_strings("stl::hash<const char*>", stl::hash<const char*>(), keys, B / 8);
+        std::cout << "\n";
+    }
+
+    const std::size_t K = 1 << 20;
+    std::vector<std::string> sequential(K), paths(K), numbers(K);
+    for (std::size_t i = 0; i < K; ++i)
+    {
+        sequential[i] = "key_" + std::to_string(i);
+        paths[i] = "/api/v1/tenants/" + std::to_string(i % 1024) + "/objects/" + std::to_string(i / 1024) + "/meta";
+        numbers[i] = std::to_string(i * 1000);
+    }
+
+    for (auto& set : {std::make_pair("\"key_<i>\"", &sequential), std::make_pair("URL paths", &paths), std::make_pair("decimal i*1000", &numbers)})
+    {
+        std::cout << set.first << ", " << K << " keys\n";
+        fout << set.first << ", " << K << " keys\n";
+        distribution_report("legacy 5*h+c (previous)", legacy_string_hash, *set.second);
+        distribution_report("stl::hash<const char*>", stl::hash<const char*>(), *set.second);
+        std::cout << "\n";
+    }
+
+    std::cout << "Done. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include "../STL/containers/mapped_unordered_map/mapped_unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+// Build with STL/containers/mapped_unordered_map/mapped_file.cpp and STL/functional_hash/hash_bytes.cpp.
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+using u64 = std::uint64_t;
+using u64_entry = stl::pair_node<u64, u64>;
+using mapped_u64_map = stl::mapped_unordered_map<u64, u64>;
+
+static const char* const IMAGE_PATH = "benchmark_mapped_map.img";
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+static void print_line(const std::string& line)
+{
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+// Drops the image's pages from the page cache where the system allows it, so the next open reads it from the disk
+// as a fresh process after a reboot would; elsewhere the "cold" numbers are warm page cache numbers.
+static bool evict_image()
+{
+#if defined(POSIX_FADV_DONTNEED)
+    int fd = ::open(IMAGE_PATH, O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    ::fdatasync(fd);
+    bool evicted = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+    ::close(fd);
+
+    return evicted;
+#else
+    return false;
+#endif
+}
+
+// Q lookups of keys picked at random, half of them present; returns nanoseconds per lookup.
+template <class Map>
+static double lookup_ns(const Map& m, const std::vector<u64>& probes)
+{
+    auto t0 = clock_type::now();
+
+    for (u64 key : probes)
+        sink += m.contains(key);
+
+    return ms_since(t0) * 1e6 / (double)probes.size();
+}
+
+int main()
+{
+    const std::size_t Q = 1000000;  // lookups per latency run
+
+    for (std::size_t count : {std::size_t(1000000), std::size_t(10000000)})
+    {
+        std::vector<u64_entry> entries;
+        std::vector<u64> probes;
+        std::uint64_t x = 987654321ULL;
+
+        entries.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            entries.push_back(u64_entry(lcg_next(x), i));
+
+        probes.reserve(Q);
+        for (std::size_t i = 0; i < Q; ++i)
+            probes.push_back(i % 2 == 0 ? entries[lcg_next(x) % count].m_pair.first : lcg_next(x));
+
+        std::string suffix = " (" + std::to_string(count) + " <u64,u64>)";
+
+        // what a process pays at every start today: building the map from entries already in memory, a lower bound
+        auto t0 = clock_type::now();
+        stl::unordered_map<u64, u64> built;
+        built.insert(entries.data(), entries.data() + entries.size());
+        print_line("rebuild stl::unordered_map" + suffix + ": " + std::to_string(ms_since(t0)) + " ms");
+
+        t0 = clock_type::now();
+        mapped_u64_map::write(IMAGE_PATH, built);
+        print_line("write image once" + suffix + ": " + std::to_string(ms_since(t0)) + " ms");
+
+        const bool cold = evict_image();
+        const std::string cache = cold ? " [evicted from page cache]" : " [page cache warm]";
+
+        t0 = clock_type::now();
+        {
+            mapped_u64_map view(IMAGE_PATH);
+            sink += view.size();
+            print_line("open mapped_unordered_map" + suffix + cache + ": " + std::to_string(ms_since(t0)) + " ms");
+
+            // the first lookups after a start fault their pages in
+            t0 = clock_type::now();
+            for (std::size_t i = 0; i < 1000; ++i)
+                sink += view.contains(probes[i]);
+            print_line("first 1000 lookups after open" + suffix + cache + ": " + std::to_string(ms_since(t0)) + " ms");
+        }
+
+        evict_image();
+
+        t0 = clock_type::now();
+        {
+            mapped_u64_map view(IMAGE_PATH);
+            sink += lookup_ns(view, probes);
+            print_line("open + " + std::to_string(Q) + " lookups" + suffix + cache + ": " + std::to_string(ms_since(t0)) + " ms");
+        }
+
+        mapped_u64_map view(IMAGE_PATH);
+        lookup_ns(view, probes);
+        lookup_ns(built, probes);
+
+        print_line("lookup latency stl::unordered_map" + suffix + ": " + std::to_string(lookup_ns(built, probes)) + " ns");
+        print_line("lookup latency mapped_unordered_map" + suffix + ": " + std::to_string(lookup_ns(view, probes)) + " ns");
+
+        std::cout << "\n";
+    }
+
+    std::remove(IMAGE_PATH);
+
+    std::cout << "Done. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
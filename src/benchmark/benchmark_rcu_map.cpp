@@ -0,0 +1,184 @@
+#include "../STL/containers/rcu_unordered_map/rcu_unordered_map.h"
+#include "../STL/containers/concurrent_unordered_map/concurrent_unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Build with STL/functional_hash/hash_bytes.cpp and -pthread.
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+// The usual way to share a read-mostly table: one map behind one reader-writer lock.
+struct shared_locked_umap
+{
+    std::shared_mutex              m_mutex;
+    stl::unordered_map<int, int>   m_map;
+
+    bool find(int key, int& value)
+    {
+        std::shared_lock<std::shared_mutex> lock(this->m_mutex);
+        auto it = this->m_map.find(key);
+        if (it == this->m_map.end()) return false;
+        value = it->second;
+        return true;
+    }
+
+    void insert_or_assign(int key, int value)
+    {
+        std::unique_lock<std::shared_mutex> lock(this->m_mutex);
+        auto it = this->m_map.find(key);
+        if (it != this->m_map.end()) it->second = value;
+        else this->m_map.emplace(key, value);
+    }
+};
+
+struct sharded_umap
+{
+    stl::concurrent_unordered_map<int, int> m_map;
+
+    sharded_umap() : m_map(64) { }
+
+    bool find(int key, int& value)
+    {
+        return this->m_map.cvisit(key, [&](const int& v) { value = v; });
+    }
+
+    void insert_or_assign(int key, int value) { this->m_map.insert_or_assign(key, value); }
+};
+
+struct rcu_umap
+{
+    stl::rcu_unordered_map<int, int> m_map;
+
+    bool find(int key, int& value)
+    {
+        return this->m_map.cvisit(key, [&](const int& v) { value = v; });
+    }
+
+    void insert_or_assign(int key, int value) { this->m_map.insert_or_assign(key, value); }
+};
+
+/**
+ * @c readers threads look up random keys of a map prefilled with @c keys keys for @c ms milliseconds, while one writer
+ * overwrites random keys, pausing @c pause_us microseconds between updates (0: back to back). Reports the best of
+ * @c iters runs: the readers' combined Mops/s and the updates the writer got through.
+ */
+template <class Map>
+void bench_read_mostly(const char* name, unsigned readers, unsigned pause_us, std::size_t keys, int ms, int iters = 3)
+{
+    double best = 0;
+    std::uint64_t best_writes = 0;
+
+    for (int it = 0; it < iters; ++it)
+    {
+        Map m;
+        for (std::size_t i = 0; i < keys; ++i) m.insert_or_assign((int)i, (int)i);
+
+        std::atomic<bool> stop(false);
+        std::vector<std::thread> workers;
+        std::vector<std::uint64_t> reads(readers, 0);
+        std::vector<std::uint64_t> sums(readers, 0);
+        std::uint64_t writes = 0;
+        auto t0 = clock_type::now();
+
+        for (unsigned t = 0; t < readers; ++t)
+        {
+            workers.emplace_back([&, t]{
+                std::uint64_t x = 0x9e3779b97f4a7c15ULL * (t + 1);
+                std::uint64_t acc = 0, count = 0;
+                int value = 0;
+
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    for (int i = 0; i < 256; ++i, ++count)
+                        if (m.find((int)((lcg_next(x) >> 16) % keys), value))
+                            acc += (std::uint64_t)value;
+                }
+
+                sums[t] = acc;
+                reads[t] = count;
+            });
+        }
+
+        std::thread writer([&]{
+            std::uint64_t x = 12345;
+
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                m.insert_or_assign((int)((lcg_next(x) >> 16) % keys), (int)writes);
+                ++writes;
+
+                if (pause_us != 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(pause_us));
+            }
+        });
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+        stop = true;
+
+        for (auto& w : workers) w.join();
+        writer.join();
+
+        double sec = std::chrono::duration<double>(clock_type::now() - t0).count();
+        std::uint64_t total = 0;
+        for (std::uint64_t r : reads) total += r;
+        for (std::uint64_t sum : sums) sink += sum;
+
+        double mops = total / sec / 1e6;
+        if (mops > best)
+        {
+            best = mops;
+            best_writes = writes;
+        }
+    }
+
+    std::string line = std::string(name) + " readers=" + std::to_string(readers) + " writer pause=" + std::to_string(pause_us) +
+                       "us: " + std::to_string(best) + " Mreads/s, " + std::to_string(best_writes) + " writes";
+
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+int main()
+{
+    const std::size_t K = 1 << 16;   // keys: a routing or configuration table, not a database
+    const int MS = 300;              // milliseconds per run
+
+    unsigned hw = std::thread::hardware_concurrency();
+
+    std::cout << "K=" << K << " run=" << MS << "ms hardware threads=" << hw << "\n\n";
+
+    for (unsigned pause_us : {100u, 0u})
+    {
+        for (unsigned readers : {1u, 2u, 4u, 8u})
+        {
+            bench_read_mostly<shared_locked_umap>("shared_mutex + stl::unordered_map<int,int>", readers, pause_us, K, MS);
+            bench_read_mostly<sharded_umap>("stl::concurrent_unordered_map<int,int> (64 shards)", readers, pause_us, K, MS);
+            bench_read_mostly<rcu_umap>("stl::rcu_unordered_map<int,int>", readers, pause_us, K, MS);
+        }
+
+        std::cout << "\n";
+    }
+
+    std::cout << "Done. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
@@ -1,10 +1,15 @@
 #include "../STL/containers/unordered_map/unordered_map.h"
+#include "../STL/containers/flat_hash_map/flat_hash_map.h"
 
 #include <iostream>
 #include <unordered_map>
 #include <chrono>
 #include <cstdint>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <string_view>
 
 using clock_type = std::chrono::steady_clock;
 static volatile std::uint64_t sink = 0;
@@ -17,6 +22,24 @@ struct Big {
     Big(int x) { a[0] = x; }
 };
 
+// same map with the modulo-by-prime bucket indexing, to compare against the default power-of-two mask
+using prime_umap = stl::unordered_map<int, Big, stl::hash<int>, stl::equal_to<int>, stl::allocator<stl::pair_node<int, Big>>, stl::prime_rehash_policy>;
+
+// same map drawing its nodes from slabs instead of one ::operator new per element
+using pooled_umap = stl::unordered_map<int, Big, stl::hash<int>, stl::equal_to<int>, stl::pool_allocator<stl::pair_node<int, Big>>>;
+
+// same map growing incrementally instead of rehashing everything on the insert that crosses the load factor
+using incremental_umap = stl::unordered_map<int, Big, stl::hash<int>, stl::equal_to<int>, stl::allocator<stl::pair_node<int, Big>>, stl::incremental_rehash_policy<>>;
+
+// std::string keys searched by std::string_view: the transparent map hashes and compares the view directly,
+// the plain one needs a std::string (one heap allocation for keys past the SSO size) per lookup
+using transparent_string_umap = stl::unordered_map<std::string, int, stl::hash<std::string>, stl::equal_to<>>;
+using string_umap = stl::unordered_map<std::string, int, stl::hash<std::string>, stl::equal_to<std::string>>;
+
+// same maps with the statistics counters compiled in, for dump_stats
+template <class RehashPolicy>
+using stats_umap = stl::unordered_map<int, Big, stl::hash<int>, stl::equal_to<int>, stl::allocator<stl::pair_node<int, Big>>, RehashPolicy, true>;
+
 template <class F>
 long long bench_ms(const char* name, F&& f, int warmup = 1, int iters = 5)
 {
@@ -56,6 +79,104 @@ static void touch_map(Map& m)
     }
 }
 
+// Times every single insert and reports the tail: the best-of-N wall time of bench_ms hides the inserts that trigger a rehash.
+template <class Map>
+void bench_insert_latency(const char* name, std::size_t n)
+{
+    std::vector<std::uint32_t> ns(n);
+    Map m;
+    std::uint64_t x = 987654321ULL;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        int k = (int)(lcg_next(x) & 0x7fffffff);
+
+        auto t0 = clock_type::now();
+        m.insert({k, Big(k)});
+        auto t1 = clock_type::now();
+
+        ns[i] = (std::uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+
+    touch_map(m);
+    std::sort(ns.begin(), ns.end());
+
+    auto pct = [&](double p) { return ns[(std::size_t)(p * (n - 1))]; };
+
+    std::cout << name << ": p50=" << pct(.5) << " p99=" << pct(.99) << " p999=" << pct(.999)
+              << " p9999=" << pct(.9999) << " max=" << ns[n - 1] << " ns\n";
+    fout << name << ": p50=" << pct(.5) << " p99=" << pct(.99) << " p999=" << pct(.999)
+         << " p9999=" << pct(.9999) << " max=" << ns[n - 1] << " ns\n";
+}
+
+// count maps of n entries each, filled, probed on every key and on as many missing keys, then destroyed.
+template <class Map>
+static void tiny_maps(std::size_t count, int n)
+{
+    std::uint64_t x = 31415926ULL, acc = 0;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Map m;
+        int base = (int)(lcg_next(x) >> 40);
+
+        for (int k = 0; k < n; ++k)
+            m.insert({base + 7 * k, k});
+
+        for (int k = 0; k < n; ++k)
+        {
+            auto hit = m.find(base + 7 * k);
+            if (hit != m.end()) acc += (std::uint64_t)hit->second;
+
+            acc += m.count(base + 7 * k + 3);
+        }
+    }
+
+    sink += acc;
+}
+
+template <class Out>
+static void write_stats(Out& out, const char* name, const stl::table_stats& s)
+{
+    out << name << ": size=" << s.size << " buckets=" << s.bucket_count << " load=" << (double)s.size / s.bucket_count
+        << " max_chain=" << s.max_chain << "\n"
+        << "  chains:";
+    for (std::size_t i = 0; i < stl::table_stats::__HISTOGRAM_SIZE; ++i)
+        if (s.chain_histogram[i] != 0)
+            out << " [" << i << (i + 1 == stl::table_stats::__HISTOGRAM_SIZE ? "+" : "") << "]=" << s.chain_histogram[i];
+    out << "\n"
+        << "  finds: hit=" << s.find_hits << " (" << s.avg_probes_hit << " probes) miss=" << s.find_misses
+        << " (" << s.avg_probes_miss << " probes)\n"
+        << "  rehash: count=" << s.rehash_count << " time=" << s.rehash_ms << " ms\n"
+        << "  memory: buckets=" << s.bucket_bytes << " B nodes=" << s.node_bytes << " B\n";
+}
+
+// Prints the statistics of a map instantiated with CollectStats, to stdout and data.out.
+template <class Map>
+void dump_stats(const char* name, const Map& m)
+{
+    stl::table_stats s = m.stats();
+    write_stats(std::cout, name, s);
+    write_stats(fout, name, s);
+}
+
+// Random inserts (no reserve) then Q hits and Q misses on an instrumented map, to explain the timings above.
+template <class Map>
+void stats_run(const char* name, std::size_t n, std::size_t q)
+{
+    Map m;
+    std::vector<int> keys(n);
+    std::uint64_t x = 123456789ULL;
+    for (std::size_t i = 0; i < n; ++i) { keys[i] = (int)(lcg_next(x) & 0x3fffffff); m.insert({keys[i], Big(keys[i])}); }
+
+    std::uint64_t acc = 0;
+    for (std::size_t i = 0; i < q; ++i) acc += m.contains(keys[lcg_next(x) % n]);
+    for (std::size_t i = 0; i < q; ++i) acc += m.contains((int)(0x40000000 | (lcg_next(x) & 0x3fffffff)));
+    sink += acc;
+
+    dump_stats(name, m);
+}
+
 int main()
 {
     const std::size_t N = 1000000; // number of insertions
@@ -86,6 +207,16 @@ int main()
         touch_map(m);
     });
 
+    bench_ms("stl::flat_hash_map<int,Big> insert (no reserve)", [&]{
+        stl::flat_hash_map<int, Big> m;
+        std::uint64_t x = 123456789ULL;
+        for (std::size_t i = 0; i < N; ++i) {
+            int k = (int)(lcg_next(x) & 0x7fffffff);
+            m.insert({k, Big(k)});
+        }
+        touch_map(m);
+    });
+
     std::cout << "\n";
 
     bench_ms("std::unordered_map<int,Big> insert (reserve)", [&]{
@@ -186,6 +317,42 @@ int main()
         sink += acc;
     });
 
+    bench_ms("stl::unordered_map<int,Big> (prime policy) find HINT", [&]{
+        prime_umap m;
+        m.rehash(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 111111111ULL;
+        std::uint64_t acc = 0;
+
+        for (std::size_t i = 0; i < Q; ++i) 
+        {
+            int k = (int)(lcg_next(x) % N);
+            auto it = m.find(k);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+
+        sink += acc;
+    });
+
+    bench_ms("stl::flat_hash_map<int,Big> find HINT", [&]{
+        stl::flat_hash_map<int, Big> m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 111111111ULL;
+        std::uint64_t acc = 0;
+
+        for (std::size_t i = 0; i < Q; ++i) 
+        {
+            int k = (int)(lcg_next(x) % N);
+            auto it = m.find(k);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+
+        sink += acc;
+    });
+
     std::cout << "\n";
 
     bench_ms("std::unordered_map<int,Big> find MISS", [&]{
@@ -220,6 +387,91 @@ int main()
         sink += acc;
     });
 
+    bench_ms("stl::unordered_map<int,Big> (prime policy) find MISS", [&]{
+        prime_umap m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 222222222ULL;
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Q; ++i) {
+            int k = (int)(N + (lcg_next(x) % N)); // miss
+            auto it = m.find(k);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+        sink += acc;
+    });
+
+    bench_ms("stl::flat_hash_map<int,Big> find MISS", [&]{
+        stl::flat_hash_map<int, Big> m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 222222222ULL;
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Q; ++i) {
+            int k = (int)(N + (lcg_next(x) % N)); // miss
+            auto it = m.find(k);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+        sink += acc;
+    });
+
+    std::cout << "\n";
+
+    // Batched lookups: random hits on a table larger than the LLC (16M small nodes, ~800 MB with buckets), built once
+    // outside the timed region. The scalar loop issues bucket miss -> node miss per key; find_batch pipelines them across
+    // keys. Queries come in requests of 256 keys whose results are consumed right away.
+    {
+        const std::size_t L = 16 * N;
+        const std::size_t R = 256;
+
+        stl::unordered_map<int, int> m;
+        std::vector<int> keys(L);
+        std::uint64_t x = 888888888ULL;
+        for (std::size_t i = 0; i < L; ++i) { keys[i] = (int)(lcg_next(x) & 0x7fffffff); m.insert({keys[i], keys[i]}); }
+
+        std::vector<int> queries(Q);
+        for (std::size_t i = 0; i < Q; ++i) queries[i] = keys[lcg_next(x) % L];
+
+        std::vector<stl::unordered_map<int, int>::iterator> found(R);
+
+        bench_ms("stl::unordered_map<int,int> find HIT random, larger than LLC (scalar)", [&]{
+            std::uint64_t acc = 0;
+            for (std::size_t i = 0; i < Q; ++i) {
+                auto it = m.find(queries[i]);
+                if (it != m.end()) acc += (std::uint64_t)it->second;
+            }
+            sink += acc;
+        });
+
+        bench_ms("stl::unordered_map<int,int> find HIT random, larger than LLC (find_batch)", [&]{
+            std::uint64_t acc = 0;
+            for (std::size_t first = 0; first < Q; first += R) {
+                m.find_batch(queries.data() + first, R, found.data());
+                for (std::size_t i = 0; i < R; ++i)
+                    if (found[i] != m.end()) acc += (std::uint64_t)found[i]->second;
+            }
+            sink += acc;
+        });
+
+        bench_ms("stl::unordered_map<int,int> contains random, larger than LLC (scalar)", [&]{
+            std::uint64_t acc = 0;
+            for (std::size_t i = 0; i < Q; ++i) acc += m.contains(queries[i]);
+            sink += acc;
+        });
+
+        bench_ms("stl::unordered_map<int,int> contains random, larger than LLC (contains_batch)", [&]{
+            std::uint64_t acc = 0;
+            bool out[R];
+            for (std::size_t first = 0; first < Q; first += R) {
+                m.contains_batch(queries.data() + first, R, out);
+                for (std::size_t i = 0; i < R; ++i) acc += out[i];
+            }
+            sink += acc;
+        });
+    }
+
     std::cout << "\n";
 
     bench_ms("std::unordered_map<int,Big> erase by key", [&]{
@@ -254,6 +506,274 @@ int main()
         sink += m.size();
     });
 
+    bench_ms("stl::flat_hash_map<int,Big> erase by key", [&]{
+        stl::flat_hash_map<int, Big> m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 333333333ULL;
+        std::size_t removed = 0;
+        for (std::size_t i = 0; i < E; ++i) 
+        {
+            int k = (int)(lcg_next(x) % N);
+            removed += (m.erase(k) != 0);
+        }
+        sink += removed;
+        sink += m.size();
+    });
+
+    std::cout << "\n";
+
+    // Heterogeneous lookup: the queries only exist as views into one character buffer, as when parsing input.
+    const std::size_t SK = N / 4;
+    std::vector<std::string> skeys(SK);
+    std::string sbuffer;
+    std::vector<std::string_view> squeries(Q);
+    {
+        for (std::size_t i = 0; i < SK; ++i) skeys[i] = "tenant/object/" + std::to_string(i * 7919) + "/attribute";
+        for (std::size_t i = 0; i < SK; ++i) sbuffer += skeys[i];
+
+        std::vector<std::size_t> offsets(SK + 1, 0);
+        for (std::size_t i = 0; i < SK; ++i) offsets[i + 1] = offsets[i] + skeys[i].size();
+
+        std::uint64_t x = 777777777ULL;
+        for (std::size_t i = 0; i < Q; ++i) {
+            std::size_t k = lcg_next(x) % SK;
+            squeries[i] = std::string_view(sbuffer.data() + offsets[k], skeys[k].size());
+        }
+    }
+
+    bench_ms("stl::unordered_map<std::string,int> find by string_view (std::string temporary)", [&]{
+        static string_umap m;
+        if (m.empty()) for (std::size_t i = 0; i < SK; ++i) m.insert({skeys[i], (int)i});
+
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Q; ++i) {
+            auto it = m.find(std::string(squeries[i]));
+            if (it != m.end()) acc += (std::uint64_t)it->second;
+        }
+        sink += acc;
+    });
+
+    bench_ms("stl::unordered_map<std::string,int> find by string_view (transparent)", [&]{
+        static transparent_string_umap m;
+        if (m.empty()) for (std::size_t i = 0; i < SK; ++i) m.insert({skeys[i], (int)i});
+
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < Q; ++i) {
+            auto it = m.find(squeries[i]);
+            if (it != m.end()) acc += (std::uint64_t)it->second;
+        }
+        sink += acc;
+    });
+
+    std::cout << "\n";
+
+    // Node allocation: build + destroy, then erase/re-insert churn that recycles nodes through the pool's free lists.
+    bench_ms("stl::unordered_map<int,Big> insert + destroy", [&]{
+        stl::unordered_map<int, Big> m;
+        std::uint64_t x = 123456789ULL;
+        for (std::size_t i = 0; i < N; ++i) {
+            int k = (int)(lcg_next(x) & 0x7fffffff);
+            m.insert({k, Big(k)});
+        }
+        touch_map(m);
+    });
+
+    bench_ms("stl::unordered_map<int,Big> (pool allocator) insert + destroy", [&]{
+        pooled_umap m;
+        std::uint64_t x = 123456789ULL;
+        for (std::size_t i = 0; i < N; ++i) {
+            int k = (int)(lcg_next(x) & 0x7fffffff);
+            m.insert({k, Big(k)});
+        }
+        touch_map(m);
+    });
+
+    bench_ms("stl::unordered_map<int,Big> erase/insert churn", [&]{
+        stl::unordered_map<int, Big> m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 555555555ULL;
+        for (std::size_t i = 0; i < E; ++i) {
+            int k = (int)(lcg_next(x) % N);
+            if (m.erase(k) != 0) m.insert({k, Big(k)});
+        }
+        touch_map(m);
+    });
+
+    bench_ms("stl::unordered_map<int,Big> (pool allocator) erase/insert churn", [&]{
+        pooled_umap m;
+        m.reserve(N);
+        for (int i = 0; i < (int)N; ++i) m.insert({i, Big(i)});
+
+        std::uint64_t x = 555555555ULL;
+        for (std::size_t i = 0; i < E; ++i) {
+            int k = (int)(lcg_next(x) % N);
+            if (m.erase(k) != 0) m.insert({k, Big(k)});
+        }
+        touch_map(m);
+    });
+
+    std::cout << "\n";
+
+    // Small table that stays in cache with random keys: the lookup cost is dominated by the bucket index computation,
+    // i.e. the hash mix + mask of the power-of-two policy vs the integer division of the prime policy.
+    const std::size_t S = 4096;
+    const std::size_t QS = 20 * Q;
+
+    bench_ms("stl::unordered_map<int,Big> (power2 policy) find HIT cache-resident", [&]{
+        stl::unordered_map<int, Big> m;
+        std::vector<int> keys(S);
+        std::uint64_t x = 444444444ULL;
+        for (std::size_t i = 0; i < S; ++i) { keys[i] = (int)(lcg_next(x) & 0x7fffffff); m.insert({keys[i], Big(keys[i])}); }
+
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < QS; ++i)
+        {
+            auto it = m.find(keys[lcg_next(x) % S]);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+        sink += acc;
+    });
+
+    bench_ms("stl::unordered_map<int,Big> (prime policy) find HIT cache-resident", [&]{
+        prime_umap m;
+        std::vector<int> keys(S);
+        std::uint64_t x = 444444444ULL;
+        for (std::size_t i = 0; i < S; ++i) { keys[i] = (int)(lcg_next(x) & 0x7fffffff); m.insert({keys[i], Big(keys[i])}); }
+
+        std::uint64_t acc = 0;
+        for (std::size_t i = 0; i < QS; ++i)
+        {
+            auto it = m.find(keys[lcg_next(x) % S]);
+            if (it != m.end()) acc += (std::uint64_t)it->second.a[0];
+        }
+        sink += acc;
+    });
+
+    std::cout << "\n";
+
+    // Many short-lived maps of a few entries, as built per request: construct, fill, look every key up plus as many
+    // misses, destroy. The small map keeps up to 8 entries inline and allocates nothing below that.
+    const std::size_t T = N;
+
+    for (int entries : {4, 8, 12})
+    {
+        std::string suffix = " x" + std::to_string(T) + " maps of " + std::to_string(entries) + " <int,int>";
+
+        bench_ms(("std::unordered_map" + suffix).c_str(), [&]{ tiny_maps<std::unordered_map<int, int>>(T, entries); });
+        bench_ms(("stl::unordered_map" + suffix).c_str(), [&]{ tiny_maps<stl::unordered_map<int, int>>(T, entries); });
+        bench_ms(("stl::small_unordered_map<8>" + suffix).c_str(), [&]{ tiny_maps<stl::small_unordered_map<int, int, 8>>(T, entries); });
+    }
+
+    std::cout << "\n";
+
+    // Building a map from a ready array of entries: one insert per entry (no reserve, then with one) against the bulk
+    // insert(first, last), which grows the table once, hashes all keys up front and links the nodes slice by slice.
+    using u64 = std::uint64_t;
+    using u64_entry = stl::pair_node<u64, u64>;
+    using pooled_u64_umap = stl::unordered_map<u64, u64, stl::hash<u64>, stl::equal_to<u64>, stl::pool_allocator<u64_entry>>;
+
+    for (std::size_t count : {N, 10 * N})
+    {
+        std::vector<u64_entry> entries;
+        std::uint64_t x = 987654321ULL;
+
+        entries.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            entries.push_back(u64_entry(lcg_next(x), i));
+
+        const u64_entry* first = entries.data();
+        const u64_entry* last = entries.data() + entries.size();
+        std::string suffix = " build of " + std::to_string(count) + " <u64,u64>";
+
+        bench_ms(("stl::unordered_map insert per entry" + suffix).c_str(), [&]{
+            stl::unordered_map<u64, u64> m;
+            for (const u64_entry* it = first; it != last; ++it) m.insert(*it);
+            sink += m.size();
+        }, 0, 3);
+
+        bench_ms(("stl::unordered_map reserve + insert per entry" + suffix).c_str(), [&]{
+            stl::unordered_map<u64, u64> m;
+            m.reserve(count);
+            for (const u64_entry* it = first; it != last; ++it) m.insert(*it);
+            sink += m.size();
+        }, 0, 3);
+
+        bench_ms(("stl::unordered_map insert(first, last)" + suffix).c_str(), [&]{
+            stl::unordered_map<u64, u64> m;
+            m.insert(first, last);
+            sink += m.size();
+        }, 0, 3);
+
+        bench_ms(("stl::unordered_map (pool allocator) insert per entry" + suffix).c_str(), [&]{
+            pooled_u64_umap m;
+            for (const u64_entry* it = first; it != last; ++it) m.insert(*it);
+            sink += m.size();
+        }, 0, 3);
+
+        bench_ms(("stl::unordered_map (pool allocator) insert(first, last)" + suffix).c_str(), [&]{
+            pooled_u64_umap m;
+            m.insert(first, last);
+            sink += m.size();
+        }, 0, 3);
+    }
+
+    std::cout << "\n";
+
+    // Moving every entry of one map to another and back, as when rebalancing shards: copying each entry into the
+    // other map and erasing it (one allocation, one copy and one free per entry) against handing the nodes over,
+    // one at a time through extract and insert(node_type&&) or all together with merge.
+    {
+        stl::unordered_map<int, Big> from, to;
+        std::vector<int> moved;
+        std::uint64_t x = 24681357ULL;
+
+        from.reserve(N);
+        to.reserve(N);
+
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            int k = (int)(lcg_next(x) & 0x7fffffff);
+
+            if (from.try_emplace(k, k).second)
+                moved.push_back(k);
+        }
+
+        std::string suffix = " of " + std::to_string(moved.size()) + " <int,Big> there and back";
+
+        auto copy_all = [&](stl::unordered_map<int, Big>& src, stl::unordered_map<int, Big>& dst) {
+            for (int k : moved)
+            {
+                dst.try_emplace(k, src.find(k)->second);
+                src.erase(k);
+            }
+        };
+
+        auto extract_all = [&](stl::unordered_map<int, Big>& src, stl::unordered_map<int, Big>& dst) {
+            for (int k : moved)
+                dst.insert(src.extract(k));
+        };
+
+        bench_ms(("stl::unordered_map copy + erase" + suffix).c_str(), [&]{ copy_all(from, to); copy_all(to, from); sink += from.size(); }, 1, 3);
+        bench_ms(("stl::unordered_map extract + insert(node)" + suffix).c_str(), [&]{ extract_all(from, to); extract_all(to, from); sink += from.size(); }, 1, 3);
+        bench_ms(("stl::unordered_map merge" + suffix).c_str(), [&]{ to.merge(from); from.merge(to); sink += from.size(); }, 1, 3);
+    }
+
+    std::cout << "\n";
+
+    bench_insert_latency<std::unordered_map<int, Big>>("std::unordered_map<int,Big> insert latency (no reserve)", N);
+    bench_insert_latency<stl::unordered_map<int, Big>>("stl::unordered_map<int,Big> insert latency (no reserve)", N);
+    bench_insert_latency<incremental_umap>("stl::unordered_map<int,Big> (incremental policy) insert latency (no reserve)", N);
+
+    std::cout << "\n";
+
+    stats_run<stats_umap<stl::power2_rehash_policy>>("stl::unordered_map<int,Big> (power2 policy) stats", N, Q);
+    stats_run<stats_umap<stl::prime_rehash_policy>>("stl::unordered_map<int,Big> (prime policy) stats", N, Q);
+    stats_run<stats_umap<stl::incremental_rehash_policy<>>>("stl::unordered_map<int,Big> (incremental policy) stats", N, Q);
+
     std::cout << "\nDone. sink=" << sink << "\n";
 
     fout.close();
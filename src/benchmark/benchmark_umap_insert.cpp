@@ -0,0 +1,140 @@
+#include "../STL/containers/unordered_map/unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+// Every heap allocation of the process goes through here and is counted.
+static std::uint64_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (void* ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+// A 200-byte mapped value that counts how it is constructed.
+struct Value
+{
+    static std::uint64_t constructions, copies, moves;
+
+    unsigned char payload[200];
+
+    Value() { payload[0] = 0; ++constructions; }
+
+    explicit Value(int x) { payload[0] = (unsigned char)x; ++constructions; }
+
+    Value(const Value& other) { std::copy(other.payload, other.payload + sizeof(payload), payload); ++copies; }
+
+    Value(Value&& other) noexcept { std::copy(other.payload, other.payload + sizeof(payload), payload); ++moves; }
+
+    Value& operator=(const Value& other) { std::copy(other.payload, other.payload + sizeof(payload), payload); ++copies; return *this; }
+
+    Value& operator=(Value&& other) noexcept { std::copy(other.payload, other.payload + sizeof(payload), payload); ++moves; return *this; }
+};
+
+std::uint64_t Value::constructions = 0;
+std::uint64_t Value::copies = 0;
+std::uint64_t Value::moves = 0;
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static void print_line(const std::string& line)
+{
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+// Runs op(map, key) once per key, on an empty map or on one already holding every key (present), and reports the
+// time and what each operation cost in Value constructions, copies, moves and heap allocations.
+template <class Map, class Op>
+static void run(const char* name, const std::vector<int>& keys, bool present, Op op)
+{
+    Map m;
+    m.reserve(2 * keys.size());
+
+    if (present)
+        for (int key : keys)
+            m.try_emplace(key, key);
+
+    Value::constructions = Value::copies = Value::moves = 0;
+    std::uint64_t allocs = allocations;
+
+    auto t0 = clock_type::now();
+
+    for (int key : keys)
+        op(m, key);
+
+    double ms = std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+    double n = (double)keys.size();
+
+    print_line(std::string(name) + (present ? " (key present)" : " (new key)")
+               + ": " + std::to_string(ms) + " ms"
+               + "  per op: constructions=" + std::to_string(Value::constructions / n)
+               + " copies=" + std::to_string(Value::copies / n)
+               + " moves=" + std::to_string(Value::moves / n)
+               + " allocations=" + std::to_string((allocations - allocs) / n));
+
+    sink += m.size();
+}
+
+template <class Map>
+static void run_all(const char* label, const std::vector<int>& keys)
+{
+    using entry = typename Map::value_type;
+
+    print_line(std::string("--- ") + label);
+
+    const Value shared(1);
+    entry reused(0, shared);
+
+    for (bool present : {false, true})
+    {
+        run<Map>("insert(const value_type&)", keys, present, [&](Map& m, int key) { reused.m_pair.first = key; m.insert(reused); });
+        run<Map>("emplace(key, const Value&)", keys, present, [&](Map& m, int key) { m.emplace(key, shared); });
+        run<Map>("try_emplace(key, int)", keys, present, [&](Map& m, int key) { m.try_emplace(key, key); });
+        run<Map>("operator[]", keys, present, [&](Map& m, int key) { sink += m[key].payload[0]; });
+    }
+}
+
+int main()
+{
+    const std::size_t n = 1000000;
+    std::vector<int> keys;
+    std::uint64_t x = 12345;
+
+    keys.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        keys.push_back((int)(lcg_next(x) >> 33));
+
+    run_all<stl::unordered_map<int, Value>>("stl::unordered_map<int, Value>", keys);
+
+    std::cout << "\nDone. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
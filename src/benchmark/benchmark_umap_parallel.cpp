@@ -0,0 +1,136 @@
+#include "../STL/containers/unordered_map/unordered_map.h"
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <string>
+
+// Build with STL/functional_hash/hash_bytes.cpp and -pthread.
+
+using clock_type = std::chrono::steady_clock;
+static volatile std::uint64_t sink = 0;
+
+std::ofstream fout("data.out");
+
+using u64 = std::uint64_t;
+using u64_map = stl::unordered_map<u64, u64>;
+using u64_entry = u64_map::value_type;
+
+static inline std::uint64_t lcg_next(std::uint64_t& x)
+{
+    x = x * 2862933555777941757ULL + 3037000493ULL;
+    return x;
+}
+
+static double ms_since(clock_type::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(clock_type::now() - t0).count();
+}
+
+static void print_line(const std::string& line)
+{
+    std::cout << line << "\n";
+    fout << line << "\n";
+}
+
+// Best of @c rounds runs of @c f, which gets a fresh map to work on and returns the milliseconds it took.
+template <class F>
+static double best_ms(int rounds, F f)
+{
+    double best = 0;
+
+    for (int r = 0; r < rounds; ++r)
+    {
+        double ms = f();
+        if (r == 0 || ms < best) best = ms;
+    }
+
+    return best;
+}
+
+int main()
+{
+    const int ROUNDS = 3;
+
+    std::cout << "hardware threads=" << std::thread::hardware_concurrency() << "\n\n";
+
+    for (std::size_t count : {std::size_t(4000000), std::size_t(16000000)})
+    {
+        std::vector<u64_entry> entries;
+        std::uint64_t x = 987654321ULL;
+
+        entries.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            entries.push_back(u64_entry(lcg_next(x), i));
+
+        const u64_entry* first = entries.data();
+        const u64_entry* last = entries.data() + entries.size();
+        std::string suffix = " (" + std::to_string(count) + " <u64,u64>)";
+
+        // rehash: a full map moved to four times its buckets, the resize an insert past the load factor would do twice
+        u64_map loaded(first, last);
+        const std::size_t grown = loaded.bucket_count() * 4;
+
+        double seq_rehash = best_ms(ROUNDS, [&]{
+            u64_map m(loaded);
+            auto t0 = clock_type::now();
+            m.rehash(grown);
+            double ms = ms_since(t0);
+            sink += m.bucket_count();
+            return ms;
+        });
+
+        print_line("rehash sequential" + suffix + ": " + std::to_string(seq_rehash) + " ms");
+
+        for (std::size_t threads : {1, 2, 4, 8})
+        {
+            double ms = best_ms(ROUNDS, [&]{
+                u64_map m(loaded);
+                auto t0 = clock_type::now();
+                m.rehash(stl::parallel_t(threads), grown);
+                double ms = ms_since(t0);
+                sink += m.bucket_count();
+                return ms;
+            });
+
+            print_line("rehash parallel threads=" + std::to_string(threads) + suffix + ": " + std::to_string(ms) +
+                       " ms, speedup " + std::to_string(seq_rehash / ms) + "x");
+        }
+
+        // range construction from entries already in memory
+        double seq_build = best_ms(ROUNDS, [&]{
+            auto t0 = clock_type::now();
+            u64_map m(first, last);
+            double ms = ms_since(t0);
+            sink += m.size();
+            return ms;
+        });
+
+        print_line("build sequential" + suffix + ": " + std::to_string(seq_build) + " ms");
+
+        for (std::size_t threads : {1, 2, 4, 8})
+        {
+            double ms = best_ms(ROUNDS, [&]{
+                auto t0 = clock_type::now();
+                u64_map m(stl::parallel_t(threads), first, last);
+                double ms = ms_since(t0);
+                sink += m.size();
+                return ms;
+            });
+
+            print_line("build parallel threads=" + std::to_string(threads) + suffix + ": " + std::to_string(ms) +
+                       " ms, speedup " + std::to_string(seq_build / ms) + "x");
+        }
+
+        std::cout << "\n";
+    }
+
+    std::cout << "Done. sink=" << sink << "\n";
+
+    fout.close();
+
+    return 0;
+}
@@ -1,14 +1,72 @@
 #pragma once
 
 #include "stl_pair.h"
+#include "../STL/traits/type_traits.h"
 
 namespace stl
 {
+    /**
+     * @brief Decides whether the nodes of a hash table store the full hash code of their key next to it.
+     *        A cached hash code makes rehash and erase recompute-free and lets lookups reject a node on a hash mismatch
+     *        before calling @c KeyEqual. It is on by default for non-scalar keys (e.g. strings), where hashing and comparing
+     *        are expensive, and off for scalars, whose hash is cheaper than the extra word per node.
+     *        Specialize it for a key type to force either behaviour.
+     * @tparam Key key type
+     */
+    template <typename Key>
+    struct cache_hash_code : public bool_constant<!is_scalar<Key>::value> { };
+
     namespace __detail
     {
-        template <typename Key, typename T> 
-        struct __hash_node
+        /// @brief Read prefetch hint into all cache levels; a no-op on compilers without @c __builtin_prefetch.
+        inline void __prefetch(const void* ptr) noexcept
+        {
+        #if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(ptr, 0, 3);
+        #else
+            (void)ptr;
+        #endif
+        }
+
+        template <typename T, typename = void>
+        struct __is_transparent : public false_type { };
+
+        template <typename T>
+        struct __is_transparent<T, typename __void_t<typename T::is_transparent>::type> : public true_type { };
+
+        /**
+         * @brief Heterogeneous lookup is enabled when both the hasher and the key comparison declare @c is_transparent;
+         *        @c K only makes the check depend on the member template's own parameter, so that it stays SFINAE.
+         */
+        template <typename Hash, typename KeyEqual, typename K>
+        struct __transparent_lookup 
+            : public bool_constant<__is_transparent<Hash>::value && __is_transparent<KeyEqual>::value> { };
+
+        template <bool Cache>
+        struct __hash_code_storage
+        {
+            size_t m_hash_code;
+
+            __hash_code_storage() noexcept
+                : m_hash_code(0) { }
+
+            size_t hash_code() const noexcept { return this->m_hash_code; }
+
+            void set_hash_code(size_t code) noexcept { this->m_hash_code = code; }
+        };
+
+        /// @brief Empty base (no storage) when the hash code is not cached.
+        template <>
+        struct __hash_code_storage<false>
+        {
+            void set_hash_code(size_t) noexcept { }
+        };
+
+        template <typename Key, typename T, bool Cache = stl::cache_hash_code<Key>::value> 
+        struct __hash_node : public __hash_code_storage<Cache>
         {
+            static constexpr bool hash_code_cached = Cache;
+
             pair<Key, T>  m_pair;
             __hash_node*  m_next;
 
@@ -18,8 +76,13 @@ namespace stl
             __hash_node(const Key& key, const T& value)
                 : m_pair(key, value), m_next(nullptr) { }
 
+            /// @brief Entry built in place: the key from @c key, the mapped value from @c args.
+            template <typename K, typename... Args>
+            __hash_node(__emplace_second_t tag, K&& key, Args&&... args)
+                : m_pair(tag, stl::forward<K>(key), stl::forward<Args>(args)...), m_next(nullptr) { }
+
             __hash_node(const __hash_node& other)
-                : m_pair(other.m_pair), m_next(other.m_next) { }
+                : __hash_code_storage<Cache>(other), m_pair(other.m_pair), m_next(other.m_next) { }
             
             ~__hash_node() = default;
         };
@@ -108,6 +171,12 @@ namespace stl
             bool operator!=(const __const_node_iterator& other) const { return this->m_current != other.m_current; }
         };
 
+        /**
+         * @brief Walks a bucket array chain by chain. Besides the node it also remembers that node's predecessor within
+         *        its bucket (@c nullptr for the chain head), so the container can unlink the node it points to without
+         *        rescanning the bucket. A second array may follow the first: the walk goes on with it once the first
+         *        one ends, which is how the old and new tables of an incremental rehash are read in one pass.
+         */
         template <typename Key, typename T>
         struct __map_iterator
         {
@@ -116,17 +185,22 @@ namespace stl
             typedef value_type*                      pointer;
             typedef value_type&                      reference;
             typedef stl::ptrdiff_t                   difference_type;
-            typedef stl::bidirectional_iterator_tag  iterator_category;
+            typedef stl::forward_iterator_tag        iterator_category;
 
             node_type**  m_bucket_begin;
             node_type**  m_bucket_end;
             node_type*   m_current;
+            node_type*   m_prev;
+            node_type**  m_next_begin;      // bucket array walked after this one, nullptr if none
+            node_type**  m_next_end;
 
             __map_iterator() noexcept
-                : m_bucket_begin(nullptr), m_bucket_end(nullptr), m_current(nullptr) { }
+                : m_bucket_begin(nullptr), m_bucket_end(nullptr), m_current(nullptr), m_prev(nullptr), m_next_begin(nullptr), m_next_end(nullptr) { }
 
-            __map_iterator(node_type** __bucket_begin, node_type** __bucket_end, node_type* __node_it) 
-                : m_bucket_begin(__bucket_begin), m_bucket_end(__bucket_end), m_current(__node_it) { }
+            __map_iterator(node_type** __bucket_begin, node_type** __bucket_end, node_type* __node_it, node_type* __prev = nullptr,
+                  node_type** __next_begin = nullptr, node_type** __next_end = nullptr)
+                : m_bucket_begin(__bucket_begin), m_bucket_end(__bucket_end), m_current(__node_it), m_prev(__prev),
+                  m_next_begin(__next_begin), m_next_end(__next_end) { }
 
             reference operator*() const { return this->m_current->m_pair; }
 
@@ -134,18 +208,9 @@ namespace stl
 
             __map_iterator& operator++()
             {
-                if (this->m_current != nullptr)
-                    this->m_current = this->m_current->m_next;
-                else
-                {
-                    while (this->m_current == nullptr && this->m_bucket_begin != this->m_bucket_end)
-                    {
-                        ++this->m_bucket_begin;
-
-                        if (this->m_bucket_begin != this->m_bucket_end)
-                            this->m_current = *this->m_bucket_begin;
-                    }
-                }
+                this->m_prev = this->m_current;
+                this->m_current = this->m_current->m_next;
+                this->m_skip_empty_buckets();
 
                 return *this;
             }
@@ -157,13 +222,32 @@ namespace stl
                 return temp;
             }
 
-            bool operator==(const __map_iterator& other) const
-            { return this->m_bucket_begin == other.m_bucket_begin && this->m_bucket_end == other.m_bucket_end && this->m_current == other.m_current; }
+            bool operator==(const __map_iterator& other) const { return this->m_current == other.m_current; }
+
+            bool operator!=(const __map_iterator& other) const { return this->m_current != other.m_current; }
+
+            /// @brief Moves past exhausted chains to the head of the next non-empty bucket, in this array or the next one, or to the end.
+            void m_skip_empty_buckets()
+            {
+                while (this->m_current == nullptr && this->m_bucket_begin != this->m_bucket_end)
+                {
+                    ++this->m_bucket_begin;
+                    this->m_prev = nullptr;
+
+                    if (this->m_bucket_begin == this->m_bucket_end && this->m_next_begin != nullptr)
+                    {
+                        this->m_bucket_begin = this->m_next_begin;
+                        this->m_bucket_end = this->m_next_end;
+                        this->m_next_begin = this->m_next_end = nullptr;
+                    }
 
-            bool operator!=(const __map_iterator& other)
-            { return !(*this == other); }
+                    if (this->m_bucket_begin != this->m_bucket_end)
+                        this->m_current = *this->m_bucket_begin;
+                }
+            }
         };
 
+        /// @brief Constant counterpart of @c __map_iterator, which converts to it.
         template <typename Key, typename T>
         struct __const_map_iterator
         {
@@ -172,52 +256,70 @@ namespace stl
             typedef value_type*                      pointer;
             typedef value_type&                      reference;
             typedef stl::ptrdiff_t                   difference_type;
-            typedef stl::bidirectional_iterator_tag  iterator_category;
+            typedef stl::forward_iterator_tag        iterator_category;
 
             node_type**  m_bucket_begin;
             node_type**  m_bucket_end;
             node_type*   m_current;
+            node_type*   m_prev;
+            node_type**  m_next_begin;      // bucket array walked after this one, nullptr if none
+            node_type**  m_next_end;
 
             __const_map_iterator() noexcept
-                : m_bucket_begin(nullptr), m_bucket_end(nullptr), m_current(nullptr) { }
+                : m_bucket_begin(nullptr), m_bucket_end(nullptr), m_current(nullptr), m_prev(nullptr), m_next_begin(nullptr), m_next_end(nullptr) { }
 
-            __const_map_iterator(node_type** __bucket_begin, node_type** __bucket_end, node_type* __node_it)
-                : m_bucket_begin(__bucket_begin), m_bucket_end(__bucket_end), m_current(__node_it) { }
+            __const_map_iterator(node_type** __bucket_begin, node_type** __bucket_end, node_type* __node_it, node_type* __prev = nullptr,
+                  node_type** __next_begin = nullptr, node_type** __next_end = nullptr)
+                : m_bucket_begin(__bucket_begin), m_bucket_end(__bucket_end), m_current(__node_it), m_prev(__prev),
+                  m_next_begin(__next_begin), m_next_end(__next_end) { }
 
-            reference operator*() const { return *this->m_current; }
+            __const_map_iterator(const __map_iterator<Key, T>& other) noexcept
+                : m_bucket_begin(other.m_bucket_begin), m_bucket_end(other.m_bucket_end), m_current(other.m_current), m_prev(other.m_prev),
+                  m_next_begin(other.m_next_begin), m_next_end(other.m_next_end) { }
 
-            pointer operator->() const { return this->m_current; }
+            reference operator*() const { return this->m_current->m_pair; }
+
+            pointer operator->() const { return &this->m_current->m_pair; }
 
             __const_map_iterator& operator++()
             {
-                if (this->m_current != nullptr)
-                    this->m_current = this->m_current->m_next;
-                else
-                {
-                    while (this->m_current == nullptr && this->m_bucket_begin != this->m_bucket_end)
-                    {
-                        ++this->m_bucket_begin;
-
-                        if (this->m_bucket_begin != this->m_bucket_end)
-                            this->m_current = *this->m_bucket_begin;
-                    }
-                }
+                this->m_prev = this->m_current;
+                this->m_current = this->m_current->m_next;
+                this->m_skip_empty_buckets();
 
                 return *this;
             }
 
-            __const_map_iterator& operator++(int)
+            __const_map_iterator operator++(int)
             {
                 __const_map_iterator temp = *this;
                 ++(*this);
                 return temp;
             }
 
-            bool operator==(const __const_map_iterator& other) 
-            { return this->m_bucket_begin == other.m_bucket_begin && this->m_bucket_end == other.m_bucket_end && this->m_current == other.m_current; }
+            bool operator==(const __const_map_iterator& other) const { return this->m_current == other.m_current; }
+
+            bool operator!=(const __const_map_iterator& other) const { return this->m_current != other.m_current; }
+
+            /// @brief Moves past exhausted chains to the head of the next non-empty bucket, in this array or the next one, or to the end.
+            void m_skip_empty_buckets()
+            {
+                while (this->m_current == nullptr && this->m_bucket_begin != this->m_bucket_end)
+                {
+                    ++this->m_bucket_begin;
+                    this->m_prev = nullptr;
+
+                    if (this->m_bucket_begin == this->m_bucket_end && this->m_next_begin != nullptr)
+                    {
+                        this->m_bucket_begin = this->m_next_begin;
+                        this->m_bucket_end = this->m_next_end;
+                        this->m_next_begin = this->m_next_end = nullptr;
+                    }
 
-            bool operator!=(const __const_map_iterator& other)
-            { return !(*this == other); }
+                    if (this->m_bucket_begin != this->m_bucket_end)
+                        this->m_current = *this->m_bucket_begin;
+                }
+            }
         };
     }
 
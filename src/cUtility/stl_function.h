@@ -1,28 +1,41 @@
 #pragma once
 
+#include "move.h"
+
 namespace stl
 {
-    template <typename T>
+    template <typename T = void>
     struct equal_to
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs == rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs == rhs; } };
+
+    /// @brief Transparent @c equal_to: compares any two operands with @c ==, letting hash tables look keys up without converting them.
+    template <>
+    struct equal_to<void>
+    {
+        typedef void is_transparent;
+
+        template <typename T, typename U>
+        constexpr auto operator()(T&& lhs, U&& rhs) const -> decltype(stl::forward<T>(lhs) == stl::forward<U>(rhs))
+        { return stl::forward<T>(lhs) == stl::forward<U>(rhs); }
+    };
 
     template <typename T>
     struct not_equal_to
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs != rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs != rhs; } };
 
     template <typename T>
     struct greater
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs > rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs > rhs; } };
 
     template <typename T>
     struct less
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs < rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs < rhs; } };
 
     template <typename T>
     struct greater_equal
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs >= rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs >= rhs; } };
 
     template <typename T>
     struct less_equal
-    { constexpr bool operator()(const T& lhs, const T& rhs) { return lhs <= rhs; } };
+    { constexpr bool operator()(const T& lhs, const T& rhs) const { return lhs <= rhs; } };
 }
\ No newline at end of file
@@ -1,9 +1,16 @@
 #pragma once
 
+#include "move.h"
 #include "../STL/algorithm/algorithm.h"
 
 namespace stl
 {
+    namespace __detail
+    {
+        /// @brief Selects the @c pair constructor building @c first from one argument and @c second from all the others.
+        struct __emplace_second_t { };
+    }
+
     template <typename T1, typename T2>
     struct pair
     {
@@ -19,14 +26,24 @@ namespace stl
         constexpr pair(const first_type& x, const second_type& y)
             : first(x), second(y) { }
 
-        constexpr pair(const pair& other)
-            : first(other.first), second(other.second) { }
+        /// @brief Members built straight from the arguments, so rvalues are moved in rather than copied.
+        template <typename U1, typename U2>
+        constexpr pair(U1&& x, U2&& y)
+            : first(stl::forward<U1>(x)), second(stl::forward<U2>(y)) { }
 
-        constexpr pair& operator=(const pair& other)
-        {
-            this->first = other.first;
-            this->second = other.second;
-        }
+        /// @brief @c first from @c x and @c second from @c args, each constructed once, in place.
+        template <typename U1, typename... Args>
+        constexpr pair(__detail::__emplace_second_t, U1&& x, Args&&... args)
+            : first(stl::forward<U1>(x)), second(stl::forward<Args>(args)...) { }
+
+        // defaulted, so a pair of trivially copyable members is trivially copyable itself (and bytewise hashable)
+        constexpr pair(const pair& other) = default;
+
+        constexpr pair(pair&& other) = default;
+
+        pair& operator=(const pair& other) = default;
+
+        pair& operator=(pair&& other) = default;
 
         void swap(pair& p)
         {
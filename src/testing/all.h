@@ -4,4 +4,13 @@
 #include "traits_test.h"
 
 #include "array_test.h"
-#include "vector_test.h"
\ No newline at end of file
+#include "vector_test.h"
+#include "unordered_map_test.h"
+#include "seeded_hash_test.h"
+#include "mapped_unordered_map_test.h"
+#include "concurrent_unordered_map_test.h"
+#include "rcu_unordered_map_test.h"
+#include "frozen_unordered_map_test.h"
+#include "dense_unordered_map_test.h"
+#include "flat_hash_map_test.h"
+#include "static_map_test.h"
\ No newline at end of file
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/concurrent_unordered_map/concurrent_unordered_map.h"
+#include "UTconfig.h"
+
+#include <atomic>
+#include <thread>
+
+/**
+ * Sharded map: single-threaded round-trips and misses, then writers and readers running at once, over the default
+ * allocator and over @c pool_allocator. Build with -pthread, and with -fsanitize=thread to check the locking.
+ */
+class concurrent_unordered_map_test
+{
+    typedef stl::concurrent_unordered_map<int, long>  map_type;
+    typedef stl::concurrent_unordered_map<int, long, stl::hash<int>, stl::equal_to<int>,
+                                          stl::pool_allocator<stl::pair_node<int, long>>>  pool_map_type;
+
+    constexpr static int __THREADS = 4;
+    constexpr static int __KEYS    = 4000;     // per writer
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief @c __THREADS writers insert, overwrite and erase disjoint key ranges while as many readers look them up.
+    template <typename Map>
+    static bool run_readers_and_writers(Map& map)
+    {
+        std::atomic<int> writers_done(0);
+        std::atomic<bool> consistent(true);
+
+        stl::vector<std::thread> threads;
+        threads.reserve(2 * __THREADS);
+
+        for (int t = 0; t < __THREADS; ++t)
+        {
+            threads.emplace_back([&map, &writers_done, t]()
+            {
+                const int base = t * __KEYS;
+
+                for (int k = base; k < base + __KEYS; ++k)
+                    map.insert(k, static_cast<long>(k) * 2);
+
+                for (int k = base; k < base + __KEYS; k += 2)
+                    map.insert_or_assign(k, static_cast<long>(k) * 2 + 1);
+
+                for (int k = base + 1; k < base + __KEYS; k += 4)
+                    map.erase(k);
+
+                ++writers_done;
+            });
+
+            // a value seen is always one some writer stored for that key
+            threads.emplace_back([&map, &writers_done, &consistent]()
+            {
+                while (writers_done.load() < __THREADS)
+                {
+                    for (int k = 0; k < __THREADS * __KEYS; k += 7)
+                    {
+                        std::optional<long> value = map.find(k);
+
+                        if (value && *value != static_cast<long>(k) * 2 && *value != static_cast<long>(k) * 2 + 1)
+                            consistent = false;
+                    }
+                }
+            });
+        }
+
+        for (stl::size_t i = 0; i < threads.size(); ++i)
+            threads.data()[i].join();
+
+        return consistent.load();
+    }
+
+    /// @brief The state every writer of @c run_readers_and_writers leaves behind.
+    template <typename Map>
+    static bool check_final(const Map& map)
+    {
+        stl::size_t expected = 0;
+
+        for (int k = 0; k < __THREADS * __KEYS; ++k)
+        {
+            std::optional<long> value = map.find(k);
+            const int offset = k % __KEYS;
+
+            if (offset % 4 == 1)
+            {
+                if (value)
+                    return false;
+
+                continue;
+            }
+
+            ++expected;
+
+            if (!value || *value != static_cast<long>(k) * 2 + (offset % 2 == 0 ? 1 : 0))
+                return false;
+        }
+
+        return map.size() == expected;
+    }
+
+    // round-trip, overwrite, visit and erase on one thread; missing keys are absent everywhere
+    bool test_0()
+    {
+        map_type map(8);
+
+        for (int k = 0; k < 1000; ++k)
+            __check_result_no_return__(map.insert(k, k * 10), true);
+
+        __check_result_no_return__(map.insert(5, 0), false);
+        __check_result_no_return__(map.insert_or_assign(5, 51), false);
+        __check_result_no_return__(*map.find(5), 51);
+
+        __check_result_no_return__(map.visit(6, [](long& value) { value += 1; }), true);
+        __check_result_no_return__(*map.find(6), 61);
+
+        for (int k = 1000; k < 2000; ++k)
+        {
+            __check_result_no_return__(map.find(k).has_value(), false);
+            __check_result_no_return__(map.contains(k), false);
+            __check_result_no_return__(map.cvisit(k, [](const long&) { }), false);
+        }
+
+        __check_result_no_return__(map.erase(7), static_cast<stl::size_t>(1));
+        __check_result_no_return__(map.erase(7), static_cast<stl::size_t>(0));
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(999));
+
+        map.rehash(4096);
+        for (int k = 0; k < 1000; ++k)
+            __check_result_no_return__(map.contains(k), (k != 7));
+
+        map.clear();
+        __check_result_no_return__(map.empty(), true);
+
+        return true;
+    }
+
+    // pool_allocator shards: each gets a pool of its own, so the map works the same as with the default allocator
+    bool test_1()
+    {
+        pool_map_type map(8);
+
+        for (int k = 0; k < 5000; ++k)
+            map.insert(k, k);
+
+        for (int k = 0; k < 5000; k += 2)
+            map.erase(k);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(2500));
+
+        for (int k = 0; k < 5000; ++k)
+            __check_result_no_return__(map.contains(k), (k % 2 == 1));
+
+        return true;
+    }
+
+    // concurrent readers and writers over the default allocator
+    bool test_2()
+    {
+        map_type map(16);
+
+        __check_result_no_return__(run_readers_and_writers(map), true);
+        __check_result_no_return__(check_final(map), true);
+
+        return true;
+    }
+
+    // the same over pool_allocator, whose pools are not synchronised: only correct with one pool per shard
+    bool test_3()
+    {
+        pool_map_type map(16);
+
+        __check_result_no_return__(run_readers_and_writers(map), true);
+        __check_result_no_return__(check_final(map), true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/dense_unordered_map/dense_unordered_map.h"
+#include "UTconfig.h"
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * Contiguous-entry map: round-trips and misses, then erasing, which moves the last entry into the hole, checked
+ * against the chains that must follow the moved entry, under both rehash policies; values are built in place and
+ * never copied by an erase.
+ */
+template <typename RehashPolicy>
+class dense_unordered_map_test
+{
+    typedef stl::dense_unordered_map<int, std::string, stl::hash<int>, stl::equal_to<int>, RehashPolicy>  map_type;
+    typedef typename map_type::iterator                                                                      iterator;
+
+    /// @brief Counts its copies and moves, assignments included.
+    struct tracked
+    {
+        static inline int copies = 0;
+        static inline int moves = 0;
+
+        int value;
+
+        tracked(int v) : value(v) { }
+
+        tracked(const tracked& other) : value(other.value) { ++copies; }
+
+        tracked(tracked&& other) noexcept : value(other.value) { ++moves; }
+
+        tracked& operator=(const tracked& other) { value = other.value; ++copies; return *this; }
+
+        tracked& operator=(tracked&& other) noexcept { value = other.value; ++moves; return *this; }
+    };
+
+    typedef stl::dense_unordered_map<int, tracked, stl::hash<int>, stl::equal_to<int>, RehashPolicy>      tracked_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+        TEST_CASE(test_4());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    static std::string value_of(int key) { return "v" + std::to_string(key); }
+
+    /// @brief Every key in [0, @c count) is present with its value exactly when @c present says so, and nothing else is.
+    template <typename Present>
+    static bool holds(const map_type& map, int count, Present present)
+    {
+        stl::size_t expected = 0;
+
+        for (int k = 0; k < count; ++k)
+        {
+            typename map_type::const_iterator it = map.find(k);
+
+            if (!present(k))
+            {
+                if (it != map.end())
+                    return false;
+
+                continue;
+            }
+
+            ++expected;
+
+            if (it == map.end() || it->first != k || it->second != value_of(k))
+                return false;
+        }
+
+        return map.size() == expected && static_cast<stl::size_t>(map.end() - map.begin()) == expected;
+    }
+
+    // round-trip through growth, then misses, operator[] and at()
+    bool test_0()
+    {
+        map_type map;
+
+        for (int k = 0; k < 5000; ++k)
+            __check_result_no_return__(map.try_emplace(k, value_of(k)).second, true);
+
+        __check_result_no_return__(map.try_emplace(7, "other").second, false);
+        __check_result_no_return__(holds(map, 10000, [](int k) { return k < 5000; }), true);
+
+        map[5000] = value_of(5000);
+        __check_result_no_return__(map.at(5000), value_of(5000));
+
+        bool thrown = false;
+        try { map.at(-1); } catch (const std::out_of_range&) { thrown = true; }
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    // erase by key swaps the last entry in: it stays reachable from its chain, and the sweep stays dense
+    bool test_1()
+    {
+        map_type map(8);
+
+        for (int k = 0; k < 3000; ++k)
+            map.try_emplace(k, value_of(k));
+
+        for (int k = 0; k < 3000; k += 3)
+            __check_result_no_return__(map.erase(k), static_cast<stl::size_t>(1));
+
+        __check_result_no_return__(map.erase(0), static_cast<stl::size_t>(0));
+        __check_result_no_return__(holds(map, 3000, [](int k) { return k % 3 != 0; }), true);
+
+        // erasing the last entry moves nothing
+        int last = (map.end() - 1)->first;
+        __check_result_no_return__(map.erase(last), static_cast<stl::size_t>(1));
+        __check_result_no_return__(map.contains(last), false);
+
+        return true;
+    }
+
+    // erase(it) returns the position holding the former last entry, so a filtering sweep visits every entry once
+    bool test_2()
+    {
+        map_type map;
+
+        for (int k = 0; k < 4000; ++k)
+            map.try_emplace(k, value_of(k));
+
+        stl::size_t visited = 0;
+
+        for (iterator it = map.begin(); it != map.end(); )
+        {
+            ++visited;
+
+            if (it->first % 2 == 0)
+                it = map.erase(it);
+            else
+                ++it;
+        }
+
+        __check_result_no_return__(visited, static_cast<stl::size_t>(4000));
+        __check_result_no_return__(holds(map, 4000, [](int k) { return k % 2 != 0; }), true);
+
+        return true;
+    }
+
+    // erase everything, in scan order and back again, then reuse the map; rehash keeps the entries
+    bool test_3()
+    {
+        map_type map;
+
+        for (int k = 0; k < 1000; ++k)
+            map.try_emplace(k, value_of(k));
+
+        while (!map.empty())
+            map.erase(map.begin());
+
+        __check_result_no_return__((map.find(0) == map.end()), true);
+
+        for (int k = 0; k < 1000; ++k)
+            map.try_emplace(k, value_of(k));
+
+        map.rehash(4096);
+        __check_result_no_return__(holds(map, 2000, [](int k) { return k < 1000; }), true);
+
+        while (!map.empty())
+            map.erase(map.end() - 1);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(0));
+        __check_result_no_return__(map.contains(1), false);
+
+        map.try_emplace(1, value_of(1));
+        __check_result_no_return__(holds(map, 10, [](int k) { return k == 1; }), true);
+
+        return true;
+    }
+
+    // with room reserved, try_emplace builds each value in place; erasing moves the last entry into the hole, never copies
+    bool test_4()
+    {
+        tracked_map_type map;
+        map.reserve(100);
+
+        tracked::copies = tracked::moves = 0;
+
+        for (int k = 0; k < 100; ++k)
+            map.try_emplace(k, k);
+
+        __check_result_no_return__(tracked::copies, 0);
+        __check_result_no_return__(tracked::moves, 0);
+
+        for (int k = 0; k < 100; k += 3)
+            map.erase(k);
+
+        __check_result_no_return__(tracked::copies, 0);
+        __check_result_no_return__((tracked::moves > 0), true);
+
+        for (int k = 0; k < 100; ++k)
+        {
+            typename tracked_map_type::const_iterator it = map.find(k);
+
+            __check_result_no_return__((it == map.end()), (k % 3 == 0));
+
+            if (it != map.end())
+                __check_result_no_return__(it->second.value, k);
+        }
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 5;
+};
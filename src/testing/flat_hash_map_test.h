@@ -0,0 +1,275 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/flat_hash_map/flat_hash_map.h"
+#include "UTconfig.h"
+
+#include <new>
+#include <string>
+#include <string_view>
+
+namespace my_alloc
+{
+    /// @brief Throws @c std::bad_alloc once @c budget allocations have been made, across every rebound copy.
+    template <typename T>
+    class throwing_allocator : public stl::allocator<T>
+    {
+    public:
+        static inline int budget = -1;     // allocations left, never throws while negative
+
+        template <typename U>
+        struct rebind { typedef throwing_allocator<U> other; };
+
+        throwing_allocator() noexcept { }
+
+        template <typename U>
+        throwing_allocator(const throwing_allocator<U>&) noexcept { }
+
+        T* allocate(stl::size_t size, const void* = nullptr)
+        {
+            if (throwing_allocator<char>::budget == 0)
+                throw std::bad_alloc();
+
+            if (throwing_allocator<char>::budget > 0)
+                --throwing_allocator<char>::budget;
+
+            return stl::allocator<T>::allocate(size);
+        }
+    };
+
+    template <typename TypeI, typename TypeII>
+    bool operator==(const throwing_allocator<TypeI>&, const throwing_allocator<TypeII>&) { return true; }
+
+    template <typename TypeI, typename TypeII>
+    bool operator!=(const throwing_allocator<TypeI>&, const throwing_allocator<TypeII>&) { return false; }
+}
+
+/**
+ * Open-addressing map: elements built in place in their slot, the move and range overloads, heterogeneous lookup,
+ * and a table left intact when growing it fails to allocate.
+ */
+class flat_hash_map_test
+{
+    /// @brief Counts its copies and moves, so a test can tell an element built in place from one copied in.
+    struct tracked
+    {
+        static inline int copies = 0;
+        static inline int moves  = 0;
+
+        int value;
+
+        tracked() : value(0) { }
+        explicit tracked(int v) : value(v) { }
+        tracked(int a, int b) : value(a * b) { }
+        tracked(const tracked& other) : value(other.value) { ++copies; }
+        tracked(tracked&& other) noexcept : value(other.value) { ++moves; }
+
+        tracked& operator=(const tracked& other) { value = other.value; ++copies; return *this; }
+        tracked& operator=(tracked&& other) noexcept { value = other.value; ++moves; return *this; }
+
+        static void reset() { copies = moves = 0; }
+    };
+
+    typedef stl::flat_hash_map<int, tracked>                                                     map_type;
+    typedef stl::flat_hash_map<std::string, int, stl::hash<std::string>, stl::equal_to<void>>  string_map_type;
+    typedef stl::flat_hash_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                               my_alloc::throwing_allocator<stl::pair<int, int>>>               throwing_map_type;
+    typedef stl::flat_hash_map<int, int>                                                         int_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+        TEST_CASE(test_4());
+        TEST_CASE(test_5());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    // try_emplace and emplace build the element in its slot: no copy, and no move of an argument built for the call
+    bool test_0()
+    {
+        map_type map;
+        map.reserve(100);
+
+        tracked::reset();
+
+        __check_result_no_return__(map.try_emplace(1, 6, 7).second, true);
+        __check_result_no_return__(map.try_emplace(2).second, true);
+        __check_result_no_return__(map.emplace(3, 9).second, true);
+        __check_result_no_return__(tracked::copies, 0);
+        __check_result_no_return__(tracked::moves, 0);
+
+        __check_result_no_return__(map.emplace(4, tracked(5)).second, true);
+        __check_result_no_return__(tracked::copies, 0);
+        __check_result_no_return__(tracked::moves, 1);
+
+        // a present key builds nothing
+        __check_result_no_return__(map.try_emplace(1, 100, 100).second, false);
+        __check_result_no_return__(map.at(1).value, 42);
+        __check_result_no_return__(map.at(2).value, 0);
+        __check_result_no_return__(map.at(3).value, 9);
+        __check_result_no_return__(map.at(4).value, 5);
+        __check_result_no_return__(tracked::copies, 0);
+
+        return true;
+    }
+
+    // the rvalue overloads move the key and the element in
+    bool test_1()
+    {
+        stl::flat_hash_map<std::string, tracked> map;
+        map.reserve(100);
+
+        tracked::reset();
+
+        stl::pair<std::string, tracked> value(std::string(40, 'a'), tracked(1));
+        __check_result_no_return__(map.insert(stl::move(value)).second, true);
+        __check_result_no_return__(tracked::copies, 0);
+
+        std::string key(40, 'b');
+        __check_result_no_return__(map.try_emplace(stl::move(key), 2).second, true);
+
+        std::string other(40, 'c');
+        map[stl::move(other)] = tracked(3);
+
+        __check_result_no_return__(tracked::copies, 0);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(3));
+        __check_result_no_return__(map.at(std::string(40, 'a')).value, 1);
+        __check_result_no_return__(map.at(std::string(40, 'b')).value, 2);
+        __check_result_no_return__(map.at(std::string(40, 'c')).value, 3);
+
+        __check_result_no_return__(map.emplace_hint(map.begin(), std::string("d"), tracked(4))->second.value, 4);
+        __check_result_no_return__(map.try_emplace(map.cbegin(), std::string("d"), 5)->second.value, 4);
+
+        return true;
+    }
+
+    // erase(first, last): a prefix, then the rest; the returned iterator is last
+    bool test_2()
+    {
+        int_map_type map;
+
+        for (int k = 0; k < 1000; ++k)
+            map.try_emplace(k, k);
+
+        int_map_type::const_iterator last = map.cbegin();
+        for (int i = 0; i < 400; ++i)
+            ++last;
+
+        const int boundary = last->first;
+
+        int_map_type::iterator it = map.erase(map.cbegin(), last);
+        __check_result_no_return__((int_map_type::const_iterator(it) == last), true);
+        __check_result_no_return__(it->first, boundary);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(600));
+
+        stl::size_t left = 0;
+        for (int k = 0; k < 1000; ++k)
+            left += map.count(k);
+
+        __check_result_no_return__(left, static_cast<stl::size_t>(600));
+
+        __check_result_no_return__((map.erase(map.cbegin(), map.cend()) == map.end()), true);
+        __check_result_no_return__(map.empty(), true);
+        __check_result_no_return__((map.erase(map.cbegin(), map.cend()) == map.end()), true);
+
+        return true;
+    }
+
+    // a transparent map is searched by string_view and C strings without building a key
+    bool test_3()
+    {
+        string_map_type map;
+
+        for (int k = 0; k < 100; ++k)
+            map.try_emplace("key_" + std::to_string(k), k);
+
+        std::string_view view("key_42");
+        __check_result_no_return__(map.find(view)->second, 42);
+        __check_result_no_return__(map.contains(view), true);
+        __check_result_no_return__(map.contains("key_7"), true);
+        __check_result_no_return__(map.contains("key_100"), false);
+        __check_result_no_return__((map.find(std::string_view("nope")) == map.end()), true);
+
+        const string_map_type& cmap = map;
+        __check_result_no_return__(cmap.find(view)->second, 42);
+
+        // a key of another type is looked up as is and stored as a key_type
+        __check_result_no_return__(map.emplace("key_100", 100).second, true);
+        __check_result_no_return__(map.at("key_100"), 100);
+
+        return true;
+    }
+
+    // growing fails to allocate: the map keeps every element and stays usable
+    bool test_4()
+    {
+        throwing_map_type map;
+
+        for (int k = 0; k < 14; ++k)
+            map.try_emplace(k, k);
+
+        const stl::size_t capacity = map.bucket_count();
+
+        int k = 14;
+        bool thrown = false;
+
+        for (int budget = 0; budget < 2 && !thrown; ++budget)
+        {
+            // first the control bytes fail, then the slots
+            my_alloc::throwing_allocator<char>::budget = budget;
+
+            try
+            {
+                for (; map.bucket_count() == capacity; ++k)
+                    map.try_emplace(k, k);
+            }
+            catch (const std::bad_alloc&)
+            {
+                thrown = budget == 1;
+            }
+
+            my_alloc::throwing_allocator<char>::budget = -1;
+
+            __check_result_no_return__(map.bucket_count(), capacity);
+            __check_result_no_return__(map.size(), static_cast<stl::size_t>(k));
+
+            for (int j = 0; j < k; ++j)
+                __check_result_no_return__(map.at(j), j);
+        }
+
+        __check_result_no_return__(thrown, true);
+
+        for (int j = k; j < 1000; ++j)
+            map.try_emplace(j, j);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(1000));
+
+        return true;
+    }
+
+    // an argument referring into the map is read before growing moves it
+    bool test_5()
+    {
+        stl::flat_hash_map<int, std::string> map;
+
+        map.try_emplace(0, std::string(64, 'x'));
+
+        for (int k = 1; k < 2000; ++k)
+        {
+            map.try_emplace(k, map.at(k - 1));
+            __check_result_no_return__(map.at(k).size(), static_cast<stl::size_t>(64));
+        }
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 6;
+};
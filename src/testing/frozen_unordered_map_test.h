@@ -0,0 +1,148 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/frozen_unordered_map/frozen_unordered_map.h"
+#include "UTconfig.h"
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * Minimal perfect-hash map: every key of the source is found with its value and every other key misses, for
+ * sizes around the bucket and table boundaries; keys the hash cannot separate are rejected.
+ */
+class frozen_unordered_map_test
+{
+    typedef stl::unordered_map<int, int>          source_type;
+    typedef stl::frozen_unordered_map<int, int>   map_type;
+
+    // every key hashes alike
+    struct constant_hash
+    {
+        stl::size_t operator()(int) const noexcept { return 42; }
+    };
+
+    typedef stl::frozen_unordered_map<int, int, constant_hash>  constant_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Freezes keys 0, 3, 6, ... (@c count of them) and checks hits, misses and a full sweep.
+    static bool round_trip(int count)
+    {
+        source_type source;
+
+        for (int i = 0; i < count; ++i)
+            source.try_emplace(3 * i, i);
+
+        map_type map(source);
+
+        if (map.size() != static_cast<stl::size_t>(count))
+            return false;
+
+        for (int k = 0; k < 3 * count + 3; ++k)
+        {
+            map_type::const_iterator it = map.find(k);
+
+            if (k % 3 != 0 || k >= 3 * count)
+            {
+                if (it != map.end() || map.contains(k))
+                    return false;
+
+                continue;
+            }
+
+            if (it == map.end() || it->first != k || it->second != k / 3 || map.at(k) != k / 3)
+                return false;
+        }
+
+        long long sum = 0;
+        stl::size_t visited = 0;
+
+        for (map_type::const_iterator it = map.begin(); it != map.end(); ++it, ++visited)
+            sum += it->second;
+
+        return visited == map.size() && sum == static_cast<long long>(count) * (count - 1) / 2;
+    }
+
+    // round-trip and misses, from a handful of keys to many, across the bucket and table size boundaries
+    bool test_0()
+    {
+        const int counts[] = { 1, 2, 3, 4, 31, 32, 33, 97, 1000, 20000 };
+
+        for (int count : counts)
+            __check_result_no_return__(round_trip(count), true);
+
+        return true;
+    }
+
+    // empty maps miss everything; at() reports a missing key
+    bool test_1()
+    {
+        map_type none;
+        __check_result_no_return__(none.empty(), true);
+        __check_result_no_return__((none.find(0) == none.end()), true);
+
+        source_type source;
+        map_type empty(source);
+        __check_result_no_return__((empty.find(0) == empty.end()), true);
+
+        map_type map({ { 1, 10 }, { 2, 20 } });
+
+        bool thrown = false;
+        try { map.at(3); } catch (const std::out_of_range&) { thrown = true; }
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    // from a range: the first of several equal keys is kept; string keys work the same
+    bool test_2()
+    {
+        stl::vector<stl::pair<int, int>> items;
+
+        for (int i = 0; i < 300; ++i)
+            items.push_back(stl::pair<int, int>(i % 100, i));
+
+        map_type map(items.data(), items.data() + items.size());
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(100));
+
+        for (int k = 0; k < 100; ++k)
+            __check_result_no_return__(map.at(k), k);
+
+        stl::frozen_unordered_map<std::string, int> names({ { "alpha", 1 }, { "beta", 2 }, { "gamma", 3 } });
+        __check_result_no_return__(names.at("beta"), 2);
+        __check_result_no_return__(names.contains("delta"), false);
+
+        return true;
+    }
+
+    // distinct keys with equal full hashes cannot be separated and are rejected; equal keys are only duplicates
+    bool test_3()
+    {
+        stl::vector<stl::pair<int, int>> same = { { 1, 1 }, { 1, 2 } };
+        constant_map_type duplicates(same.data(), same.data() + same.size());
+        __check_result_no_return__(duplicates.at(1), 1);
+
+        stl::vector<stl::pair<int, int>> distinct = { { 1, 1 }, { 2, 2 } };
+
+        bool thrown = false;
+        try { constant_map_type map(distinct.data(), distinct.data() + distinct.size()); } catch (const std::invalid_argument&) { thrown = true; }
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/mapped_unordered_map/mapped_unordered_map.h"
+#include "UTconfig.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Map images: written from an @c unordered_map, mapped back and looked up; damaged images are either rejected when
+ * opened or, for the bucket index, answered with misses. Links against mapped_file.cpp; writes scratch files to the
+ * working directory.
+ */
+class mapped_unordered_map_test
+{
+    typedef stl::unordered_map<int, long>         source_type;
+    typedef stl::mapped_unordered_map<int, long>  map_type;
+
+    struct other_hash
+    {
+        stl::size_t operator()(int value) const noexcept { return static_cast<stl::size_t>(value) * 31 + 7; }
+    };
+
+    /// @brief Trivially copyable without a default constructor; paired with a @c char key it leaves padding in every entry.
+    struct reading
+    {
+        int level;
+
+        explicit reading(int l) : level(l) { }
+    };
+
+    typedef stl::unordered_map<char, reading>                 reading_source_type;
+    typedef stl::mapped_unordered_map<char, reading>          reading_map_type;
+
+    typedef stl::mapped_unordered_map<long, long>             other_key_type;
+    typedef stl::mapped_unordered_map<int, long, other_hash>  other_hash_type;
+
+    constexpr static int __KEYS = 5000;
+
+    // offsets inside __map_image_header
+    constexpr static stl::size_t __MAGIC_OFFSET        = 0;
+    constexpr static stl::size_t __SIZE_OFFSET         = 24;
+    constexpr static stl::size_t __BUCKET_COUNT_OFFSET = 32;
+    constexpr static stl::size_t __BUCKETS_OFFSET      = 40;
+    constexpr static stl::size_t __ENTRIES_OFFSET      = 48;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+        TEST_CASE(test_4());
+
+        std::remove(__PATH);
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    constexpr static const char* __PATH = "mapped_unordered_map_test.img";
+
+    static void write_image(int count)
+    {
+        source_type source;
+
+        for (int k = 0; k < count; ++k)
+            source.try_emplace(k, static_cast<long>(k) * 3);
+
+        map_type::write(__PATH, source);
+    }
+
+    static std::string read_file()
+    {
+        std::ifstream in(__PATH, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    static void write_file(const std::string& bytes)
+    {
+        std::ofstream out(__PATH, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    static uint64_t load_word(const std::string& bytes, stl::size_t offset)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + offset, sizeof(word));
+        return word;
+    }
+
+    static void store_word(std::string& bytes, stl::size_t offset, uint64_t word)
+    {
+        std::memcpy(&bytes[offset], &word, sizeof(word));
+    }
+
+    template <typename Map>
+    static bool rejected()
+    {
+        try
+        {
+            Map map(__PATH);
+        }
+        catch (const std::invalid_argument&)
+        {
+            return true;
+        }
+
+        return false;
+    }
+
+    // round-trip: every entry written is found with its value, and a sweep visits each once
+    bool test_0()
+    {
+        write_image(__KEYS);
+        map_type map(__PATH);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(__KEYS));
+
+        for (int k = 0; k < __KEYS; ++k)
+        {
+            map_type::const_iterator it = map.find(k);
+
+            __check_result_no_return__((it != map.end()), true);
+            __check_result_no_return__(it->second, static_cast<long>(k) * 3);
+            __check_result_no_return__(map.at(k), static_cast<long>(k) * 3);
+        }
+
+        long long sum = 0;
+        stl::size_t visited = 0;
+
+        for (map_type::const_iterator it = map.begin(); it != map.end(); ++it, ++visited)
+            sum += it->first;
+
+        __check_result_no_return__(visited, map.size());
+        __check_result_no_return__(sum, static_cast<long long>(__KEYS) * (__KEYS - 1) / 2);
+
+        return true;
+    }
+
+    // misses: absent keys, an empty image and a view without an image all answer end()
+    bool test_1()
+    {
+        write_image(__KEYS);
+        map_type map(__PATH);
+
+        for (int k = __KEYS; k < 2 * __KEYS; ++k)
+            __check_result_no_return__((map.find(k) == map.end()), true);
+
+        __check_result_no_return__(map.contains(-1), false);
+
+        bool thrown = false;
+        try { map.at(-1); } catch (const std::out_of_range&) { thrown = true; }
+        __check_result_no_return__(thrown, true);
+
+        write_image(0);
+        map_type empty(__PATH);
+        __check_result_no_return__(empty.empty(), true);
+        __check_result_no_return__((empty.find(0) == empty.end()), true);
+
+        map_type none;
+        __check_result_no_return__((none.find(0) == none.end()), true);
+
+        return true;
+    }
+
+    // damaged headers, truncated files and images of another layout or hasher are turned away when opened
+    bool test_2()
+    {
+        write_image(__KEYS);
+        const std::string image = read_file();
+
+        std::string bytes = image;
+        store_word(bytes, __MAGIC_OFFSET, 0);
+        write_file(bytes);
+        __check_result_no_return__(rejected<map_type>(), true);
+
+        write_file(image.substr(0, 32));
+        __check_result_no_return__(rejected<map_type>(), true);
+
+        write_file(image.substr(0, image.size() - 64));
+        __check_result_no_return__(rejected<map_type>(), true);
+
+        bytes = image;
+        store_word(bytes, __BUCKET_COUNT_OFFSET, load_word(image, __BUCKET_COUNT_OFFSET) * 2);
+        write_file(bytes);
+        __check_result_no_return__(rejected<map_type>(), true);
+
+        bytes = image;
+        store_word(bytes, __SIZE_OFFSET, load_word(image, __SIZE_OFFSET) - 1);
+        write_file(bytes);
+        __check_result_no_return__(rejected<map_type>(), true);
+
+        write_file(image);
+        __check_result_no_return__(rejected<other_key_type>(), true);
+        __check_result_no_return__(rejected<other_hash_type>(), true);
+
+        bool thrown = false;
+        try { map_type missing("no_such_dir/no_such_file.img"); } catch (const std::runtime_error&) { thrown = true; }
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    static stl::size_t bucket_of(int key, uint64_t buckets)
+    {
+        return static_cast<stl::size_t>(stl::__detail::__hash_mix(stl::hash<int>()(key)) & (buckets - 1));
+    }
+
+    // bucket offsets corrupted inside the index still open, but the lookups landing on them stay within the entries:
+    // an end offset far past the entries, and a start offset past the end offset
+    bool test_3()
+    {
+        write_image(__KEYS);
+        const std::string image = read_file();
+
+        const uint64_t buckets = load_word(image, __BUCKET_COUNT_OFFSET);
+        const stl::size_t index = static_cast<stl::size_t>(load_word(image, __BUCKETS_OFFSET));
+
+        // two missing keys, away from the first and last offsets that opening checks
+        int past_end = 2 * __KEYS;
+        while (bucket_of(past_end, buckets) + 1 == buckets)
+            ++past_end;
+
+        int reversed = past_end + 1;
+        while (bucket_of(reversed, buckets) == 0 || bucket_of(reversed, buckets) == bucket_of(past_end, buckets) ||
+               bucket_of(reversed, buckets) == bucket_of(past_end, buckets) + 1)
+            ++reversed;
+
+        const stl::size_t b = bucket_of(past_end, buckets);
+        const stl::size_t c = bucket_of(reversed, buckets);
+
+        std::string bytes = image;
+        store_word(bytes, index + (b + 1) * sizeof(uint64_t), 1ULL << 40);
+        store_word(bytes, index + c * sizeof(uint64_t), load_word(image, index + (c + 1) * sizeof(uint64_t)) + 1);
+        write_file(bytes);
+
+        map_type map(__PATH);
+
+        __check_result_no_return__((map.find(past_end) == map.end()), true);
+        __check_result_no_return__((map.find(reversed) == map.end()), true);
+
+        stl::size_t found = 0;
+
+        for (int k = 0; k < 2 * __KEYS; ++k)
+        {
+            map_type::const_iterator it = map.find(k);
+
+            if (it == map.end())
+                continue;
+
+            __check_result_no_return__(it->first, k);
+            __check_result_no_return__(it->second, static_cast<long>(k) * 3);
+            ++found;
+        }
+
+        __check_result_no_return__((found <= static_cast<stl::size_t>(__KEYS)), true);
+        __check_result_no_return__((found > 0), true);
+
+        return true;
+    }
+
+    // values that cannot be default constructed are written; the padding of every entry is written as zeros, so the same
+    // map always gives the same image
+    bool test_4()
+    {
+        reading_source_type source;
+
+        for (int k = 0; k < 100; ++k)
+            source.try_emplace(static_cast<char>(k), k * 2);
+
+        reading_map_type::write(__PATH, source);
+        const std::string image = read_file();
+
+        reading_map_type::write(__PATH, source);
+        __check_result_no_return__((read_file() == image), true);
+
+        // the key is one byte, the value starts at the end of the entry: everything in between is padding
+        const stl::size_t entries = load_word(image, __ENTRIES_OFFSET);
+        const stl::size_t entry_size = sizeof(reading_map_type::value_type);
+
+        for (stl::size_t e = 0; e < 100; ++e)
+            for (stl::size_t b = sizeof(char); b < entry_size - sizeof(reading); ++b)
+                __check_result_no_return__(image[entries + e * entry_size + b], '\0');
+
+        reading_map_type map(__PATH);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(100));
+
+        for (int k = 0; k < 100; ++k)
+            __check_result_no_return__(map.at(static_cast<char>(k)).level, k * 2);
+
+        __check_result_no_return__(map.contains(static_cast<char>(100)), false);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 5;
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/rcu_unordered_map/rcu_unordered_map.h"
+#include "UTconfig.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/**
+ * Read-copy-update map: round-trips and misses on one thread, reclamation once the readers are gone, then lock-free
+ * readers running against writers. The values are strings, so a node freed under a reader shows up under ASan.
+ * Build with -pthread.
+ */
+class rcu_unordered_map_test
+{
+    typedef stl::rcu_unordered_map<int, std::string>  map_type;
+
+    constexpr static int __READERS = 3;
+    constexpr static int __WRITERS = 2;
+    constexpr static int __KEYS    = 3000;     // per writer
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    static std::string value_of(int key, int version) { return std::to_string(key) + "/" + std::to_string(version); }
+
+    static bool valid(int key, const std::string& value)
+    { return value == value_of(key, 0) || value == value_of(key, 1); }
+
+    // round-trip, overwrite, erase and a full visit on one thread; missing keys are absent everywhere
+    bool test_0()
+    {
+        map_type map(8);
+
+        for (int k = 0; k < 1000; ++k)
+            __check_result_no_return__(map.insert(k, value_of(k, 0)), true);
+
+        __check_result_no_return__(map.insert(3, value_of(3, 1)), false);
+        __check_result_no_return__(*map.find(3), value_of(3, 0));
+        __check_result_no_return__(map.insert_or_assign(3, value_of(3, 1)), false);
+        __check_result_no_return__(*map.find(3), value_of(3, 1));
+
+        for (int k = 1000; k < 2000; ++k)
+        {
+            __check_result_no_return__(map.find(k).has_value(), false);
+            __check_result_no_return__(map.contains(k), false);
+        }
+
+        __check_result_no_return__(map.erase(4), static_cast<stl::size_t>(1));
+        __check_result_no_return__(map.erase(4), static_cast<stl::size_t>(0));
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(999));
+
+        stl::size_t visited = 0;
+        bool consistent = true;
+
+        map.cvisit_all([&visited, &consistent](const int& key, const std::string& value)
+        {
+            ++visited;
+            consistent = consistent && key != 4 && valid(key, value);
+        });
+
+        __check_result_no_return__(visited, static_cast<stl::size_t>(999));
+        __check_result_no_return__(consistent, true);
+
+        return true;
+    }
+
+    // with no reader inside, every retired node and table is freed; growing and clearing keep the entries straight
+    bool test_1()
+    {
+        map_type map(4);
+
+        for (int k = 0; k < 2000; ++k)
+            map.insert(k, value_of(k, 0));
+
+        map.reserve(10000);
+        __check_result_no_return__((map.bucket_count() >= 10000), true);
+
+        for (int k = 0; k < 2000; ++k)
+            __check_result_no_return__(*map.find(k), value_of(k, 0));
+
+        for (int k = 0; k < 2000; k += 2)
+            map.insert_or_assign(k, value_of(k, 1));
+
+        map.reclaim();
+        __check_result_no_return__(map.retired(), static_cast<stl::size_t>(0));
+
+        map.clear();
+        __check_result_no_return__(map.empty(), true);
+        __check_result_no_return__(map.find(0).has_value(), false);
+
+        map.reclaim();
+        __check_result_no_return__(map.retired(), static_cast<stl::size_t>(0));
+
+        return true;
+    }
+
+    // readers look keys up and sweep the map while writers insert, replace, erase and grow it
+    bool test_2()
+    {
+        map_type map(4);
+
+        std::atomic<int> writers_done(0);
+        std::atomic<bool> consistent(true);
+
+        stl::vector<std::thread> threads;
+        threads.reserve(__READERS + __WRITERS);
+
+        // the readers start first, so they are already inside the map when the writes begin
+        for (int t = 0; t < __READERS; ++t)
+        {
+            threads.emplace_back([&map, &writers_done, &consistent]()
+            {
+                while (writers_done.load() < __WRITERS)
+                {
+                    for (int k = 0; k < __WRITERS * __KEYS; k += 5)
+                    {
+                        std::optional<std::string> value = map.find(k);
+
+                        if (value && !valid(k, *value))
+                            consistent = false;
+                    }
+
+                    map.cvisit_all([&consistent](const int& key, const std::string& value)
+                    {
+                        if (!valid(key, value))
+                            consistent = false;
+                    });
+                }
+            });
+        }
+
+        for (int t = 0; t < __WRITERS; ++t)
+        {
+            threads.emplace_back([&map, &writers_done, t]()
+            {
+                const int base = t * __KEYS;
+
+                for (int k = base; k < base + __KEYS; ++k)
+                    map.insert(k, value_of(k, 0));
+
+                for (int k = base; k < base + __KEYS; k += 2)
+                    map.insert_or_assign(k, value_of(k, 1));
+
+                for (int k = base + 1; k < base + __KEYS; k += 4)
+                    map.erase(k);
+
+                ++writers_done;
+            });
+        }
+
+        for (stl::size_t i = 0; i < threads.size(); ++i)
+            threads.data()[i].join();
+
+        __check_result_no_return__(consistent.load(), true);
+
+        stl::size_t expected = 0;
+
+        for (int k = 0; k < __WRITERS * __KEYS; ++k)
+        {
+            const int offset = k % __KEYS;
+            std::optional<std::string> value = map.find(k);
+
+            if (offset % 4 == 1)
+            {
+                __check_result_no_return__(value.has_value(), false);
+                continue;
+            }
+
+            ++expected;
+            __check_result_no_return__(value.has_value(), true);
+            __check_result_no_return__(*value, value_of(k, offset % 2 == 0 ? 1 : 0));
+        }
+
+        __check_result_no_return__(map.size(), expected);
+
+        map.reclaim();
+        __check_result_no_return__(map.retired(), static_cast<stl::size_t>(0));
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 3;
+};
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/functional_hash/seeded_hash.h"
+#include "../STL/containers/unordered_map/unordered_map.h"
+#include "UTconfig.h"
+
+#include <string>
+
+/**
+ * Keyed hashing under adversarial keys: key sets built so that every key shares one unkeyed @c stl::hash value must
+ * spread over the buckets once the table hashes with @c stl::seeded_hash. Links against siphash.cpp.
+ */
+class seeded_hash_test
+{
+    constexpr static stl::size_t __KEYS      = 20000;
+    constexpr static stl::size_t __MAX_CHAIN = 16;       // far above what 20000 random keys give at load factor <= 1
+
+    constexpr static stl::size_t __COMBINE = 0x9e3779b97f4a7c15ULL;
+    constexpr static stl::size_t __TARGET  = 0x0123456789abcdefULL;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    // the words of a pair<long, long> are folded by hash_combine(mix(a + 0xc70f6907), b): b cancels the first word out
+    static stl::pair<long, long> colliding_pair(long a)
+    {
+        stl::size_t h = stl::__detail::__hash_mix(static_cast<stl::size_t>(a) + static_cast<stl::size_t>(0xc70f6907UL));
+        return stl::pair<long, long>(a, static_cast<long>(__TARGET - h - __COMBINE));
+    }
+
+    // hash_values(a, s) is hash_combine(hash_values(s), a): a cancels the string member out
+    static stl::pair<long, std::string> colliding_member_pair(stl::size_t i)
+    {
+        std::string s = "key_" + std::to_string(i);
+        return stl::pair<long, std::string>(static_cast<long>(__TARGET - stl::hash_values(s) - __COMBINE), s);
+    }
+
+    // pairs stored as one block of bytes: 20000 keys sharing one stl::hash keep short chains under seeded_hash
+    bool test_0()
+    {
+        typedef stl::pair<long, long> key_type;
+        stl::unordered_map<key_type, int, stl::seeded_hash<key_type>> map;
+
+        const stl::size_t collision = stl::hash<key_type>()(colliding_pair(0));
+
+        for (stl::size_t i = 0; i < __KEYS; ++i)
+        {
+            key_type key = colliding_pair(static_cast<long>(i));
+
+            __check_result_no_return__(stl::hash<key_type>()(key), collision);
+            map.try_emplace(key, static_cast<int>(i));
+        }
+
+        __check_result_no_return__(map.size(), __KEYS);
+        __check_result_no_return__((map.stats().max_chain <= __MAX_CHAIN), true);
+
+        for (stl::size_t i = 0; i < __KEYS; ++i)
+            __check_result_no_return__(map.find(colliding_pair(static_cast<long>(i)))->second, static_cast<int>(i));
+
+        return true;
+    }
+
+    // pairs hashed member by member: the seed reaches every member, so the fold cannot be cancelled out either
+    bool test_1()
+    {
+        typedef stl::pair<long, std::string> key_type;
+        stl::unordered_map<key_type, int, stl::seeded_hash<key_type>> map;
+
+        const stl::size_t collision = stl::hash<key_type>()(colliding_member_pair(0));
+
+        for (stl::size_t i = 0; i < __KEYS; ++i)
+        {
+            key_type key = colliding_member_pair(i);
+
+            __check_result_no_return__(stl::hash<key_type>()(key), collision);
+            map.try_emplace(key, static_cast<int>(i));
+        }
+
+        __check_result_no_return__(map.size(), __KEYS);
+        __check_result_no_return__((map.stats().max_chain <= __MAX_CHAIN), true);
+
+        return true;
+    }
+
+    // one key, one hash: copies and instances built from the same key agree, equal keys hash alike
+    bool test_2()
+    {
+        stl::sip_key key = { 0x0706050403020100ULL, 0x0f0e0d0c0b0a0908ULL };
+
+        stl::seeded_hash<int> h(key);
+        stl::seeded_hash<int> copy = h;
+        __check_result_no_return__(h(42), copy(42));
+        __check_result_no_return__(h(42), stl::seeded_hash<int>(key)(42));
+        __check_result_no_return__((h(42) != h(43)), true);
+
+        stl::seeded_hash<double> hd(key);
+        __check_result_no_return__(hd(0.0), hd(-0.0));
+        __check_result_no_return__((hd(1.5) != hd(2.5)), true);
+
+        stl::seeded_hash<std::string> hs(key);
+        __check_result_no_return__(hs(std::string("lorem")), stl::seeded_hash<const char*>(key)("lorem"));
+        __check_result_no_return__(hs(std::string("lorem")), stl::seeded_hash<std::string_view>(key)("lorem"));
+
+        stl::seeded_hash<std::tuple<int, std::string>> ht(key);
+        __check_result_no_return__(ht(std::make_tuple(1, std::string("a"))), ht(std::make_tuple(1, std::string("a"))));
+        __check_result_no_return__((ht(std::make_tuple(1, std::string("a"))) != ht(std::make_tuple(2, std::string("a")))), true);
+
+        return true;
+    }
+
+    // the seed propagates through hash_combine and hash_values: another key gives other values
+    bool test_3()
+    {
+        stl::sip_key first  = { 1, 2 };
+        stl::sip_key second = { 3, 4 };
+
+        std::string s = "tenant";
+
+        __check_result_no_return__(stl::hash_values(first, 7, s), stl::hash_values(first, 7, s));
+        __check_result_no_return__((stl::hash_values(first, 7, s) != stl::hash_values(second, 7, s)), true);
+        __check_result_no_return__((stl::hash_values(first, 7, s) != stl::hash_values(first, s, 7)), true);
+
+        __check_result_no_return__(stl::hash_impl::hash_combine(7, 0, first), stl::hash_impl::hash_combine(7, 0, first));
+        __check_result_no_return__((stl::hash_impl::hash_combine(7, 0, first) != stl::hash_impl::hash_combine(7, 0, second)), true);
+        __check_result_no_return__(stl::hash_impl::hash_combine(7, 0, first), stl::hash_combine(0, stl::seeded_hash<int>(first)(7)));
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
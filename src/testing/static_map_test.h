@@ -0,0 +1,186 @@
+#pragma once
+
+#include "../STL/containers/static_map/static_map.h"
+#include "UTconfig.h"
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Compile-time tables: @c hash_bytes_constexpr gives the values @c hash_bytes gives at run time for every length class
+ * of the short path, and a @c static_map, built in a constant expression or at run time, finds each of its keys and
+ * rejects every other key.
+ */
+class static_map_test
+{
+    constexpr static char __TEXT[] = "the quick brown fox jumps over the lazy dog, then the lazy dog gets up and chases "
+                                     "the quick brown fox all the way back across the field and over the fence again";
+
+    constexpr static stl::size_t __SEED = 0x2545f4914f6cdd1dULL;
+
+    typedef stl::static_map<int, int, 20>                   port_map_type;
+    typedef stl::static_map<std::string_view, int, 12>      opcode_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief True when the first @c Length bytes of the text hash alike in a constant expression and at run time,
+    ///        through @c hash_bytes and through the string hash alike.
+    template <stl::size_t Length>
+    static bool agrees()
+    {
+        constexpr stl::size_t compile_time = stl::hash_bytes_constexpr(__TEXT, Length, __SEED);
+        constexpr stl::size_t compile_time_string = stl::hash<std::string_view>()(std::string_view(__TEXT, Length));
+
+        // a copy the compiler cannot see through, so the run-time kernel does the hashing
+        const std::string copy(__TEXT, Length);
+
+        return compile_time == stl::hash_bytes(copy.data(), copy.size(), __SEED) &&
+               compile_time_string == stl::hash<std::string>()(copy);
+    }
+
+    // lengths 0, 1-3, 4-8, 9-16 and 17 onwards, across each boundary of the short path
+    bool test_0()
+    {
+        __check_result_no_return__(agrees<0>(), true);
+
+        __check_result_no_return__(agrees<1>(), true);
+        __check_result_no_return__(agrees<2>(), true);
+        __check_result_no_return__(agrees<3>(), true);
+
+        __check_result_no_return__(agrees<4>(), true);
+        __check_result_no_return__(agrees<7>(), true);
+        __check_result_no_return__(agrees<8>(), true);
+
+        __check_result_no_return__(agrees<9>(), true);
+        __check_result_no_return__(agrees<15>(), true);
+        __check_result_no_return__(agrees<16>(), true);
+
+        __check_result_no_return__(agrees<17>(), true);
+        __check_result_no_return__(agrees<32>(), true);
+        __check_result_no_return__(agrees<33>(), true);
+        __check_result_no_return__(agrees<48>(), true);
+        __check_result_no_return__(agrees<49>(), true);
+        __check_result_no_return__(agrees<97>(), true);
+        __check_result_no_return__(agrees<sizeof(__TEXT) - 1>(), true);
+
+        return true;
+    }
+
+    // integer keys in a constant expression: every key found, with its value, from a constant and from a run-time key
+    bool test_1()
+    {
+        constexpr port_map_type ports = stl::make_static_map<int, int>({
+            {21, 0}, {22, 1}, {23, 2}, {25, 3}, {53, 4}, {80, 5}, {110, 6}, {143, 7}, {443, 8}, {465, 9}, {587, 10},
+            {993, 11}, {995, 12}, {3306, 13}, {5432, 14}, {6379, 15}, {8080, 16}, {8443, 17}, {9200, 18}, {27017, 19} });
+
+        static_assert(ports.at(443) == 8, "the port table is searched at compile time");
+        static_assert(!ports.contains(444), "a missing port misses at compile time");
+
+        for (port_map_type::const_iterator it = ports.begin(); it != ports.end(); ++it)
+        {
+            __check_result_no_return__(ports.find(it->first), it);
+            __check_result_no_return__(ports.at(it->first), it->second);
+        }
+
+        stl::size_t found = 0;
+
+        for (int port = 0; port < 30000; ++port)
+            found += ports.count(port);
+
+        __check_result_no_return__(found, ports.size());
+
+        bool thrown = false;
+        try { ports.at(8081); } catch (const std::out_of_range&) { thrown = true; }
+
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    // string keys hashed at compile time are found from strings built at run time, near misses included
+    bool test_2()
+    {
+        constexpr opcode_map_type opcodes = stl::make_static_map<std::string_view, int>({
+            {"", 0}, {"a", 1}, {"or", 2}, {"xor", 3}, {"load", 4}, {"store", 5}, {"syscall", 6}, {"breakpoint", 7},
+            {"compare_exchange", 8}, {"load_acquire_64bit", 9}, {"atomic_fetch_add_relaxed_unsigned", 10},
+            {"a mnemonic long enough to fold in more than one forty-eight byte round", 11} });
+
+        static_assert(opcodes.at("syscall") == 6, "the opcode table is built and searched at compile time");
+
+        for (opcode_map_type::const_iterator it = opcodes.begin(); it != opcodes.end(); ++it)
+        {
+            const std::string key(it->first);
+
+            __check_result_no_return__(opcodes.at(key), it->second);
+
+            // one character more, one less and one changed
+            __check_result_no_return__(opcodes.contains(key + "x"), false);
+
+            if (!key.empty())
+            {
+                std::string changed(key);
+                changed.back() ^= 1;
+
+                __check_result_no_return__(opcodes.contains(key.substr(0, key.size() - 1)), (key.size() == 1));
+                __check_result_no_return__(opcodes.contains(changed), false);
+            }
+        }
+
+        __check_result_no_return__((opcodes.find("jump") == opcodes.end()), true);
+
+        return true;
+    }
+
+    // built at run time over keys it only learns then; duplicate keys are refused
+    bool test_3()
+    {
+        typedef stl::static_map<int, int, 1000>  large_map_type;
+
+        static large_map_type::value_type items[1000];
+
+        for (int i = 0; i < 1000; ++i)
+            items[i] = large_map_type::value_type(i * 7919, i);
+
+        large_map_type map(items);
+
+        for (int i = 0; i < 1000; ++i)
+            __check_result_no_return__(map.at(i * 7919), i);
+
+        stl::size_t found = 0;
+
+        for (int k = 0; k < 1000 * 7919; k += 13)
+            found += map.count(k);
+
+        __check_result_no_return__(found, static_cast<stl::size_t>(1000 / 13 + 1));
+
+        stl::static_map<int, int, 1>::value_type single[1] = { {5, 50} };
+        stl::static_map<int, int, 1> one(single);
+
+        __check_result_no_return__(one.at(5), 50);
+        __check_result_no_return__(one.contains(6), false);
+
+        stl::static_map<int, int, 3>::value_type twice[3] = { {1, 1}, {2, 2}, {1, 3} };
+
+        bool thrown = false;
+        try { stl::static_map<int, int, 3> duplicate(twice); } catch (const std::invalid_argument&) { thrown = true; }
+
+        __check_result_no_return__(thrown, true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
@@ -12,6 +12,15 @@
 #define __TEST_VECTOR__          0
 #define __TEST_FUNCTIONAL_HASH__ 0
 #define __TEST_TYPE_TRAITS__     0
+#define __TEST_UNORDERED_MAP__   0
+#define __TEST_SEEDED_HASH__     0
+#define __TEST_MAPPED_UNORDERED_MAP__ 0
+#define __TEST_CONCURRENT_UNORDERED_MAP__ 0
+#define __TEST_RCU_UNORDERED_MAP__ 0
+#define __TEST_FROZEN_UNORDERED_MAP__ 0
+#define __TEST_DENSE_UNORDERED_MAP__ 0
+#define __TEST_FLAT_HASH_MAP__     0
+#define __TEST_STATIC_MAP__        0
 
 class node 
 {
@@ -114,6 +123,137 @@ static void test_vector()
     vector_container_vector.__TEST__();
 }
 
+static void test_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Unordered Map     |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== INCREMENTAL REHASH ===\n\n";
+    unordered_map_incremental_test unordered_map_incremental;
+    unordered_map_incremental.__TEST__();
+
+    std::cout << "=== INLINE NODES ===\n\n";
+    unordered_map_inline_test unordered_map_inline;
+    unordered_map_inline.__TEST__();
+
+    std::cout << "=== NODE HANDLES ===\n\n";
+    unordered_map_node_test unordered_map_node;
+    unordered_map_node.__TEST__();
+
+    std::cout << "=== LOOKUP STATISTICS ===\n\n";
+    unordered_map_stats_test unordered_map_stats;
+    unordered_map_stats.__TEST__();
+
+    std::cout << "=== BATCHED LOOKUPS ===\n\n";
+    unordered_map_batch_test unordered_map_batch;
+    unordered_map_batch.__TEST__();
+
+    std::cout << "=== PARALLEL BULK OPERATIONS ===\n\n";
+    unordered_map_parallel_test unordered_map_parallel;
+    unordered_map_parallel.__TEST__();
+
+    std::cout << "=== NODE POOL ===\n\n";
+    pool_allocator_test pool_allocator;
+    pool_allocator.__TEST__();
+
+    std::cout << "=== BULK INSERTION ===\n\n";
+    unordered_map_bulk_test unordered_map_bulk;
+    unordered_map_bulk.__TEST__();
+}
+
+static void test_seeded_hash()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Seeded Hash       |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== ADVERSARIAL KEYS ===\n\n";
+    seeded_hash_test seeded_hash;
+    seeded_hash.__TEST__();
+}
+
+static void test_mapped_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Mapped Map        |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== IMAGES ===\n\n";
+    mapped_unordered_map_test mapped_unordered_map;
+    mapped_unordered_map.__TEST__();
+}
+
+static void test_concurrent_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Concurrent Map    |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== READERS AND WRITERS ===\n\n";
+    concurrent_unordered_map_test concurrent_unordered_map;
+    concurrent_unordered_map.__TEST__();
+}
+
+static void test_rcu_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the RCU Map           |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== READERS AND WRITERS ===\n\n";
+    rcu_unordered_map_test rcu_unordered_map;
+    rcu_unordered_map.__TEST__();
+}
+
+static void test_frozen_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Frozen Map        |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== PERFECT HASH ===\n\n";
+    frozen_unordered_map_test frozen_unordered_map;
+    frozen_unordered_map.__TEST__();
+}
+
+static void test_dense_unordered_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Dense Map         |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== POWER OF TWO BUCKETS ===\n\n";
+    dense_unordered_map_test<stl::power2_rehash_policy> dense_unordered_map_power2;
+    dense_unordered_map_power2.__TEST__();
+
+    std::cout << "=== PRIME BUCKETS ===\n\n";
+    dense_unordered_map_test<stl::prime_rehash_policy> dense_unordered_map_prime;
+    dense_unordered_map_prime.__TEST__();
+}
+
+static void test_flat_hash_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Flat Hash Map     |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== IN-PLACE INSERTION AND GROWTH ===\n\n";
+    flat_hash_map_test flat_hash_map;
+    flat_hash_map.__TEST__();
+}
+
+static void test_static_map()
+{
+    std::cout << "\n+-------------------------------+\n"
+              << "| Testing the Static Map        |\n"
+              << "+-------------------------------+\n\n";
+
+    std::cout << "=== COMPILE-TIME HASHES AND TABLES ===\n\n";
+    static_map_test static_map;
+    static_map.__TEST__();
+}
+
 void INIT_UNIT_TESTS()
 {
 #if __TEST_TYPE_TRAITS__
@@ -131,4 +271,40 @@ void INIT_UNIT_TESTS()
 #if __TEST_VECTOR__ || __TEST_ALL__
     test_vector();
 #endif
+
+#if __TEST_UNORDERED_MAP__ || __TEST_ALL__
+    test_unordered_map();
+#endif
+
+#if __TEST_SEEDED_HASH__ || __TEST_ALL__
+    test_seeded_hash();
+#endif
+
+#if __TEST_MAPPED_UNORDERED_MAP__ || __TEST_ALL__
+    test_mapped_unordered_map();
+#endif
+
+#if __TEST_CONCURRENT_UNORDERED_MAP__ || __TEST_ALL__
+    test_concurrent_unordered_map();
+#endif
+
+#if __TEST_RCU_UNORDERED_MAP__ || __TEST_ALL__
+    test_rcu_unordered_map();
+#endif
+
+#if __TEST_FROZEN_UNORDERED_MAP__ || __TEST_ALL__
+    test_frozen_unordered_map();
+#endif
+
+#if __TEST_DENSE_UNORDERED_MAP__ || __TEST_ALL__
+    test_dense_unordered_map();
+#endif
+
+#if __TEST_FLAT_HASH_MAP__ || __TEST_ALL__
+    test_flat_hash_map();
+#endif
+
+#if __TEST_STATIC_MAP__ || __TEST_ALL__
+    test_static_map();
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,1610 @@
+#pragma once
+
+#include "../STL/iterator.h"
+#include "../STL/containers/unordered_map/unordered_map.h"
+#include "../STL/allocator/pool_allocator.h"
+#include "UTconfig.h"
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+namespace my_alloc
+{
+    /// @brief Hands out memory filled with 0xAB, so a bucket or node read before it is written points nowhere valid.
+    template <typename T>
+    class poisoning_allocator : public stl::allocator<T>
+    {
+    public:
+        template <typename U>
+        struct rebind { typedef poisoning_allocator<U> other; };
+
+        poisoning_allocator() noexcept { }
+
+        template <typename U>
+        poisoning_allocator(const poisoning_allocator<U>&) noexcept { }
+
+        T* allocate(stl::size_t size, const void* = nullptr)
+        {
+            T* ptr = stl::allocator<T>::allocate(size);
+            std::memset(static_cast<void*>(ptr), 0xAB, size * sizeof(T));
+            return ptr;
+        }
+    };
+
+    template <typename TypeI, typename TypeII>
+    bool operator==(const poisoning_allocator<TypeI>&, const poisoning_allocator<TypeII>&) { return true; }
+
+    template <typename TypeI, typename TypeII>
+    bool operator!=(const poisoning_allocator<TypeI>&, const poisoning_allocator<TypeII>&) { return false; }
+
+    /// @brief Calls of every @c tagged_allocator, whatever it is rebound to.
+    struct allocation_counts
+    {
+        static inline long allocations = 0;
+        static inline long deallocations = 0;
+    };
+
+    /// @brief Allocators compare equal only when their tags match; every allocation and deallocation is counted.
+    template <typename T>
+    class tagged_allocator : public stl::allocator<T>, public allocation_counts
+    {
+    public:
+        int tag;
+
+        template <typename U>
+        struct rebind { typedef tagged_allocator<U> other; };
+
+        tagged_allocator(int t = 0) noexcept : tag(t) { }
+
+        template <typename U>
+        tagged_allocator(const tagged_allocator<U>& other) noexcept : tag(other.tag) { }
+
+        T* allocate(stl::size_t size, const void* = nullptr)
+        {
+            ++allocations;
+            return stl::allocator<T>::allocate(size);
+        }
+
+        void deallocate(T* ptr, stl::size_t size)
+        {
+            ++deallocations;
+            stl::allocator<T>::deallocate(ptr, size);
+        }
+    };
+
+    template <typename TypeI, typename TypeII>
+    bool operator==(const tagged_allocator<TypeI>& lhs, const tagged_allocator<TypeII>& rhs) { return lhs.tag == rhs.tag; }
+
+    template <typename TypeI, typename TypeII>
+    bool operator!=(const tagged_allocator<TypeI>& lhs, const tagged_allocator<TypeII>& rhs) { return lhs.tag != rhs.tag; }
+}
+
+/**
+ * Incremental rehashing: a map using @c stl::incremental_rehash_policy<1> is kept in the middle of a migration (one old
+ * bucket moved per insert) while it is read, scanned and erased from. Every allocation is poisoned.
+ */
+class unordered_map_incremental_test
+{
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                               my_alloc::poisoning_allocator<stl::pair_node<int, int>>,
+                               stl::incremental_rehash_policy<1>>                      map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+        TEST_CASE(test_4());
+        TEST_CASE(test_5());
+        TEST_CASE(test_6());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Fills @c map with keys [0, @c count) mapped to their square, stopping with a migration under way.
+    static bool fill_mid_migration(map_type& map, int count)
+    {
+        for (int k = 0; k < count; ++k)
+            map.try_emplace(k, k * k);
+
+        return map.size() == static_cast<stl::size_t>(count);
+    }
+
+    // round-trip: every key inserted while tables are being drained is found with its value, a missing key is not
+    bool test_0()
+    {
+        map_type map(64);
+
+        __check_result_no_return__(fill_mid_migration(map, 3000), true);
+
+        for (int k = 0; k < 3000; ++k)
+        {
+            map_type::iterator it = map.find(k);
+
+            __check_result_no_return__((it != map.end()), true);
+            __check_result_no_return__(it->second, k * k);
+        }
+
+        for (int k = 3000; k < 6000; ++k)
+            __check_result_no_return__((map.find(k) == map.end()), true);
+
+        return true;
+    }
+
+    // the bucket scans see exactly the entries of the map: no bucket of the new table is read before it is written
+    bool test_1()
+    {
+        map_type map(64);
+
+        for (int k = 0; k < 2000; ++k)
+        {
+            map.try_emplace(k, k);
+
+            if (k % 250 != 0)
+                continue;
+
+            stl::size_t total = 0;
+            for (stl::size_t b = 0; b < map.bucket_count(); ++b)
+                total += map.bucket_size(b);
+
+            __check_result_no_return__(total, map.size());
+            __check_result_no_return__(map.stats().size, map.size());
+        }
+
+        return true;
+    }
+
+    // a full walk after a migration started visits every entry once
+    bool test_2()
+    {
+        map_type map(64);
+
+        __check_result_no_return__(fill_mid_migration(map, 1600), true);
+
+        stl::size_t visited = 0;
+        long long sum = 0;
+
+        for (map_type::iterator it = map.begin(); it != map.end(); ++it, ++visited)
+            sum += it->first;
+
+        __check_result_no_return__(visited, map.size());
+        __check_result_no_return__(sum, 1600LL * 1599 / 2);
+
+        return true;
+    }
+
+    // iterators handed out mid-migration: walking on from a find() result, or from the iterator erase(it) returns,
+    // only ever reaches entries of the map
+    bool test_3()
+    {
+        map_type map(64);
+
+        __check_result_no_return__(fill_mid_migration(map, 3000), true);
+
+        for (int k = 0; k < 3000; k += 3)
+        {
+            map_type::iterator it = map.find(k);
+
+            __check_result_no_return__((it != map.end()), true);
+
+            for (map_type::iterator next = it; next != map.end(); ++next)
+                __check_result_no_return__(next->second, next->first * next->first);
+
+            for (map_type::iterator next = map.erase(it); next != map.end(); ++next)
+                __check_result_no_return__(next->second, next->first * next->first);
+
+            __check_result_no_return__((map.find(k) == map.end()), true);
+
+            // keeps the migration going for the next round
+            map.try_emplace(3000 + k, (3000 + k) * (3000 + k));
+        }
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(3000));
+
+        return true;
+    }
+
+    // equal_range steps past its match with stl::next, which must not leave the entries of the map either
+    bool test_4()
+    {
+        map_type map(64);
+
+        __check_result_no_return__(fill_mid_migration(map, 3000), true);
+
+        for (int k = 0; k < 3000; k += 7)
+        {
+            stl::pair<map_type::iterator, map_type::iterator> range = map.equal_range(k);
+
+            __check_result_no_return__((range.first != map.end()), true);
+            __check_result_no_return__(range.first->first, k);
+
+            if (range.second != map.end())
+                __check_result_no_return__(range.second->second, range.second->first * range.second->first);
+        }
+
+        return true;
+    }
+
+    // const_iterators found mid-migration outlive lookups, batched lookups and erasures by key, none of which migrates,
+    // and walk on from an old bucket into the new table: before and after one of them, every entry is visited once
+    bool test_5()
+    {
+        map_type map(64);
+        const map_type& cmap = map;
+
+        stl::vector<int> keys;
+        stl::size_t erased = 0;
+
+        for (int k = 0; k < 1500; ++k)
+        {
+            map.try_emplace(k, k * k);
+            keys.push_back(k);
+
+            map_type::const_iterator held = cmap.find(k);
+            map_type::const_iterator after = stl::next(held);
+
+            for (int j = 0; j <= k; ++j)
+                map.find(j);
+
+            stl::vector<map_type::iterator> found(keys.size(), map_type::iterator());
+            map.find_batch(keys.data(), keys.size(), found.data());
+
+            // an entry other than those the iterators point to goes
+            int victim = k / 2;
+
+            if (victim != k && (after == cmap.cend() || after->first != victim))
+                erased += map.erase(victim);
+
+            stl::size_t visited = 0;
+
+            for (map_type::const_iterator it = cmap.cbegin(); it != held; ++it, ++visited)
+                __check_result_no_return__(it->second, it->first * it->first);
+
+            for (map_type::const_iterator it = held; it != cmap.cend(); ++it, ++visited)
+                __check_result_no_return__(it->second, it->first * it->first);
+
+            __check_result_no_return__(visited, map.size());
+            __check_result_no_return__(map.size(), static_cast<stl::size_t>(k + 1) - erased);
+        }
+
+        return true;
+    }
+
+    /// @brief True while the map holds an old bucket array besides its current one.
+    static bool migrating(const map_type& map)
+    { return map.stats().bucket_bytes > map.bucket_count() * sizeof(map_type::pointer); }
+
+    // mid-migration the bucket interface holds every key in bucket(key), and const members read the map from several
+    // threads at once without finishing the migration (a data race or a double free shows under TSan and ASan)
+    bool test_6()
+    {
+        map_type map(64);
+        const map_type& cmap = map;
+
+        int count = 0;
+
+        for (; count < 1000 && (!migrating(cmap) || count < 60); ++count)
+            map.try_emplace(count, count * count);
+
+        __check_result_no_return__(migrating(cmap), true);
+
+        for (int k = 0; k < count; ++k)
+        {
+            bool found = false;
+
+            for (map_type::const_local_iterator it = cmap.cbegin(cmap.bucket(k)); it != map_type::const_local_iterator(nullptr); ++it)
+                found = found || it->m_pair.first == k;
+
+            __check_result_no_return__(found, true);
+        }
+
+        std::atomic<bool> consistent(true);
+        stl::vector<std::thread> threads;
+
+        for (int t = 0; t < 3; ++t)
+        {
+            threads.emplace_back([&cmap, &consistent]()
+            {
+                for (int round = 0; round < 50; ++round)
+                {
+                    stl::size_t visited = 0, total = 0;
+
+                    for (map_type::const_iterator it = cmap.cbegin(); it != cmap.cend(); ++it)
+                        ++visited;
+
+                    for (stl::size_t b = 0; b < cmap.bucket_count(); ++b)
+                        total += cmap.bucket_size(b);
+
+                    if (visited != cmap.size() || total != cmap.size() || cmap.stats().size != cmap.size() || !cmap.contains(0))
+                        consistent = false;
+                }
+            });
+        }
+
+        for (stl::size_t i = 0; i < threads.size(); ++i)
+            threads.data()[i].join();
+
+        __check_result_no_return__(consistent.load(), true);
+        __check_result_no_return__(migrating(cmap), true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 7;
+};
+
+/**
+ * Inline nodes: a map of at most @c N entries keeps them inside the map object, allocating nothing, and moves them to
+ * the heap as it grows, which must lose nothing when building the heap nodes throws.
+ */
+class unordered_map_inline_test
+{
+    /// @brief Counts its live objects and throws from its copy once @c copies_left reaches 0. Its move may throw too,
+    ///        so a map promoting it copies it.
+    struct fragile
+    {
+        static inline int live = 0;
+        static inline int copies_left = -1;     // never throws while negative
+
+        int value;
+
+        fragile(int v = 0) : value(v) { ++live; }
+
+        fragile(const fragile& other) : value(other.value)
+        {
+            if (copies_left == 0)
+                throw std::runtime_error("fragile copy");
+
+            if (copies_left > 0)
+                --copies_left;
+
+            ++live;
+        }
+
+        fragile(fragile&& other) noexcept(false) : fragile(static_cast<const fragile&>(other)) { }
+
+        ~fragile() { --live; }
+
+        fragile& operator=(const fragile&) = default;
+    };
+
+    typedef stl::small_unordered_map<int, fragile, 4>  fragile_map_type;
+
+    typedef my_alloc::tagged_allocator<stl::pair_node<int, int>>                    alloc_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>, alloc_type,
+                               stl::power2_rehash_policy, false, 6>                 counted_map_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>, alloc_type> counted_heap_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    static bool holds(const fragile_map_type& map, int count)
+    {
+        for (int k = 0; k < count; ++k)
+        {
+            fragile_map_type::const_iterator it = map.find(k);
+
+            if (it == map.cend() || it->second.value != k)
+                return false;
+        }
+
+        return map.size() == static_cast<stl::size_t>(count);
+    }
+
+    // promoting throws part-way, from growing the map or from extract: the inline entries stay, nothing leaks or is destroyed twice
+    bool test_0()
+    {
+        {
+            fragile_map_type map;
+
+            for (int k = 0; k < 4; ++k)
+                map.try_emplace(k, k);
+
+            for (int budget = 0; budget < 4; ++budget)
+            {
+                fragile::copies_left = budget;
+
+                bool thrown = false;
+                try { map.try_emplace(4, 4); } catch (const std::runtime_error&) { thrown = true; }
+
+                fragile::copies_left = -1;
+
+                __check_result_no_return__(thrown, true);
+                __check_result_no_return__(holds(map, 4), true);
+                __check_result_no_return__(fragile::live, 4);
+            }
+
+            fragile::copies_left = 0;
+
+            bool thrown = false;
+            try { map.extract(2); } catch (const std::runtime_error&) { thrown = true; }
+
+            fragile::copies_left = -1;
+
+            __check_result_no_return__(thrown, true);
+            __check_result_no_return__(holds(map, 4), true);
+
+            __check_result_no_return__(map.extract(2).mapped().value, 2);
+            __check_result_no_return__(map.size(), static_cast<stl::size_t>(3));
+            map.try_emplace(2, 2);
+
+            for (int k = 4; k < 100; ++k)
+                map.try_emplace(k, k);
+
+            __check_result_no_return__(holds(map, 100), true);
+        }
+
+        __check_result_no_return__(fragile::live, 0);
+
+        return true;
+    }
+
+    // nothing is allocated before an insert outgrows the inline bucket, nor before the first insert without one; the free
+    // slots of the key block, zeroed, never match a key 0
+    bool test_1()
+    {
+        const long allocations = alloc_type::allocations;
+
+        {
+            counted_map_type map;
+
+            __check_result_no_return__(map.contains(0), false);
+
+            for (int k = 1; k <= 6; ++k)
+                map.try_emplace(k, k);
+
+            __check_result_no_return__(map.contains(0), false);
+            __check_result_no_return__(map.size(), static_cast<stl::size_t>(6));
+            __check_result_no_return__(alloc_type::allocations, allocations);
+
+            map.erase(3);
+            map.try_emplace(0, 0);
+
+            __check_result_no_return__(map.contains(0), true);
+            __check_result_no_return__(map.contains(3), false);
+            __check_result_no_return__(alloc_type::allocations, allocations);
+
+            map.try_emplace(7, 7);
+
+            __check_result_no_return__((alloc_type::allocations > allocations), true);
+        }
+
+        const long heap_allocations = alloc_type::allocations;
+
+        counted_heap_map_type heap_map;
+
+        __check_result_no_return__((heap_map.find(1) == heap_map.end()), true);
+        __check_result_no_return__(alloc_type::allocations, heap_allocations);
+
+        heap_map.try_emplace(1, 1);
+
+        __check_result_no_return__((alloc_type::allocations > heap_allocations), true);
+
+        return true;
+    }
+
+    /// @brief Fills, empties and refills a map with @c Capacity inline slots, then grows it well past them, checking its
+    ///        entries against the keys [0, count) after each step.
+    template <typename Key, stl::size_t Capacity, typename MakeKey>
+    static bool round_trip(MakeKey make_key)
+    {
+        typedef stl::small_unordered_map<Key, int, Capacity>  map_type;
+
+        map_type map;
+
+        auto holds = [&map, &make_key](int first, int last, int step)
+        {
+            stl::size_t walked = 0;
+
+            for (typename map_type::iterator it = map.begin(); it != map.end(); ++it)
+                ++walked;
+
+            for (int k = first; k < last; k += step)
+            {
+                typename map_type::iterator it = map.find(make_key(k));
+
+                if (it == map.end() || it->second != k)
+                    return false;
+            }
+
+            return walked == map.size() && !map.contains(make_key(-1));
+        };
+
+        for (int k = 0; k < static_cast<int>(Capacity); ++k)
+            map.try_emplace(make_key(k), k);
+
+        if (!holds(0, Capacity, 1))
+            return false;
+
+        // the freed slots are taken again
+        for (int k = 0; k < static_cast<int>(Capacity); k += 2)
+            map.erase(make_key(k));
+
+        for (int k = 0; k < static_cast<int>(Capacity); k += 2)
+            map.try_emplace(make_key(k), k);
+
+        if (!holds(0, Capacity, 1))
+            return false;
+
+        // the next insert promotes every entry
+        for (int k = Capacity; k < 200; ++k)
+            map.try_emplace(make_key(k), k);
+
+        if (!holds(0, 200, 1))
+            return false;
+
+        for (int k = 0; k < 200; k += 2)
+            map.erase(make_key(k));
+
+        return holds(1, 200, 2) && map.size() == 100;
+    }
+
+    // keys scanned as one block (4- and 8-byte integers) and keys compared one by one, on both sides of the promotion
+    bool test_2()
+    {
+        __check_result_no_return__((round_trip<int, 4>([](int k) { return k; })), true);
+        __check_result_no_return__((round_trip<int, 7>([](int k) { return k; })), true);
+        __check_result_no_return__((round_trip<long long, 3>([](int k) { return k * 0x100000001LL; })), true);
+        __check_result_no_return__((round_trip<std::string, 5>([](int k) { return std::to_string(k); })), true);
+
+        return true;
+    }
+
+    // copies, moves and swaps between inline and heap maps carry every entry and leave the source usable
+    bool test_3()
+    {
+        typedef stl::small_unordered_map<int, std::string, 4>  map_type;
+
+        map_type small, large;
+
+        for (int k = 0; k < 3; ++k)
+            small.try_emplace(k, std::to_string(k));
+
+        for (int k = 100; k < 150; ++k)
+            large.try_emplace(k, std::to_string(k));
+
+        map_type copy(small);
+
+        __check_result_no_return__(copy.size(), static_cast<stl::size_t>(3));
+        __check_result_no_return__(copy.at(2), std::string("2"));
+
+        small.swap(large);
+
+        __check_result_no_return__(small.size(), static_cast<stl::size_t>(50));
+        __check_result_no_return__(large.size(), static_cast<stl::size_t>(3));
+        __check_result_no_return__(small.at(120), std::string("120"));
+        __check_result_no_return__(large.at(1), std::string("1"));
+
+        map_type moved(stl::move(large));
+
+        __check_result_no_return__(moved.size(), static_cast<stl::size_t>(3));
+        __check_result_no_return__(large.size(), static_cast<stl::size_t>(0));
+        __check_result_no_return__((large.begin() == large.end()), true);
+
+        large.try_emplace(7, "7");
+        __check_result_no_return__(large.at(7), std::string("7"));
+
+        moved = small;
+
+        __check_result_no_return__(moved.size(), static_cast<stl::size_t>(50));
+        __check_result_no_return__(moved.contains(1), false);
+
+        small.clear();
+
+        __check_result_no_return__(small.size(), static_cast<stl::size_t>(0));
+        __check_result_no_return__(small.contains(120), false);
+
+        small.try_emplace(1, "1");
+        __check_result_no_return__(small.at(1), std::string("1"));
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
+
+/**
+ * Node handles: entries leave a map through @c extract and enter another through @c insert(node_type&&) or @c merge,
+ * which relinks the nodes themselves when the allocators compare equal and moves the entries into new nodes otherwise.
+ */
+class unordered_map_node_test
+{
+    typedef my_alloc::tagged_allocator<stl::pair_node<int, int>>                    alloc_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>, alloc_type> map_type;
+
+    typedef my_alloc::tagged_allocator<stl::pair_node<std::string, int>>            string_alloc_type;
+    typedef stl::unordered_map<std::string, int, stl::hash<std::string>, stl::equal_to<void>,
+                               string_alloc_type>                                   string_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Fills @c map with keys [@c first, @c last) mapped to @c base plus the key.
+    static void fill(map_type& map, int first, int last, int base)
+    {
+        for (int k = first; k < last; ++k)
+            map.try_emplace(k, base + k);
+    }
+
+    /// @brief True when @c map holds exactly the keys [@c first, @c last), each mapped to @c base plus the key.
+    static bool holds(const map_type& map, int first, int last, int base)
+    {
+        for (int k = first; k < last; ++k)
+        {
+            map_type::const_iterator it = map.find(k);
+
+            if (it == map.cend() || it->second != base + k)
+                return false;
+        }
+
+        return map.size() == static_cast<stl::size_t>(last - first);
+    }
+
+    // extract by iterator, by key and by a key of another type: each takes one entry out, counts it out of size() and
+    // hands over the map's allocator; a missing key gives an empty handle
+    bool test_0()
+    {
+        string_map_type map(64, string_alloc_type(7));
+
+        for (int k = 0; k < 100; ++k)
+            map.try_emplace(std::to_string(k), k);
+
+        string_map_type::node_type nh = map.extract(std::string_view("42"));
+
+        __check_result_no_return__(nh.empty(), false);
+        __check_result_no_return__(nh.key(), std::string("42"));
+        __check_result_no_return__(nh.mapped(), 42);
+        __check_result_no_return__(nh.get_allocator().tag, 7);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(99));
+        __check_result_no_return__(map.contains("42"), false);
+
+        nh = map.extract(std::string("7"));
+
+        __check_result_no_return__(nh.mapped(), 7);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(98));
+
+        nh = map.extract(map.find("99"));
+
+        __check_result_no_return__(nh.mapped(), 99);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(97));
+
+        nh = map.extract(std::string_view("1000"));
+
+        __check_result_no_return__(nh.empty(), true);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(97));
+
+        stl::size_t walked = 0;
+        for (string_map_type::iterator it = map.begin(); it != map.end(); ++it)
+            ++walked;
+
+        __check_result_no_return__(walked, map.size());
+
+        return true;
+    }
+
+    // insert(node_type&&): a new key links the very node in, a present key hands the node back with the position of the
+    // entry in the way, an empty handle inserts nothing; a key changed through the handle is hashed again
+    bool test_1()
+    {
+        map_type source(64, alloc_type(1)), target(64, alloc_type(1));
+
+        fill(source, 0, 10, 100);
+        fill(target, 5, 10, 200);
+
+        map_type::node_type nh = source.extract(2);
+        const int* address = &nh.mapped();
+
+        const long allocations = alloc_type::allocations;
+        map_type::insert_return_type result = target.insert(stl::move(nh));
+
+        __check_result_no_return__(result.inserted, true);
+        __check_result_no_return__(result.node.empty(), true);
+        __check_result_no_return__(result.position->first, 2);
+        __check_result_no_return__(&result.position->second, address);
+        __check_result_no_return__(alloc_type::allocations, allocations);
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(6));
+
+        result = target.insert(source.extract(7));
+
+        __check_result_no_return__(result.inserted, false);
+        __check_result_no_return__(result.node.empty(), false);
+        __check_result_no_return__(result.node.key(), 7);
+        __check_result_no_return__(result.node.mapped(), 107);
+        __check_result_no_return__(result.position->second, 207);
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(6));
+        __check_result_no_return__(source.size(), static_cast<stl::size_t>(8));
+
+        // the handed-back node goes in again under another key
+        result.node.key() = 1000;
+        result = target.insert(stl::move(result.node));
+
+        __check_result_no_return__(result.inserted, true);
+        __check_result_no_return__(target.find(1000)->second, 107);
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(7));
+
+        result = target.insert(map_type::node_type());
+
+        __check_result_no_return__(result.inserted, false);
+        __check_result_no_return__((result.position == target.end()), true);
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(7));
+
+        // a node from an unequal allocator is moved into a node of the target's own
+        map_type other(64, alloc_type(2));
+        fill(other, 50, 51, 300);
+
+        result = target.insert(other.extract(50));
+
+        __check_result_no_return__(result.inserted, true);
+        __check_result_no_return__(result.node.empty(), true);
+        __check_result_no_return__(result.position->second, 350);
+        __check_result_no_return__(other.size(), static_cast<stl::size_t>(0));
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(8));
+
+        return true;
+    }
+
+    // merge with equal allocators relinks every node the target lacks without allocating or freeing, and leaves the
+    // keys both maps hold in the source
+    bool test_2()
+    {
+        map_type source(64, alloc_type(3)), target(64, alloc_type(3));
+
+        fill(source, 0, 1000, 0);
+        fill(target, 500, 1500, 10000);
+        target.reserve(2000);
+
+        const int* address = &source.find(10)->second;
+
+        const long allocations = alloc_type::allocations, deallocations = alloc_type::deallocations;
+        target.merge(source);
+
+        __check_result_no_return__(alloc_type::allocations, allocations);
+        __check_result_no_return__(alloc_type::deallocations, deallocations);
+        __check_result_no_return__(&target.find(10)->second, address);
+
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(1500));
+        __check_result_no_return__(source.size(), static_cast<stl::size_t>(500));
+        __check_result_no_return__(holds(source, 500, 1000, 0), true);
+
+        for (int k = 0; k < 1500; ++k)
+            __check_result_no_return__(target.find(k)->second, (k < 500 ? k : 10000 + k));
+
+        target.merge(map_type(source));
+
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(1500));
+
+        return true;
+    }
+
+    // merge with unequal allocators moves the entries into nodes of the target's allocator and frees the source's
+    bool test_3()
+    {
+        map_type source(64, alloc_type(4)), target(64, alloc_type(5));
+
+        fill(source, 0, 1000, 0);
+        fill(target, 500, 1500, 10000);
+        target.reserve(2000);
+
+        const long allocations = alloc_type::allocations, deallocations = alloc_type::deallocations;
+        target.merge(source);
+
+        __check_result_no_return__(alloc_type::allocations - allocations, 500L);
+        __check_result_no_return__(alloc_type::deallocations - deallocations, 500L);
+
+        __check_result_no_return__(target.size(), static_cast<stl::size_t>(1500));
+        __check_result_no_return__(source.size(), static_cast<stl::size_t>(500));
+        __check_result_no_return__(holds(source, 500, 1000, 0), true);
+
+        for (int k = 0; k < 1500; ++k)
+            __check_result_no_return__(target.find(k)->second, (k < 500 ? k : 10000 + k));
+
+        __check_result_no_return__(target.get_allocator().tag, 5);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};
+
+/**
+ * Lookup counters: a map collecting statistics counts every lookup exactly, even when const lookups run on several
+ * threads at once.
+ */
+class unordered_map_stats_test
+{
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>, stl::allocator<stl::pair_node<int, int>>,
+                               stl::power2_rehash_policy, true>                        map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    // 4 threads look up 1000 present and 1000 missing keys 10 times each: no hit or miss is lost (TSan reports none)
+    bool test_0()
+    {
+        map_type map;
+        const map_type& cmap = map;
+
+        for (int k = 0; k < 1000; ++k)
+            map.try_emplace(k, k);
+
+        map.reset_stats();
+
+        stl::vector<std::thread> threads;
+
+        for (int t = 0; t < 4; ++t)
+        {
+            threads.emplace_back([&cmap]()
+            {
+                for (int round = 0; round < 10; ++round)
+                    for (int k = 0; k < 2000; ++k)
+                        cmap.find(k);
+            });
+        }
+
+        for (stl::size_t i = 0; i < threads.size(); ++i)
+            threads.data()[i].join();
+
+        stl::table_stats stats = cmap.stats();
+
+        __check_result_no_return__(stats.find_hits, static_cast<stl::size_t>(40000));
+        __check_result_no_return__(stats.find_misses, static_cast<stl::size_t>(40000));
+        __check_result_no_return__((stats.avg_probes_hit >= 1), true);
+
+        map_type copy(map);
+        copy.swap(map);
+
+        __check_result_no_return__(map.stats().find_hits, static_cast<stl::size_t>(0));
+        __check_result_no_return__(copy.stats().find_hits, static_cast<stl::size_t>(40000));
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 1;
+};
+
+/**
+ * Batched lookups: @c find_batch and @c contains_batch answer as many @c find and @c contains calls would, for batches
+ * shorter and longer than the prefetch pipeline, on long chains and on the inline bucket.
+ */
+class unordered_map_batch_test
+{
+    // sends keys to 64 values only, so chains are long and a match is often not the chain head
+    struct clumping_hash
+    {
+        stl::size_t operator()(int key) const noexcept { return static_cast<stl::size_t>(key & 63); }
+    };
+
+    typedef stl::unordered_map<int, int>                                                    map_type;
+    typedef stl::unordered_map<int, int, clumping_hash>                                     clumped_map_type;
+    typedef stl::small_unordered_map<int, int, 4>                                           small_map_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief True when a batch over the first @c n of @c keys gives what @c find and @c contains give for each key.
+    template <typename Map>
+    static bool agrees(Map& map, const stl::vector<int>& keys, stl::size_t n)
+    {
+        stl::vector<typename Map::iterator> found(n + 1, map.end());
+        stl::vector<bool> contained(n + 1, false);
+
+        map.find_batch(keys.data(), n, found.data());
+        static_cast<const Map&>(map).contains_batch(keys.data(), n, contained.data());
+
+        for (stl::size_t i = 0; i < n; ++i)
+        {
+            typename Map::iterator it = map.find(keys[i]);
+
+            if (found[i] != it || contained[i] != (it != map.end()))
+                return false;
+
+            if (it != map.end() && found[i]->first != keys[i])
+                return false;
+        }
+
+        // nothing is written past the batch
+        return found[n] == map.end();
+    }
+
+    /// @brief Keys [@c -count, 2 * @c count) in a fixed shuffled order: a third missing, some repeated.
+    static stl::vector<int> mixed_keys(int count)
+    {
+        stl::vector<int> keys;
+
+        for (int i = 0; i < 3 * count; ++i)
+            keys.push_back((i * 7919) % (3 * count) - count);
+
+        for (int i = 0; i < count; i += 5)
+        {
+            int repeated = keys[i];
+            keys.push_back(repeated);
+        }
+
+        return keys;
+    }
+
+    // batches of every length around the pipeline depth (16 keys per stage), on a map larger than one bucket array line
+    bool test_0()
+    {
+        map_type map;
+
+        for (int k = 0; k < 2000; ++k)
+            map.try_emplace(k, -k);
+
+        stl::vector<int> keys = mixed_keys(340);
+
+        for (stl::size_t n = 0; n <= 70; ++n)
+            __check_result_no_return__(agrees(map, keys, n), true);
+
+        __check_result_no_return__(agrees(map, keys, keys.size()), true);
+
+        return true;
+    }
+
+    // long chains: the iterators a batch hands out erase their entries as those of find would
+    bool test_1()
+    {
+        clumped_map_type map;
+
+        for (int k = 0; k < 1000; ++k)
+            map.try_emplace(k, k);
+
+        stl::vector<int> keys = mixed_keys(300);
+
+        __check_result_no_return__(agrees(map, keys, keys.size()), true);
+
+        stl::vector<int> victims;
+        for (int k = 0; k < 1000; k += 3)
+            victims.push_back(k);
+
+        stl::vector<clumped_map_type::iterator> found(victims.size(), map.end());
+        map.find_batch(victims.data(), victims.size(), found.data());
+
+        for (stl::size_t i = 0; i < victims.size(); ++i)
+            __check_result_no_return__(found[i]->first, victims[i]);
+
+        // one at a time, each found again after the last erase so no iterator is stale
+        for (stl::size_t i = 0; i < victims.size(); ++i)
+        {
+            clumped_map_type::iterator it;
+            map.find_batch(&victims[i], 1, &it);
+
+            __check_result_no_return__(it->first, victims[i]);
+            map.erase(it);
+        }
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(1000 - victims.size()));
+
+        for (int k = 0; k < 1000; ++k)
+            __check_result_no_return__(map.contains(k), (k % 3 != 0));
+
+        return true;
+    }
+
+    // on the inline bucket, then past it once the map is promoted
+    bool test_2()
+    {
+        small_map_type map;
+        stl::vector<int> keys = mixed_keys(8);
+
+        for (int k = 0; k < 3; ++k)
+            map.try_emplace(k, k);
+
+        __check_result_no_return__(agrees(map, keys, keys.size()), true);
+
+        for (int k = 3; k < 40; ++k)
+            map.try_emplace(k, k);
+
+        __check_result_no_return__(agrees(map, keys, keys.size()), true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 3;
+};
+
+/**
+ * Parallel bulk operations: @c rehash(par, n), @c reserve(par, n), range @c insert(par, ...) and range construction on
+ * several threads leave the map as their sequential forms would. The ranges are long enough for up to four threads.
+ */
+class unordered_map_parallel_test
+{
+    typedef stl::unordered_map<int, int>                                                    map_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                               stl::pool_allocator<stl::pair_node<int, int>>>               pool_map_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                               stl::allocator<stl::pair_node<int, int>>,
+                               stl::incremental_rehash_policy<1>>                          incremental_map_type;
+
+    constexpr static int __KEYS = 150000;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Entries of keys [0, @c keys) mapped to themselves, followed by @c repeats entries repeating the first keys
+    ///        with other values, which an insert must drop.
+    static stl::vector<map_type::value_type> entries(int keys, int repeats)
+    {
+        stl::vector<map_type::value_type> items;
+        items.reserve(keys + repeats);
+
+        for (int k = 0; k < keys; ++k)
+            items.push_back(map_type::value_type((k * 7919) % keys, (k * 7919) % keys));
+
+        for (int k = 0; k < repeats; ++k)
+            items.push_back(map_type::value_type(k, -1));
+
+        return items;
+    }
+
+    /// @brief True when @c map holds exactly the keys [0, @c keys), each mapped to @c base plus the key, and walks them once.
+    template <typename Map>
+    static bool holds(const Map& map, int keys, int base)
+    {
+        stl::size_t walked = 0;
+
+        for (typename Map::const_iterator it = map.cbegin(); it != map.cend(); ++it, ++walked)
+            if (it->second != base + it->first)
+                return false;
+
+        for (int k = 0; k < keys; ++k)
+            if (!map.contains(k))
+                return false;
+
+        return walked == map.size() && map.size() == static_cast<stl::size_t>(keys);
+    }
+
+    // range insert on 1, 2 and 4 threads, into an empty map and over entries already there: the first of equal keys wins
+    bool test_0()
+    {
+        stl::vector<map_type::value_type> items = entries(__KEYS, 20000);
+
+        for (stl::size_t threads = 1; threads <= 4; threads *= 2)
+        {
+            map_type map;
+            map.insert(stl::parallel_t(threads), items.begin(), items.end());
+
+            __check_result_no_return__(holds(map, __KEYS, 0), true);
+
+            map_type over;
+            for (int k = 0; k < __KEYS; k += 10)
+                over.try_emplace(k, k);
+
+            over.insert(stl::parallel_t(threads), items.begin(), items.end());
+
+            __check_result_no_return__(holds(over, __KEYS, 0), true);
+            __check_result_no_return__((over.size() <= over.bucket_count()), true);
+        }
+
+        map_type built(stl::parallel_t(4), items.begin(), items.end());
+
+        __check_result_no_return__(holds(built, __KEYS, 0), true);
+
+        return true;
+    }
+
+    // nodes handed out as one pool block are each freed alone: erase half of a parallel build, then clear it
+    bool test_1()
+    {
+        stl::vector<map_type::value_type> items = entries(__KEYS, 0);
+
+        pool_map_type map;
+        map.insert(stl::parallel_t(4), items.begin(), items.end());
+
+        __check_result_no_return__(holds(map, __KEYS, 0), true);
+
+        for (int k = 0; k < __KEYS; k += 2)
+            map.erase(k);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(__KEYS / 2));
+
+        for (int k = 1; k < __KEYS; k += 2)
+            __check_result_no_return__(map.at(k), k);
+
+        map.clear();
+        map.insert(stl::parallel_t(2), items.begin(), items.end());
+
+        __check_result_no_return__(holds(map, __KEYS, 0), true);
+
+        return true;
+    }
+
+    // rehash and reserve on several threads, growing and shrinking, also on a map in the middle of an incremental rehash
+    bool test_2()
+    {
+        map_type map;
+
+        for (int k = 0; k < __KEYS; ++k)
+            map.try_emplace(k, k + 1);
+
+        const stl::size_t sizes[] = { 1 << 20, 1 << 18, 1 << 17, 1 << 21 };
+
+        for (stl::size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+        {
+            map.rehash(stl::parallel_t(4), sizes[i]);
+
+            __check_result_no_return__((map.bucket_count() >= sizes[i]), true);
+            __check_result_no_return__(holds(map, __KEYS, 1), true);
+
+            stl::size_t total = 0;
+            for (stl::size_t b = 0; b < map.bucket_count(); ++b)
+                total += map.bucket_size(b);
+
+            __check_result_no_return__(total, map.size());
+        }
+
+        incremental_map_type incremental;
+
+        for (int k = 0; k < __KEYS; ++k)
+            incremental.try_emplace(k, k + 1);
+
+        incremental.reserve(stl::parallel_t(4), 4 * __KEYS);
+
+        __check_result_no_return__(holds(incremental, __KEYS, 1), true);
+        __check_result_no_return__((incremental.bucket_count() >= 4 * __KEYS), true);
+
+        for (int k = __KEYS; k < 2 * __KEYS; ++k)
+            incremental.try_emplace(k, k + 1);
+
+        __check_result_no_return__(holds(incremental, 2 * __KEYS, 1), true);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 3;
+};
+
+/**
+ * Node pool: @c stl::pool_allocator on its own, over a counting upstream allocator. Blocks are recycled, slabs are
+ * requested rarely and all handed back, copies and rebinds share one pool, and requests the pool does not serve go
+ * straight upstream.
+ */
+class pool_allocator_test
+{
+    struct alignas(16) small_object { int value[3]; };
+    struct large_object { char bytes[300]; };
+    struct alignas(32) aligned_object { int value; };
+
+    typedef my_alloc::tagged_allocator<small_object>                        upstream_type;
+    typedef stl::pool_allocator<small_object, upstream_type>                alloc_type;
+    typedef stl::pool_allocator<large_object, upstream_type::rebind<large_object>::other>       large_alloc_type;
+    typedef stl::pool_allocator<aligned_object, upstream_type::rebind<aligned_object>::other>   aligned_alloc_type;
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+        TEST_CASE(test_4());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Upstream allocations not yet deallocated.
+    static long upstream_live()
+    { return upstream_type::allocations - upstream_type::deallocations; }
+
+    // single objects: distinct aligned blocks carved from a few slabs, a freed block handed out again first
+    bool test_0()
+    {
+        const long live = upstream_live();
+
+        {
+            alloc_type alloc;
+            const long slabs = upstream_type::allocations;
+
+            stl::vector<small_object*> blocks;
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                small_object* block = alloc.allocate(1);
+                block->value[0] = i;
+                blocks.push_back(block);
+            }
+
+            __check_result_no_return__((upstream_type::allocations - slabs < 20), true);
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                __check_result_no_return__(blocks[i]->value[0], i);
+                __check_result_no_return__(reinterpret_cast<stl::uintptr_t>(blocks[i]) % 16, static_cast<stl::uintptr_t>(0));
+            }
+
+            alloc.deallocate(blocks[100], 1);
+            __check_result_no_return__(alloc.allocate(1), blocks[100]);
+
+            for (int i = 0; i < 5000; ++i)
+                alloc.deallocate(blocks[i], 1);
+        }
+
+        // the last allocator gone, every slab and the pool itself are back upstream
+        __check_result_no_return__(upstream_live(), live);
+
+        return true;
+    }
+
+    // copies and rebinds draw from one pool, an allocator built anew or for a copied container from another
+    bool test_1()
+    {
+        alloc_type alloc;
+        alloc_type copy(alloc);
+        stl::pool_allocator<int, upstream_type::rebind<int>::other> rebound(alloc);
+        alloc_type fresh;
+
+        __check_result_no_return__((alloc == copy), true);
+        __check_result_no_return__((alloc == rebound), true);
+        __check_result_no_return__((alloc != fresh), true);
+        __check_result_no_return__((alloc.select_on_container_copy_construction() != alloc), true);
+
+        // a block freed through a copy is handed out again by the original
+        small_object* block = alloc.allocate(1);
+        copy.deallocate(block, 1);
+
+        __check_result_no_return__(alloc.allocate(1), block);
+        alloc.deallocate(block, 1);
+
+        fresh = alloc;
+        __check_result_no_return__((fresh == alloc), true);
+
+        return true;
+    }
+
+    // arrays, objects over 256 bytes and over-aligned objects go upstream, one call each way
+    bool test_2()
+    {
+        alloc_type alloc;
+        large_alloc_type large(alloc);
+        aligned_alloc_type aligned(alloc);
+
+        __check_result_no_return__((alloc.allocate(0) == nullptr), true);
+
+        const long allocations = upstream_type::allocations, deallocations = upstream_type::deallocations;
+
+        small_object* array = alloc.allocate(8);
+        large_object* big = large.allocate(1);
+        aligned_object* over = aligned.allocate(1);
+
+        __check_result_no_return__(upstream_type::allocations - allocations, 3L);
+
+        alloc.deallocate(array, 8);
+        large.deallocate(big, 1);
+        aligned.deallocate(over, 1);
+
+        __check_result_no_return__(upstream_type::deallocations - deallocations, 3L);
+
+        __check_result_no_return__((large.allocate_contiguous(4) == nullptr), true);
+        __check_result_no_return__((aligned.allocate_contiguous(4) == nullptr), true);
+
+        return true;
+    }
+
+    // contiguous runs lie back to back and are freed block by block; slabs go back only once no block is in use
+    bool test_3()
+    {
+        alloc_type alloc;
+
+        small_object* single = alloc.allocate(1);
+        small_object* run = alloc.allocate_contiguous(1000);
+
+        for (int i = 0; i < 1000; ++i)
+            run[i].value[0] = i;
+
+        for (int i = 0; i < 1000; ++i)
+            __check_result_no_return__(run[i].value[0], i);
+
+        const long deallocations = upstream_type::deallocations;
+
+        for (int i = 0; i < 1000; ++i)
+            alloc.deallocate(run + i, 1);
+
+        __check_result_no_return__(alloc.release(), false);
+        __check_result_no_return__(upstream_type::deallocations, deallocations);
+
+        alloc.deallocate(single, 1);
+
+        __check_result_no_return__(alloc.release(), true);
+        __check_result_no_return__((upstream_type::deallocations > deallocations), true);
+
+        // the pool serves again after a release
+        small_object* again = alloc.allocate(1);
+        again->value[0] = 7;
+        alloc.deallocate(again, 1);
+
+        return true;
+    }
+
+    // a map on the pool hands its slabs back on clear() and takes new ones afterwards
+    bool test_4()
+    {
+        typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                                   stl::pool_allocator<stl::pair_node<int, int>, my_alloc::tagged_allocator<stl::pair_node<int, int>>>> map_type;
+
+        const long live = upstream_live();
+
+        {
+            map_type map;
+
+            for (int k = 0; k < 10000; ++k)
+                map.try_emplace(k, k);
+
+            for (int k = 0; k < 10000; k += 2)
+                map.erase(k);
+
+            for (int k = 0; k < 10000; k += 2)
+                map.try_emplace(k, -k);
+
+            const long before_clear = upstream_live();
+            map.clear();
+
+            __check_result_no_return__((upstream_live() < before_clear), true);
+
+            for (int k = 0; k < 100; ++k)
+                map.try_emplace(k, k);
+
+            __check_result_no_return__(map.size(), static_cast<stl::size_t>(100));
+        }
+
+        __check_result_no_return__(upstream_live(), live);
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 5;
+};
+
+/**
+ * Bulk building: a forward range of entries is inserted with at most one table growth, none after a matching
+ * @c reserve, the first of equal keys winning; other ranges take the per-entry path. A throwing copy loses nothing.
+ */
+class unordered_map_bulk_test
+{
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>, stl::allocator<stl::pair_node<int, int>>,
+                               stl::power2_rehash_policy, true>                        map_type;
+    typedef stl::unordered_map<int, int, stl::hash<int>, stl::equal_to<int>,
+                               stl::pool_allocator<stl::pair_node<int, int>>>           pool_map_type;
+
+    /// @brief Throws from its copy once @c copies_left reaches 0; never while negative.
+    struct brittle
+    {
+        static inline int copies_left = -1;
+
+        int value;
+
+        brittle(int v = 0) : value(v) { }
+
+        brittle(const brittle& other) : value(other.value)
+        {
+            if (copies_left == 0)
+                throw std::runtime_error("brittle copy");
+
+            if (copies_left > 0)
+                --copies_left;
+        }
+
+        brittle& operator=(const brittle&) = default;
+    };
+
+public:
+    void __TEST__()
+    {
+        COUNT = 0;
+
+        TEST_CASE(test_0());
+        TEST_CASE(test_1());
+        TEST_CASE(test_2());
+        TEST_CASE(test_3());
+
+        std::cout << "\n" << COUNT << "/" << N << " passed!\n\n";
+    }
+
+private:
+    /// @brief Entries of keys [0, @c keys) in a scattered order mapped to themselves, then @c repeats repeated keys
+    ///        mapped to -1.
+    static stl::vector<map_type::value_type> entries(int keys, int repeats)
+    {
+        stl::vector<map_type::value_type> items;
+        items.reserve(keys + repeats);
+
+        for (int k = 0; k < keys; ++k)
+            items.push_back(map_type::value_type((k * 7919) % keys, (k * 7919) % keys));
+
+        for (int k = 0; k < repeats; ++k)
+            items.push_back(map_type::value_type(k * 3 % keys, -1));
+
+        return items;
+    }
+
+    /// @brief True when @c map holds exactly the keys [0, @c keys), each mapped to itself.
+    template <typename Map>
+    static bool holds(const Map& map, int keys)
+    {
+        for (int k = 0; k < keys; ++k)
+        {
+            typename Map::const_iterator it = map.find(k);
+
+            if (it == map.cend() || it->second != k)
+                return false;
+        }
+
+        return map.size() == static_cast<stl::size_t>(keys);
+    }
+
+    // an empty map grows once for the whole range; the repeated keys keep their first value
+    bool test_0()
+    {
+        stl::vector<map_type::value_type> items = entries(50000, 5000);
+
+        map_type map;
+        map.insert(items.begin(), items.end());
+
+        __check_result_no_return__(holds(map, 50000), true);
+        __check_result_no_return__((map.stats().rehash_count <= 1), true);
+
+        map_type built(items.begin(), items.end());
+
+        __check_result_no_return__(holds(built, 50000), true);
+
+        return true;
+    }
+
+    // after a reserve for the final size, inserting in bulk, twice over, neither grows the table nor moves a bucket
+    bool test_1()
+    {
+        stl::vector<map_type::value_type> first = entries(30000, 0);
+        stl::vector<map_type::value_type> second;
+
+        for (int k = 30000; k < 60000; ++k)
+            second.push_back(map_type::value_type(k, k));
+
+        map_type map;
+        map.reserve(60000);
+
+        const stl::size_t rehashes = map.stats().rehash_count;
+        const stl::size_t buckets = map.bucket_count();
+
+        map.insert(first.begin(), first.end());
+        map.insert(second.begin(), second.end());
+        map.insert(first.begin(), first.end());
+
+        __check_result_no_return__(map.stats().rehash_count, rehashes);
+        __check_result_no_return__(map.bucket_count(), buckets);
+        __check_result_no_return__(holds(map, 60000), true);
+
+        // the reserve itself allocated its buffers up front too
+        stl::vector<int> values;
+        values.reserve(1000);
+
+        const int* data = values.data();
+
+        for (int k = 0; k < 1000; ++k)
+            values.push_back(k);
+
+        __check_result_no_return__(values.data(), data);
+
+        return true;
+    }
+
+    // nodes from one pool block, some left unused by repeated keys, are each freed alone; a cleared map builds again
+    bool test_2()
+    {
+        stl::vector<map_type::value_type> items = entries(20000, 20000);
+
+        pool_map_type map;
+        map.insert(items.begin(), items.end());
+
+        __check_result_no_return__(holds(map, 20000), true);
+
+        for (int k = 0; k < 20000; k += 2)
+            map.erase(k);
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(10000));
+
+        map.clear();
+
+        std::initializer_list<map_type::value_type> few = { {1, 1}, {2, 2}, {1, 5}, {0, 0} };
+        map.insert(few);
+
+        __check_result_no_return__(holds(map, 3), true);
+
+        return true;
+    }
+
+    // a copy throwing part-way keeps the entries already linked and frees every node it did not use
+    bool test_3()
+    {
+        typedef stl::unordered_map<int, brittle>  brittle_map_type;
+
+        stl::vector<brittle_map_type::value_type> items;
+
+        for (int k = 0; k < 5000; ++k)
+            items.push_back(brittle_map_type::value_type(k, brittle(k)));
+
+        brittle_map_type map;
+        brittle::copies_left = 2500;
+
+        bool thrown = false;
+        try { map.insert(items.begin(), items.end()); } catch (const std::runtime_error&) { thrown = true; }
+
+        brittle::copies_left = -1;
+
+        __check_result_no_return__(thrown, true);
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(2500));
+
+        stl::size_t walked = 0;
+
+        for (brittle_map_type::iterator it = map.begin(); it != map.end(); ++it, ++walked)
+            __check_result_no_return__(it->second.value, it->first);
+
+        __check_result_no_return__(walked, map.size());
+
+        map.insert(items.begin(), items.end());
+
+        __check_result_no_return__(map.size(), static_cast<stl::size_t>(5000));
+
+        return true;
+    }
+
+    constexpr static stl::size_t N = 4;
+};